@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the throughput of text-format bytea decoding and encoding,
+// for values between 1KB and 64MB. Usage: nativepg_bench_bytea
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+#include "nativepg/field_view.hpp"
+#include "nativepg/types/base.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+// Repeats fn until at least 256MB have been processed, and returns the throughput in MB/s
+template <class Fn>
+double measure(std::size_t bytes_per_iteration, Fn&& fn)
+{
+    constexpr std::size_t target_bytes = 256u * 1024u * 1024u;
+    const std::size_t iterations = target_bytes / bytes_per_iteration + 1u;
+
+    // Warm up
+    fn();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i)
+        fn();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    return static_cast<double>(bytes_per_iteration * iterations) / elapsed.count() / (1024.0 * 1024.0);
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%12s %18s %18s\n", "size", "decode (MB/s)", "encode (MB/s)");
+
+    for (std::size_t size = 1024u; size <= 64u * 1024u * 1024u; size *= 4u)
+    {
+        // Generate a pseudo-random value
+        std::vector<std::byte> value(size);
+        unsigned state = 42u;
+        for (auto& b : value)
+        {
+            state = state * 1103515245u + 12345u;
+            b = static_cast<std::byte>(state >> 16);
+        }
+
+        // Its text representation
+        std::vector<unsigned char> text;
+        types::serialize_text_bytea(value, text);
+        const field_view fv{std::span<const unsigned char>(text)};
+
+        // Decode. Throughput is measured in decoded bytes
+        std::vector<std::byte> decoded;
+        double decode_mbs = measure(size, [&] {
+            if (types::parse_text_bytea(fv, decoded))
+                std::abort();
+        });
+        if (decoded != value)
+            std::abort();
+
+        // Encode
+        std::vector<unsigned char> encoded;
+        double encode_mbs = measure(size, [&] {
+            encoded.clear();
+            types::serialize_text_bytea(value, encoded);
+        });
+
+        std::printf("%12zu %18.1f %18.1f\n", size, decode_mbs, encode_mbs);
+    }
+}
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the throughput of binary COPY encoding, in rows per second,
+// using a single thread. Usage: nativepg_bench_copy_binary
+
+#include <boost/describe/class.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "nativepg/copy_binary_writer.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+struct order_row
+{
+    std::int64_t id;
+    std::int32_t customer_id;
+    std::string description;
+    double amount;
+    std::optional<std::int32_t> discount;
+};
+BOOST_DESCRIBE_STRUCT(order_row, (), (id, customer_id, description, amount, discount))
+
+constexpr std::size_t num_rows = 4096u;
+constexpr std::size_t num_rounds = 2000u;
+
+std::vector<order_row> generate()
+{
+    std::vector<order_row> res;
+    res.reserve(num_rows);
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        auto n = static_cast<std::int32_t>(i);
+        res.push_back({
+            static_cast<std::int64_t>(i) * 1000,
+            n % 97,
+            "order number " + std::to_string(i),
+            static_cast<double>(i) * 1.25,
+            i % 3u == 0u ? std::optional<std::int32_t>() : std::optional<std::int32_t>(n % 10),
+        });
+    }
+    return res;
+}
+
+}  // namespace
+
+int main()
+{
+    const auto rows = generate();
+    copy_binary_writer<order_row> writer;
+    std::size_t bytes = 0u;
+
+    // Chunks are discarded as soon as they are full, as if they had been sent
+    auto run = [&] {
+        for (const auto& row : rows)
+        {
+            if (writer.write(row))
+                std::abort();
+            if (writer.full())
+            {
+                bytes += writer.data().size();
+                writer.clear();
+            }
+        }
+    };
+
+    // Warm up
+    run();
+    bytes = 0u;
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_rounds; ++i)
+        run();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double total_rows = static_cast<double>(num_rows * num_rounds);
+    std::printf("%18s %18s\n", "rows/s", "MB/s");
+    std::printf(
+        "%18.0f %18.1f\n",
+        total_rows / elapsed.count(),
+        static_cast<double>(bytes) / elapsed.count() / (1024.0 * 1024.0)
+    );
+}
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the throughput of text COPY tokenizing, for rows with short and long fields,
+// using a single thread. Usage: nativepg_bench_copy_text
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+
+#include "nativepg/copy_text_reader.hpp"
+#include "nativepg/field_view.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+constexpr std::size_t num_rows = 16384u;
+constexpr std::size_t chunk_size = 64u * 1024u;
+
+// Generates rows with an id, a text field of the given length, one with escapes and a NULL
+std::string generate(std::size_t text_length)
+{
+    std::string res;
+    for (std::size_t i = 0; i < num_rows; ++i)
+    {
+        res += std::to_string(i);
+        res += '\t';
+        res.append(text_length, static_cast<char>('a' + i % 26u));
+        res += "\tline\\none\\ttwo\t\\N\n";
+    }
+    return res;
+}
+
+void run(const char* name, std::size_t text_length)
+{
+    const std::string input = generate(text_length);
+    const std::span<const unsigned char> data(
+        reinterpret_cast<const unsigned char*>(input.data()),
+        input.size()
+    );
+    const std::size_t rounds = 512u * 1024u * 1024u / input.size() + 1u;
+
+    std::size_t fields = 0u;
+    auto parse = [&] {
+        copy_text_reader reader;
+        for (std::size_t offset = 0u; offset < data.size(); offset += chunk_size)
+        {
+            auto chunk = data.subspan(offset, (std::min)(chunk_size, data.size() - offset));
+            auto ec = reader.feed(chunk, [&fields](std::span<const field_view> row) {
+                fields += row.size();
+            });
+            if (ec)
+                std::abort();
+        }
+    };
+
+    // Warm up
+    parse();
+    if (fields != 4u * num_rows)
+        std::abort();
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rounds; ++i)
+        parse();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::printf(
+        "%12s %18.0f %18.1f\n",
+        name,
+        static_cast<double>(num_rows * rounds) / elapsed.count(),
+        static_cast<double>(input.size() * rounds) / elapsed.count() / (1024.0 * 1024.0)
+    );
+}
+
+}  // namespace
+
+int main()
+{
+    std::printf("%12s %18s %18s\n", "fields", "rows/s", "MB/s");
+    run("short", 8u);
+    run("long", 256u);
+}
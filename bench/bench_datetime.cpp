@@ -0,0 +1,111 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Measures the throughput of text-format date and time parsing, using the
+// layouts the server emits by default. Usage: nativepg_bench_datetime
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "nativepg/types/datetime.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+constexpr std::size_t num_values = 4096u;
+constexpr std::size_t num_rounds = 1000u;
+
+// Generates values with the given layout, varying their digits
+std::vector<std::string> generate(const char* fmt)
+{
+    std::vector<std::string> res;
+    res.reserve(num_values);
+    char buff[64];
+    for (std::size_t i = 0; i < num_values; ++i)
+    {
+        int n = static_cast<int>(i);
+        std::snprintf(
+            buff,
+            sizeof(buff),
+            fmt,
+            1970 + n % 60,
+            1 + n % 12,
+            1 + n % 28,
+            n % 24,
+            n % 60,
+            (n * 7) % 60,
+            (n * 7919) % 1000000
+        );
+        res.emplace_back(buff);
+    }
+    return res;
+}
+
+// Parses all values num_rounds times, returning millions of values per second
+template <class T, class ParseFn>
+double measure(const std::vector<std::string>& values, ParseFn parse)
+{
+    T out{};
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t round = 0; round < num_rounds; ++round)
+    {
+        for (const auto& v : values)
+        {
+            std::span<const unsigned char> data(reinterpret_cast<const unsigned char*>(v.data()), v.size());
+            if (parse(data, out))
+                std::abort();
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(values.size() * num_rounds) / elapsed.count() / 1e6;
+}
+
+}  // namespace
+
+int main()
+{
+    const auto timestamps = generate("%04d-%02d-%02d %02d:%02d:%02d.%06d");
+    const auto timestamptzs = generate("%04d-%02d-%02d %02d:%02d:%02d.%06d+02");
+    std::vector<std::string> dates, times;
+    for (const auto& ts : timestamps)
+    {
+        dates.push_back(ts.substr(0, 10));
+        times.push_back(ts.substr(11));
+    }
+
+    std::printf("%14s %16s\n", "type", "Mvalues/s");
+    std::printf(
+        "%14s %16.1f\n",
+        "date",
+        measure<types::pg_date>(dates, [](auto data, auto& to) { return types::parse_text_date(data, to); })
+    );
+    std::printf(
+        "%14s %16.1f\n",
+        "time",
+        measure<types::pg_time>(times, [](auto data, auto& to) { return types::parse_text_time(data, to); })
+    );
+    std::printf(
+        "%14s %16.1f\n",
+        "timestamp",
+        measure<types::pg_timestamp>(timestamps, [](auto data, auto& to) {
+            return types::parse_text_timestamp(data, to);
+        })
+    );
+    std::printf(
+        "%14s %16.1f\n",
+        "timestamptz",
+        measure<types::pg_timestamptz>(timestamptzs, [](auto data, auto& to) {
+            return types::parse_text_timestamptz(data, to);
+        })
+    );
+}
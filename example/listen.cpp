@@ -46,6 +46,10 @@ static void print_event(const notification_event& event)
             std::cout << "Received notification from process " << event.backend_pid << ", channel '"
                       << event.channel << "', payload '" << event.payload << "'\n";
             break;
+        case nativepg::notification_event_type::overflow:
+            std::cout << "Lost " << event.num_dropped << " notifications on channel '" << event.channel
+                      << "'\n";
+            break;
     }
 }
 
@@ -0,0 +1,232 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Streams changes using logical replication. Requires wal_level=logical, and:
+//   CREATE TABLE myt (id INT PRIMARY KEY, name TEXT);
+//   CREATE PUBLICATION mypub FOR TABLE myt;
+//   SELECT pg_create_logical_replication_slot('myslot', 'pgoutput');
+
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/corosio/io_context.hpp>
+#include <boost/variant2/variant.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nativepg/co_connection.hpp"
+#include "nativepg/extended_error.hpp"
+#include "nativepg/protocol/pgoutput.hpp"
+#include "nativepg/protocol/replication.hpp"
+#include "nativepg/replication.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/check.hpp"
+
+using namespace nativepg;
+namespace capy = boost::capy;
+namespace corosio = boost::corosio;
+namespace pgoutput = protocol::pgoutput;
+
+static void print_err(const char* prefix, std::error_code err, const diagnostics& diag)
+{
+    std::cout << prefix << ": " << err << ": " << err.message();
+    if (!diag.message().empty())
+        std::cout << ": " << diag.message();
+    std::cout << '\n';
+}
+
+static void print_tuple(const pgoutput::tuple_data& tuple)
+{
+    for (auto col : tuple)
+    {
+        if (col.kind == pgoutput::tuple_column_kind::text)
+        {
+            const auto* value = reinterpret_cast<const char*>(col.value.data());
+            std::cout << ' ' << std::string_view(value, col.value.size());
+        }
+        else
+            std::cout << " <" << static_cast<char>(col.kind) << '>';
+    }
+    std::cout << '\n';
+}
+
+// Prints a pgoutput message. Returns the end of the transaction for commits, 0 otherwise
+static std::uint64_t process_change(const pgoutput::message& msg)
+{
+    if (const auto* rel = boost::variant2::get_if<pgoutput::relation_message>(&msg))
+    {
+        // Real applications should store relations by OID, to interpret rows
+        std::cout << "Relation " << rel->oid << ": " << rel->nspname << '.' << rel->name << '\n';
+    }
+    else if (const auto* ins = boost::variant2::get_if<pgoutput::insert_message>(&msg))
+    {
+        std::cout << "INSERT into " << ins->relation_oid << ':';
+        print_tuple(ins->new_tuple);
+    }
+    else if (const auto* upd = boost::variant2::get_if<pgoutput::update_message>(&msg))
+    {
+        std::cout << "UPDATE " << upd->relation_oid << ':';
+        print_tuple(upd->new_tuple);
+    }
+    else if (const auto* del = boost::variant2::get_if<pgoutput::delete_message>(&msg))
+    {
+        std::cout << "DELETE from " << del->relation_oid << ':';
+        print_tuple(del->old_tuple);
+    }
+    else if (const auto* commit = boost::variant2::get_if<pgoutput::commit_message>(&msg))
+    {
+        std::cout << "COMMIT " << format_lsn(commit->end_lsn) << '\n';
+        return commit->end_lsn;
+    }
+    return 0u;
+}
+
+static capy::task<> co_main()
+{
+    // Create a connection
+    co_connection conn{co_await capy::this_coro::executor};
+    diagnostics diag;
+
+    // Connect. Replication connections require the replication parameter
+    auto [ec] = co_await conn.connect(
+        {
+            .hostname = "localhost",
+            .username = "postgres",
+            .password = "secret",
+            .database = "postgres",
+            .replication = "database",
+        },
+        &diag
+    );
+    if (ec)
+    {
+        print_err("Error connecting", ec, diag);
+        co_return;
+    }
+    std::cout << "Startup complete\n";
+
+    // Start streaming from where the slot left off
+    request req;
+    req.add_simple_query(
+        "START_REPLICATION SLOT myslot LOGICAL 0/0 (proto_version '1', publication_names 'mypub')"
+    );
+    check check_response;
+    conn.setup_request(req, &check_response);
+
+    // Decides when to acknowledge the changes we've processed. Keepalives requesting
+    // a reply wake us up periodically, even if there are no changes
+    replication_feedback feedback;
+    std::vector<unsigned char> feedback_buff;
+    int num_commits = 0;
+    bool finished = false;
+
+    while (true)
+    {
+        auto [ec2, res] = co_await conn.exec_some();
+        if (ec2)
+        {
+            print_err("Error reading response", ec2, {});
+            co_return;
+        }
+
+        if (res.type() == exec_some_result::kind::done)
+            break;
+        else if (res.type() == exec_some_result::kind::copy_both)
+            std::cout << "Replication started\n";
+        if (res.type() != exec_some_result::kind::copy_out_data)
+            continue;
+
+        // Each buffer contains a replication message
+        for (auto buff : res.get_copy_out_data())
+        {
+            std::span<const unsigned char> data{static_cast<const unsigned char*>(buff.data()), buff.size()};
+            protocol::replication_message msg;
+            if (auto ec3 = protocol::parse(data, msg))
+            {
+                print_err("Error parsing replication message", ec3, {});
+                co_return;
+            }
+            feedback.on_message(msg);
+
+            // Decode the changes. They're views into the read buffer, so no copies are made
+            if (const auto* xlog = boost::variant2::get_if<protocol::xlog_data>(&msg))
+            {
+                pgoutput::message change;
+                if (auto ec3 = pgoutput::parse(xlog->data, change))
+                {
+                    print_err("Error parsing change", ec3, {});
+                    co_return;
+                }
+                if (auto end_lsn = process_change(change))
+                {
+                    // The transaction has been processed. It will be acknowledged in the next update
+                    feedback.confirm(end_lsn);
+                    ++num_commits;
+                }
+            }
+        }
+
+        // Acknowledge the processed changes, if it's time to
+        auto now = std::chrono::steady_clock::now();
+        if (!finished && feedback.needs_update(now))
+        {
+            feedback_buff.clear();
+            auto update = feedback.make_update(now, std::chrono::system_clock::now());
+            protocol::serialize(update, feedback_buff);
+            if (auto [ec3] = co_await conn.write_copy_message(feedback_buff); ec3)
+            {
+                print_err("Error sending feedback", ec3, {});
+                co_return;
+            }
+        }
+
+        // Stop after a few transactions, or if the server stopped.
+        // exec_some will read the rest of the response
+        if (!finished && (num_commits >= 10 || res.get_copy_out_eof()))
+        {
+            finished = true;
+            if (auto [ec3] = co_await conn.finish_copy_in(); ec3)
+            {
+                print_err("Error finishing replication", ec3, {});
+                co_return;
+            }
+        }
+    }
+
+    std::cout << "Replication finished at " << format_lsn(feedback.reported_lsn()) << '\n';
+}
+
+int main()
+{
+    // The I/O context, required for all I/O operations
+    corosio::io_context ctx;
+
+    // Schedules the main coroutine for execution
+    capy::run_async(
+        ctx.get_executor(),
+        []() {
+           // Runs when the main coroutine finishes normally
+           std::cout << "Done\n";
+        },
+        [](std::exception_ptr exc) {
+            // Runs when the main coroutine finishes with an exception
+            try {
+               std::rethrow_exception(exc);
+            } catch (const std::exception& e) {
+               std::cerr << "Error: " << e.what() << std::endl;
+            }
+            exit(1);
+        }
+    )(co_main());
+
+    // Executes all pending work, including the main coroutine
+    ctx.run();
+}
@@ -114,6 +114,18 @@ enum class client_errc : int
     // You issued a COPY SQL statement through an API that doesn't support COPY operations.
     // Use an appropriate API, instead
     copy_not_allowed,
+
+    // A value sent by the server can't be represented by the C++ type it's being parsed into
+    // (e.g. a numeric that overflows a fixed-point type, or a NaN)
+    value_out_of_range,
+
+    // The server sent a field using the text format, but the C++ type it's being parsed into
+    // only supports the binary format (e.g. composites). Request binary results
+    text_format_not_supported,
+
+    // A multiplexed connection has too many requests waiting to be written.
+    // See multiplexed_config::max_queued_requests
+    queue_full,
 };
 
 /// Creates an \ref error_code from a \ref client_errc.
@@ -15,8 +15,10 @@
 #include <boost/capy/io_task.hpp>
 
 #include <concepts>
+#include <cstddef>
 #include <memory>
 #include <span>
+#include <string_view>
 
 #include "nativepg/connect_params.hpp"
 #include "nativepg/extended_error.hpp"
@@ -25,6 +27,7 @@
 #include "nativepg/protocol/startup_fsm.hpp"
 #include "nativepg/request.hpp"
 #include "nativepg/responses/response_handler.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg {
 
@@ -35,11 +38,15 @@ public:
     {
         copy_out,
         copy_out_data,
+        copy_in,
+        copy_both,
         done,
     };
 
     exec_some_result() = default;
     exec_some_result(protocol::copy_out_response value) noexcept : type_(kind::copy_out), data_(value) {}
+    exec_some_result(protocol::copy_in_response value) noexcept : type_(kind::copy_in), data_(value) {}
+    exec_some_result(protocol::copy_both_response value) noexcept : type_(kind::copy_both), data_(value) {}
     exec_some_result(std::span<const boost::capy::const_buffer> value, bool eof) noexcept
         : type_(kind::copy_out_data), data_({value, eof})
     {
@@ -61,6 +68,16 @@ public:
         BOOST_ASSERT(type_ == kind::copy_out_data);
         return data_.copy_out_data.is_eof;
     }
+    protocol::copy_in_response get_copy_in() const
+    {
+        BOOST_ASSERT(type_ == kind::copy_in);
+        return data_.copy_in;
+    }
+    protocol::copy_both_response get_copy_both() const
+    {
+        BOOST_ASSERT(type_ == kind::copy_both);
+        return data_.copy_both;
+    }
 
 private:
     kind type_{kind::done};
@@ -74,13 +91,27 @@ private:
     {
         protocol::copy_out_response copy_out;
         copy_out_data_t copy_out_data;
+        protocol::copy_in_response copy_in;
+        protocol::copy_both_response copy_both;
 
         data_t() : copy_out_data() {}
         data_t(protocol::copy_out_response value) noexcept : copy_out(value) {}
+        data_t(protocol::copy_in_response value) noexcept : copy_in(value) {}
+        data_t(protocol::copy_both_response value) noexcept : copy_both(value) {}
         data_t(copy_out_data_t value) noexcept : copy_out_data(value) {}
     } data_;
 };
 
+// Options for co_connection::copy_out_to
+struct copy_out_options
+{
+    // The size of each buffer
+    std::size_t buffer_size{256u * 1024u};
+
+    // The maximum number of buffers, including the one being filled. At least 2
+    std::size_t max_buffers{4u};
+};
+
 class co_connection
 {
     struct impl;
@@ -103,8 +134,18 @@ public:
 
     ~co_connection();
 
+    // Connects and authenticates. If the connection has a type registry,
+    // pending type names are looked up (see resolve_types). This is skipped
+    // for replication connections, which can't run the lookup query
     boost::capy::io_task<> connect(connect_params params, diagnostics* diag = nullptr);
 
+    // Sets the registry used to resolve types without a fixed OID. May be shared
+    // with other connections to the same database. Pass nullptr to disable it
+    void set_type_registry(std::shared_ptr<type_registry> types);
+
+    // Looks up the names pending in the type registry, if any
+    boost::capy::io_task<> resolve_types(diagnostics* diag = nullptr);
+
     boost::capy::io_task<> exec(
         const request& req,
         response_handler_ref handler,
@@ -123,6 +164,48 @@ public:
     void setup_request(const request& req, response_handler_ref handler);
     boost::capy::io_task<exec_some_result> exec_some();
 
+    // COPY FROM STDIN. Once exec_some returns a copy_in result, send the data with
+    // write_copy_data, then call finish_copy_in (or abort_copy_in to make the COPY fail),
+    // and keep calling exec_some until done. If the server rejects the data,
+    // it discards the rest, and exec_some reports the error after finishing.
+    // Only COPY statements issued with simple queries are supported.
+    // Small chunks are coalesced into CopyData messages of about copy_in_flush_size bytes.
+    // Bigger ones are sent directly, without copying them. The flush size is capped at about 512MB.
+    boost::capy::io_task<> write_copy_data(std::span<const unsigned char> data);
+    boost::capy::io_task<> finish_copy_in();
+    boost::capy::io_task<> abort_copy_in(std::string_view reason);
+    std::size_t copy_in_flush_size() const;
+    void set_copy_in_flush_size(std::size_t value);
+
+    // CopyBoth, used by replication connections (see connect_params::replication).
+    // Once exec_some returns a copy_both result, it keeps returning the data sent by the server
+    // as copy_out_data results. Messages may be sent at any time between calls to exec_some.
+    // To stop, call finish_copy_in and keep calling exec_some until done. If the server stops
+    // first, exec_some signals eof, and finish_copy_in must be called, too.
+    // Sends msg as a single CopyData message, after any data pending from write_copy_data.
+    // Use it for messages that must be sent on their own, like standby status updates
+    boost::capy::io_task<> write_copy_message(std::span<const unsigned char> msg);
+
+    // COPY FROM STDIN from a file descriptor, from its current position to its end,
+    // followed by CopyDone. On Linux, regular files are sent with sendfile: after writing
+    // each CopyData header, the kernel copies the body from the file to the socket.
+    // Otherwise, each chunk is read right after its CopyData header, and both
+    // are written with a single call, without further copies. Reads are blocking,
+    // so fd should be a regular file rather than a pipe. If reading fails, the COPY
+    // is aborted and the error is returned. In any case, keep calling exec_some until done.
+    // If the file can't be read after a CopyData header was sent (e.g. it was truncated
+    // while sending it), the COPY can't be aborted: the error is returned, and the connection
+    // should be closed. Only available on POSIX systems.
+    boost::capy::io_task<> copy_from_file(int fd, std::size_t chunk_size = 1024u * 1024u);
+
+    // COPY TO STDOUT into a stream (e.g. a file or pipe). Reads the response to the request
+    // set up with setup_request, like calling exec_some until done, writing all COPY data to sink.
+    // Data is copied into a bounded number of buffers, and written with vectored writes,
+    // while the next batches are being received. This way, network and sink I/O overlap.
+    // COPY FROM STDIN operations in the request are aborted.
+    // After an error, the connection should be closed.
+    boost::capy::io_task<> copy_out_to(boost::capy::any_stream& sink, copy_out_options opts = {});
+
     // Reads until there is at least one message in the read buffer.
     // Access messages with state().read_buffer
     boost::capy::io_task<> read_some_messages();
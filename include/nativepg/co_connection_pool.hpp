@@ -19,6 +19,7 @@
 
 #include "nativepg/co_connection.hpp"
 #include "nativepg/connect_params.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg {
 
@@ -38,6 +39,10 @@ struct pool_params
     std::chrono::steady_clock::duration retry_interval{std::chrono::seconds(30)};
     std::chrono::steady_clock::duration ping_interval{std::chrono::seconds(30)};
     std::chrono::steady_clock::duration ping_timeout{std::chrono::seconds(10)};
+
+    // Types without a fixed OID to be resolved after connecting. Shared by all
+    // connections in the pool, so each type is only looked up once. May be null
+    std::shared_ptr<type_registry> types;
 };
 
 class pooled_connection
@@ -12,26 +12,110 @@
 #include <boost/capy/ex/execution_context.hpp>
 #include <boost/capy/io_task.hpp>
 
+#include <chrono>
 #include <concepts>
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include "nativepg/connect_params.hpp"
 #include "nativepg/extended_error.hpp"
+#include "nativepg/multiplexed_stats.hpp"
+#include "nativepg/notification_batch.hpp"
 #include "nativepg/notification_event.hpp"
 #include "nativepg/request.hpp"
 #include "nativepg/responses/response_handler.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg {
 
+namespace detail {
+struct notification_subscriber;
+}
+
 struct multiplexed_config
 {
     connect_params transport;
-    // TODO: timeouts
-    // TODO: health checks
 
     /// Time span to wait between successive connection retries.
     std::chrono::steady_clock::duration reconnect_wait_interval = std::chrono::seconds{1};
+
+    /// Types without a fixed OID to be resolved after connecting. May be null.
+    std::shared_ptr<type_registry> types;
+
+    /// Time to wait for more requests before writing, so they can be coalesced into a single write.
+    /// Trades latency for throughput under load. Zero writes requests as soon as possible,
+    /// coalescing only those that arrive while the previous write is in progress.
+    std::chrono::steady_clock::duration write_linger{};
+
+    /// Maximum number of bytes to coalesce into a single write. Once pending requests
+    /// reach this size, they are written without waiting for write_linger to elapse.
+    /// Requests bigger than this are written on their own.
+    std::size_t max_write_batch_size{64u * 1024u};
+
+    /// Maximum number of requests written to the server whose responses haven't been fully read.
+    /// Once reached, further requests wait to be written until a response completes.
+    /// Bounding the pipeline depth keeps latency predictable under bursts.
+    std::size_t max_in_flight_requests{(std::numeric_limits<std::size_t>::max)()};
+
+    /// Like max_in_flight_requests, but limits the bytes of the requests in flight.
+    /// A request bigger than this is written once no other request is in flight.
+    std::size_t max_in_flight_bytes{(std::numeric_limits<std::size_t>::max)()};
+
+    /// Maximum number of requests waiting to be written. Past it, exec() fails
+    /// immediately with client_errc::queue_full, rather than queueing the request.
+    std::size_t max_queued_requests{(std::numeric_limits<std::size_t>::max)()};
+
+    /// Maximum time to wait for each exec() to complete. When it elapses, the request is abandoned
+    /// and exec() fails: the request is removed from the queue if it hasn't been written yet,
+    /// and its response is discarded otherwise. Zero disables the timeout.
+    std::chrono::steady_clock::duration request_timeout{};
+
+    /// Time span between health checks. A ping is queued along with other requests, so idle
+    /// connections are exercised. Combined with stall_timeout, this detects dead connections.
+    /// Zero disables pings. Note that pings are enabled by default: connections that used to stay
+    /// silent while idle now send a Sync every 30 seconds. Set this to zero to keep them silent.
+    std::chrono::steady_clock::duration ping_interval{std::chrono::seconds(30)};
+
+    /// If no bytes are received for this long while requests are in flight, the connection
+    /// is considered dead and is re-established. Should exceed the duration of the slowest query.
+    /// Stalls are detected between one and two times this duration. Zero disables the check.
+    std::chrono::steady_clock::duration stall_timeout{};
+
+    /// What to do with notifications received while the notification queue is full.
+    /// The default never delays responses to requests, discarding notifications instead.
+    notification_overflow_policy notification_overflow{notification_overflow_policy::drop};
+
+    /// Maximum number of notifications queued for each consumer (read_notifications
+    /// and each subscription) before notification_overflow applies.
+    std::size_t max_queued_notifications{256u};
+};
+
+/// Receives the notifications to a single channel. Created by co_multiplexed_connection::subscribe.
+/// Must not outlive the connection that created it.
+class notification_subscription
+{
+    std::unique_ptr<detail::notification_subscriber> impl_;
+
+    friend class co_multiplexed_connection;
+    explicit notification_subscription(std::unique_ptr<detail::notification_subscriber> impl) noexcept;
+
+public:
+    notification_subscription() noexcept;
+    notification_subscription(notification_subscription&&) noexcept;
+    notification_subscription& operator=(notification_subscription&&) noexcept;
+    ~notification_subscription();
+
+    bool valid() const noexcept { return impl_ != nullptr; }
+
+    // The ID of the subscribed channel. Notifications in batches read by this subscription carry it
+    notification_channel_id channel_id() const;
+
+    // Waits until there is at least one event, then reads all events into output.
+    // Events are notifications to the subscribed channel, overflows and connects/disconnects
+    boost::capy::io_task<> read(notification_batch& output);
 };
 
 class co_multiplexed_connection
@@ -48,7 +132,7 @@ public:
     {
     }
 
-    co_multiplexed_connection(co_multiplexed_connection&&) = default;
+    co_multiplexed_connection(co_multiplexed_connection&&) noexcept;
     co_multiplexed_connection(const co_multiplexed_connection&) = delete;
 
     co_multiplexed_connection& operator=(co_multiplexed_connection&&) noexcept;
@@ -58,6 +142,10 @@ public:
 
     boost::capy::io_task<> run(multiplexed_config cfg);
 
+    // Executes a request. May be called from any thread: requests from outside the connection's
+    // context are handed over through a lock-free queue, and complete in the caller's executor.
+    // Requests issued from other threads before run() is first called wait for it to start.
+    // Other member functions must be called from the connection's context.
     boost::capy::io_task<> exec(
         const request& req,
         response_handler_ref handler,
@@ -71,7 +159,27 @@ public:
         co_return co_await exec(req, response_handler_ref(&handler), diag);
     }
 
+    // Reads notifications to channels without subscriptions, and connects/disconnects
     boost::capy::io_task<> read_notifications(std::vector<notification_event>& output);
+
+    // Same, but doesn't copy channels and payloads. Reusing output avoids allocations
+    boost::capy::io_task<> read_notifications(notification_batch& output);
+
+    // Creates a subscription for a channel. Notifications to the channel are delivered
+    // to the subscription, rather than to read_notifications, waking only its reader.
+    // A channel may have several subscriptions, each getting all notifications.
+    // This doesn't issue LISTEN, which should be done as usual.
+    notification_subscription subscribe(std::string_view channel);
+
+    // The number of bytes of the requests being executed by exec(). Measures how busy
+    // the connection is. May be called from any thread
+    std::size_t outstanding_bytes() const;
+
+    // Counters describing how requests have been coalesced into writes, since construction
+    multiplexed_stats stats() const;
+
+    // Counters describing how notifications have been delivered, since construction
+    notification_stats get_notification_stats() const;
 };
 
 }  // namespace nativepg
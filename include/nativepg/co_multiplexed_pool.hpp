@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_CO_MULTIPLEXED_POOL_HPP
+#define NATIVEPG_CO_MULTIPLEXED_POOL_HPP
+
+#include <boost/capy/concept/executor.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/io_task.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "nativepg/co_multiplexed_connection.hpp"
+#include "nativepg/extended_error.hpp"
+#include "nativepg/multiplexed_routing.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/response_handler.hpp"
+
+namespace nativepg {
+
+struct multiplexed_pool_params
+{
+    /// Configuration for each connection in the pool. type_registry is not thread-safe,
+    /// so each execution context gets its own copy of connection.types, made when the pool
+    /// is created. Names required in the original registry afterwards are not looked up.
+    multiplexed_config connection;
+
+    /// Number of connections created for each execution context. Several connections
+    /// per context allow more pipelines when a single one can't saturate the server.
+    std::size_t connections_per_context{1u};
+
+    /// How exec() chooses among the candidate connections.
+    multiplexed_routing routing{multiplexed_routing::least_loaded};
+
+    /// If true, requests issued from one of the pool's contexts are served by that context's
+    /// connections, which avoids hopping threads. Otherwise, and for requests issued from
+    /// any other thread, all connections are candidates.
+    bool executor_affinity{true};
+};
+
+/// A set of multiplexed connections, sharded by execution context. With one context
+/// per thread, each thread gets its own connections, and requests issued from a thread
+/// can be served by connections running in that same thread, without any synchronization.
+class co_multiplexed_pool
+{
+    struct impl;
+    std::unique_ptr<impl> impl_;
+
+public:
+    // Creates connections_per_context connections for each of the given contexts
+    co_multiplexed_pool(
+        std::span<boost::capy::execution_context* const> contexts,
+        multiplexed_pool_params params
+    );
+
+    co_multiplexed_pool(boost::capy::execution_context& ctx, multiplexed_pool_params params);
+
+    template <boost::capy::Executor Ex>
+    co_multiplexed_pool(const Ex& ex, multiplexed_pool_params params)
+        : co_multiplexed_pool(ex.context(), std::move(params))
+    {
+    }
+
+    co_multiplexed_pool(co_multiplexed_pool&&) noexcept;
+    co_multiplexed_pool(const co_multiplexed_pool&) = delete;
+
+    co_multiplexed_pool& operator=(co_multiplexed_pool&&) noexcept;
+    co_multiplexed_pool& operator=(const co_multiplexed_pool&) = delete;
+
+    ~co_multiplexed_pool();
+
+    // Runs the connections of the execution context this is called from, until cancelled.
+    // Must be called once from each of the pool's contexts.
+    boost::capy::io_task<> run();
+
+    // Executes a request in one of the connections, as chosen by routing and executor_affinity.
+    // May be called from any thread. Completes in the caller's executor.
+    boost::capy::io_task<> exec(
+        const request& req,
+        response_handler_ref handler,
+        diagnostics* diag = nullptr
+    );
+
+    template <response_handler ResponseHandler>
+    boost::capy::io_task<> exec(const request& req, ResponseHandler handler, diagnostics* diag = nullptr)
+    {
+        // Keep the handler alive
+        co_return co_await exec(req, response_handler_ref(&handler), diag);
+    }
+
+    // The total number of connections
+    std::size_t size() const;
+
+    // Accesses individual connections, e.g. to read notifications. The connections
+    // for the i-th context are [i * connections_per_context, (i+1) * connections_per_context).
+    // Except for exec(), a connection must only be used from its own context.
+    co_multiplexed_connection& connection(std::size_t index);
+};
+
+}  // namespace nativepg
+
+#endif
@@ -21,6 +21,12 @@ struct connect_params
     std::string username{"postgres"};
     std::string password{};
     std::string database{"postgres"};
+
+    // If not empty, the value of the replication startup parameter.
+    // Use "database" for logical replication, and "true" for physical replication.
+    // Replication connections accept only simple queries, so connecting
+    // doesn't resolve the types in the connection's type registry
+    std::string replication{};
     // TODO: support arbitrary startup params?
 };
 
@@ -10,6 +10,7 @@
 
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/compose.hpp>
 #include <boost/asio/connect.hpp>
 #include <boost/asio/consign.hpp>
@@ -20,9 +21,11 @@
 
 #include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "nativepg/connect_params.hpp"
 #include "nativepg/extended_error.hpp"
@@ -132,7 +135,19 @@ struct exec_op
         switch (res.type())
         {
             case protocol::startup_fsm::result_type::write:
-                boost::asio::async_write(impl.sock, res.write_data(), std::move(self));
+                if (fsm_.get_request().has_borrowed_data())
+                {
+                    // Borrowed parameters are written using vectored I/O, to avoid copying them
+                    std::vector<boost::asio::const_buffer> buffs;
+                    fsm_.get_request().for_each_payload_segment([&buffs](std::span<const unsigned char> seg) {
+                        buffs.emplace_back(seg.data(), seg.size());
+                    });
+                    boost::asio::async_write(impl.sock, buffs, std::move(self));
+                }
+                else
+                {
+                    boost::asio::async_write(impl.sock, res.write_data(), std::move(self));
+                }
                 break;
             case protocol::startup_fsm::result_type::read:
                 impl.sock.async_read_some(res.read_buffer(), std::move(self));
@@ -0,0 +1,264 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_COPY_BINARY_READER_HPP
+#define NATIVEPG_COPY_BINARY_READER_HPP
+
+#include <boost/assert.hpp>
+#include <boost/endian/conversion.hpp>
+#include <boost/mp11/algorithm.hpp>
+#include <boost/mp11/utility.hpp>
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/detail/copy_traits.hpp"
+#include "nativepg/detail/row_traits.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/field_view.hpp"
+#include "nativepg/types/composite.hpp"
+
+namespace nativepg {
+
+namespace detail {
+
+inline std::int16_t load_int16(const unsigned char* data)
+{
+    return boost::endian::endian_load<std::int16_t, 2, boost::endian::order::big>(data);
+}
+
+inline std::int32_t load_int32(const unsigned char* data)
+{
+    return boost::endian::endian_load<std::int32_t, 4, boost::endian::order::big>(data);
+}
+
+}  // namespace detail
+
+/**
+ * Decodes the binary COPY format (COPY ... TO STDOUT (FORMAT binary)) into Boost.Describe structs.
+ *
+ * Pass each chunk of COPY data to feed(), in order, as exec_some returns them.
+ * Each complete row is parsed using parse_field_traits::parse_binary, with fields
+ * matched to public members by position, and passed to the callback.
+ * Rows contained in a chunk are parsed in place. Rows split across chunks are the
+ * only ones copied, into a small buffer that is reused.
+ *
+ * The binary format doesn't include field types. By default, each member is parsed
+ * as the type it would be serialized as (e.g. int4 for std::int32_t). If the columns
+ * have other types, pass their OIDs to the constructor.
+ *
+ * After an error, no more data may be fed.
+ */
+template <class T>
+class copy_binary_reader
+{
+    static constexpr std::size_t num_fields = detail::row_size_v<T>;
+    static constexpr std::size_t header_size = sizeof(detail::copy_binary_header);
+
+    enum class state_t
+    {
+        header,
+        rows,
+        done,
+    };
+
+    std::array<std::int32_t, num_fields> oids_;
+    std::vector<unsigned char> partial_;  // an incomplete header or row
+    state_t state_{state_t::header};
+
+    // Computes how many more bytes are required to have a complete header or row
+    // at the start of data. If it's already complete, returns 0 and sets size.
+    // Malformed lengths yield a complete unit, so that parsing reports the error
+    std::size_t missing(std::span<const unsigned char> data, std::size_t& size) const
+    {
+        if (state_ == state_t::header)
+        {
+            if (data.size() < header_size)
+                return header_size - data.size();
+            const std::int32_t extension_size = detail::load_int32(data.data() + header_size - 4u);
+            size = header_size;
+            if (extension_size > 0)
+                size += static_cast<std::size_t>(extension_size);
+            return size <= data.size() ? 0u : size - data.size();
+        }
+
+        if (data.size() < 2u)
+            return 2u - data.size();
+        const std::int16_t field_count = detail::load_int16(data.data());
+        std::size_t pos = 2u;
+        for (std::int16_t i = 0; i < field_count; ++i)
+        {
+            if (data.size() < pos + 4u)
+                return pos + 4u - data.size();
+            const std::int32_t length = detail::load_int32(data.data() + pos);
+            pos += 4u;
+            if (length > 0)
+            {
+                pos += static_cast<std::size_t>(length);
+                if (data.size() < pos)
+                    return pos - data.size();
+            }
+        }
+        size = pos;
+        return 0u;
+    }
+
+    std::error_code parse_header(std::span<const unsigned char> data)
+    {
+        // The signature is followed by the flags. Bit 16 signals that rows include OIDs,
+        // and other high bits are critical extensions. We support neither
+        if (!std::equal(data.begin(), data.begin() + 11, detail::copy_binary_header))
+            return client_errc::protocol_value_error;
+        const std::int32_t flags = detail::load_int32(data.data() + 11u);
+        if ((flags & static_cast<std::int32_t>(0xffff0000u)) != 0)
+            return client_errc::protocol_value_error;
+        if (detail::load_int32(data.data() + 15u) < 0)
+            return client_errc::protocol_value_error;
+
+        // Check the column types once
+        std::error_code ec;
+        std::size_t i = 0u;
+        using member_types = boost::mp11::
+            mp_transform<boost::mp11::mp_identity, detail::row_field_types_t<T>>;
+        boost::mp11::mp_for_each<member_types>([this, &ec, &i](auto member) {
+            if (!ec)
+                ec = field_is_compatible<typename decltype(member)::type>(oids_[i++]);
+        });
+        state_ = state_t::rows;
+        return ec;
+    }
+
+    template <class Callback>
+    std::error_code parse_row(std::span<const unsigned char> data, Callback& callback)
+    {
+        // The trailer is a field count of -1
+        const std::int16_t field_count = detail::load_int16(data.data());
+        if (field_count == -1)
+        {
+            state_ = state_t::done;
+            return {};
+        }
+        if (field_count < 0 || static_cast<std::size_t>(field_count) != num_fields)
+            return client_errc::incompatible_field_type;
+        data = data.subspan(2u);
+
+        T row{};
+        std::error_code ec;
+        std::size_t i = 0u;
+        detail::for_each_member(row, [this, &ec, &i, &data](auto& member) {
+            if (ec)
+                return;
+            field_view fv;
+            if (!types::detail::consume_field(data, fv))
+                ec = client_errc::protocol_value_error;
+            else
+                ec = field_parse_binary(fv, oids_[i++], member);
+        });
+        if (ec)
+            return ec;
+        BOOST_ASSERT(data.empty());
+        callback(std::move(row));
+        return {};
+    }
+
+    template <class Callback>
+    std::error_code parse_unit(std::span<const unsigned char> data, Callback& callback)
+    {
+        return state_ == state_t::header ? parse_header(data) : parse_row(data, callback);
+    }
+
+public:
+    // Parses each member as the type it would be serialized as
+    copy_binary_reader()
+        requires(detail::all_copy_writable(detail::row_field_types_t<T>{}))
+        : oids_(detail::copy_default_oids<T>(detail::row_members<T>{}))
+    {
+    }
+
+    // Parses each member as the column type with the given OID
+    explicit copy_binary_reader(std::span<const std::int32_t> column_oids)
+    {
+        BOOST_ASSERT(column_oids.size() == num_fields);
+        std::copy_n(column_oids.begin(), num_fields, oids_.begin());
+    }
+
+    // Has the trailer been read?
+    bool done() const { return state_ == state_t::done; }
+
+    // Parses a chunk of data, invoking callback(T&&) for each complete row.
+    // Data after the trailer is an error
+    template <class Callback>
+    std::error_code feed(std::span<const unsigned char> chunk, Callback&& callback)
+    {
+        while (!chunk.empty())
+        {
+            if (state_ == state_t::done)
+                return client_errc::extra_bytes;
+
+            std::size_t size = 0u;
+            if (!partial_.empty())
+            {
+                // Complete the pending unit, taking only the bytes it needs
+                std::size_t needed = missing(partial_, size);
+                while (needed != 0u && !chunk.empty())
+                {
+                    const std::size_t n = (std::min)(needed, chunk.size());
+                    partial_.insert(partial_.end(), chunk.begin(), chunk.begin() + n);
+                    chunk = chunk.subspan(n);
+                    needed = missing(partial_, size);
+                }
+                if (needed != 0u)
+                    return {};
+                auto ec = parse_unit(partial_, callback);
+                partial_.clear();
+                if (ec)
+                    return ec;
+            }
+            else if (missing(chunk, size) != 0u)
+            {
+                // Keep the incomplete unit until the next chunk arrives
+                partial_.assign(chunk.begin(), chunk.end());
+                return {};
+            }
+            else
+            {
+                if (auto ec = parse_unit(chunk.first(size), callback))
+                    return ec;
+                chunk = chunk.subspan(size);
+            }
+        }
+        return {};
+    }
+
+    // Same, for a sequence of buffers (like the ones returned by exec_some_result::get_copy_out_data)
+    template <class BufferSequence, class Callback>
+        requires(!std::convertible_to<BufferSequence, std::span<const unsigned char>>)
+    std::error_code feed(const BufferSequence& buffers, Callback&& callback)
+    {
+        for (const auto& buff : buffers)
+        {
+            const auto* data = static_cast<const unsigned char*>(buff.data());
+            if (auto ec = feed(std::span<const unsigned char>(data, buff.size()), callback))
+                return ec;
+        }
+        return {};
+    }
+};
+
+}  // namespace nativepg
+
+#endif
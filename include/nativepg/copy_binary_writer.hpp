@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_COPY_BINARY_WRITER_HPP
+#define NATIVEPG_COPY_BINARY_WRITER_HPP
+
+#include <boost/endian/conversion.hpp>
+#include <boost/mp11/algorithm.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/detail/copy_traits.hpp"
+#include "nativepg/detail/row_traits.hpp"
+#include "nativepg/field_traits.hpp"
+
+namespace nativepg {
+
+namespace detail {
+
+inline void append_int16(std::vector<unsigned char>& to, std::int16_t value)
+{
+    unsigned char buff[2];
+    boost::endian::endian_store<std::int16_t, 2, boost::endian::order::big>(buff, value);
+    to.insert(to.end(), buff, buff + 2);
+}
+
+}  // namespace detail
+
+/**
+ * Encodes Boost.Describe structs into the binary COPY format (COPY ... FROM STDIN (FORMAT binary)).
+ *
+ * Each public member becomes a field, in declaration order, serialized using
+ * serialize_field_traits::serialize_binary. Empty std::optional members are sent as NULLs.
+ * The server doesn't check field types in this format, so struct members
+ * must match the table columns listed in the COPY statement.
+ *
+ * Rows are encoded into a single buffer that grows as required. Once full() returns
+ * true, send data() (e.g. using co_connection::write_copy_data) and call clear(),
+ * which keeps the allocated memory. After the last row, call finish() and send
+ * the remaining data.
+ */
+template <class T>
+class copy_binary_writer
+{
+    static_assert(
+        detail::all_copy_writable(detail::row_field_types_t<T>{}),
+        "All the members of T must be serializable"
+    );
+
+    std::vector<unsigned char> buff_;
+    std::size_t chunk_size_;
+
+    // Reserves space for a field length, serializes the field and writes its length
+    template <class U>
+    std::error_code write_field(const U& value)
+    {
+        if constexpr (detail::is_optional_v<U>)
+        {
+            if (!value.has_value())
+            {
+                buff_.insert(buff_.end(), {0xff, 0xff, 0xff, 0xff});
+                return {};
+            }
+            return write_field(*value);
+        }
+        else
+        {
+            const std::size_t length_offset = buff_.size();
+            buff_.resize(length_offset + 4u);
+            if (auto ec = field_serialize_binary(value, buff_))
+                return ec;
+            const std::size_t length = buff_.size() - length_offset - 4u;
+            if (length > static_cast<std::size_t>((std::numeric_limits<std::int32_t>::max)()))
+                return client_errc::value_too_big;
+            boost::endian::endian_store<std::int32_t, 4, boost::endian::order::big>(
+                buff_.data() + length_offset,
+                static_cast<std::int32_t>(length)
+            );
+            return {};
+        }
+    }
+
+public:
+    static constexpr std::size_t default_chunk_size = 64u * 1024u;
+
+    // Writes the file header. full() returns true once chunk_size bytes are ready
+    explicit copy_binary_writer(std::size_t chunk_size = default_chunk_size) : chunk_size_(chunk_size)
+    {
+        reset();
+    }
+
+    std::size_t chunk_size() const { return chunk_size_; }
+    void set_chunk_size(std::size_t value) { chunk_size_ = value; }
+
+    // Appends a row. If serialization fails, no data is appended
+    std::error_code write(const T& row)
+    {
+        const std::size_t row_offset = buff_.size();
+        detail::append_int16(buff_, static_cast<std::int16_t>(detail::row_size_v<T>));
+
+        std::error_code ec;
+        boost::mp11::mp_for_each<detail::row_members<T>>([this, &ec, &row](auto D) {
+            if (!ec)
+                ec = write_field(row.*D.pointer);
+        });
+        if (ec)
+            buff_.resize(row_offset);
+        return ec;
+    }
+
+    // Appends the file trailer. No rows may be written afterwards
+    void finish() { detail::append_int16(buff_, -1); }
+
+    // Is there enough data to be sent?
+    bool full() const { return buff_.size() >= chunk_size_; }
+
+    // The data that hasn't been sent yet
+    std::span<const unsigned char> data() const { return buff_; }
+
+    // Discards the data, once it's been sent. Keeps the memory
+    void clear() { buff_.clear(); }
+
+    // Discards any data and writes the header again, to start another COPY operation
+    void reset()
+    {
+        buff_.assign(std::begin(detail::copy_binary_header), std::end(detail::copy_binary_header));
+    }
+};
+
+}  // namespace nativepg
+
+#endif
@@ -0,0 +1,172 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_COPY_TEXT_READER_HPP
+#define NATIVEPG_COPY_TEXT_READER_HPP
+
+#include <boost/assert.hpp>
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/detail/copy_traits.hpp"
+#include "nativepg/detail/row_traits.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/field_view.hpp"
+
+namespace nativepg {
+
+/**
+ * Splits the text COPY format (COPY ... TO STDOUT, without FORMAT binary) into rows and fields.
+ *
+ * Pass each chunk of COPY data to feed(), in order, as exec_some returns them.
+ * For each complete row, the callback is invoked with a span of fields.
+ * Fields are separated by the delimiter (a tab by default) and rows end with a newline.
+ * \N is a NULL, and backslash escapes are decoded. Fields without escapes point into
+ * the chunk. Escaped fields are decoded into an internal buffer. Fields are only valid
+ * until the callback returns.
+ *
+ * Delimiters, newlines and backslashes are located 16 or 32 bytes at a time, using SIMD.
+ * Only rows split across chunks are copied, into a buffer that is reused.
+ *
+ * The callback may return a std::error_code. If it does and it's not empty,
+ * feed() stops and returns it. The CSV format is not supported.
+ */
+class copy_text_reader
+{
+    struct raw_field
+    {
+        std::size_t offset;
+        std::size_t size;
+        bool escaped;
+        bool is_null;
+    };
+
+    unsigned char delimiter_;
+    std::vector<unsigned char> partial_;  // an incomplete row
+    std::vector<raw_field> raw_fields_;
+    std::vector<unsigned char> decoded_;
+    std::vector<field_view> fields_;
+
+    // Splits the row at the start of data into fields. Returns its size, including the newline,
+    // or 0 if the row is incomplete.
+    std::size_t parse_row(std::span<const unsigned char> data);
+
+    template <class Callback>
+    std::error_code invoke(Callback& callback)
+    {
+        std::span<const field_view> fields(fields_);
+        if constexpr (std::same_as<std::invoke_result_t<Callback&, decltype(fields)>, std::error_code>)
+        {
+            return callback(fields);
+        }
+        else
+        {
+            callback(fields);
+            return {};
+        }
+    }
+
+public:
+    explicit copy_text_reader(char delimiter = '\t') : delimiter_(static_cast<unsigned char>(delimiter)) {}
+
+    // Is there an incomplete row? If there is once the COPY finishes, the data was truncated
+    bool has_partial_row() const { return !partial_.empty(); }
+
+    // Parses a chunk of data, invoking callback(std::span<const field_view>) for each complete row
+    template <class Callback>
+    std::error_code feed(std::span<const unsigned char> chunk, Callback&& callback)
+    {
+        while (!chunk.empty())
+        {
+            if (!partial_.empty())
+            {
+                // Append up to the next newline, and try again. The newline might be escaped
+                const void* newline = std::memchr(chunk.data(), '\n', chunk.size());
+                const std::size_t n = newline ? static_cast<const unsigned char*>(newline) - chunk.data() + 1u
+                                              : chunk.size();
+                partial_.insert(partial_.end(), chunk.begin(), chunk.begin() + n);
+                chunk = chunk.subspan(n);
+                if (!newline || parse_row(partial_) == 0u)
+                    continue;
+                auto ec = invoke(callback);
+                partial_.clear();
+                if (ec)
+                    return ec;
+            }
+            else if (std::size_t size = parse_row(chunk))
+            {
+                if (auto ec = invoke(callback))
+                    return ec;
+                chunk = chunk.subspan(size);
+            }
+            else
+            {
+                // Keep the incomplete row until the next chunk arrives
+                partial_.assign(chunk.begin(), chunk.end());
+                return {};
+            }
+        }
+        return {};
+    }
+
+    // Same, for a sequence of buffers (like the ones returned by exec_some_result::get_copy_out_data)
+    template <class BufferSequence, class Callback>
+        requires(!std::convertible_to<BufferSequence, std::span<const unsigned char>>)
+    std::error_code feed(const BufferSequence& buffers, Callback&& callback)
+    {
+        for (const auto& buff : buffers)
+        {
+            const auto* data = static_cast<const unsigned char*>(buff.data());
+            if (auto ec = feed(std::span<const unsigned char>(data, buff.size()), callback))
+                return ec;
+        }
+        return {};
+    }
+};
+
+/**
+ * Adapts a callback taking Boost.Describe structs into one suitable for copy_text_reader::feed.
+ * Fields are matched to public members by position, and parsed using parse_field_traits::parse_text,
+ * as the type each member would be serialized as. Parsing errors are returned by feed().
+ */
+template <class T, class Callback>
+    requires(detail::all_copy_writable(detail::row_field_types_t<T>{}))
+auto copy_text_rows(Callback&& callback)
+{
+    return [callback = std::forward<Callback>(callback)](std::span<const field_view> fields
+           ) mutable -> std::error_code {
+        static constexpr auto oids = detail::copy_default_oids<T>(detail::row_members<T>{});
+        if (fields.size() != oids.size())
+            return client_errc::incompatible_field_type;
+
+        T row{};
+        std::error_code ec;
+        std::size_t i = 0u;
+        detail::for_each_member(row, [&ec, &i, fields](auto& member) {
+            if (!ec)
+                ec = field_parse_text(fields[i], oids[i], member);
+            ++i;
+        });
+        if (ec)
+            return ec;
+        callback(std::move(row));
+        return {};
+    };
+}
+
+}  // namespace nativepg
+
+#endif
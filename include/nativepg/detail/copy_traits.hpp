@@ -0,0 +1,66 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_DETAIL_COPY_TRAITS_HPP
+#define NATIVEPG_DETAIL_COPY_TRAITS_HPP
+
+#include <boost/mp11/list.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "nativepg/field_traits.hpp"
+
+// Helpers shared by the COPY readers and writers
+namespace nativepg::detail {
+
+// The binary format signature, followed by the flags and the header extension length
+inline constexpr unsigned char copy_binary_header[] = {
+    'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xff, '\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+// Member types that can be written: serializable fields, and optionals of them (NULL when empty)
+template <class T>
+struct is_copy_writable : std::bool_constant<serializable_field<T>>
+{
+};
+
+template <class T>
+struct is_copy_writable<std::optional<T>> : std::bool_constant<serializable_field<T>>
+{
+};
+
+template <class... T>
+constexpr bool all_copy_writable(boost::mp11::mp_list<T...>)
+{
+    return (is_copy_writable<T>::value && ...);
+}
+
+// The formats don't include field types. If the user doesn't supply them,
+// members are parsed as the type they would be serialized as
+template <class T>
+struct copy_default_oid : std::integral_constant<std::int32_t, field_serialize_oid<T>>
+{
+};
+
+template <class T>
+struct copy_default_oid<std::optional<T>> : copy_default_oid<T>
+{
+};
+
+template <class T, template <class...> class ListType, class... D>
+constexpr std::array<std::int32_t, sizeof...(D)> copy_default_oids(ListType<D...>)
+{
+    return {copy_default_oid<std::remove_cvref_t<decltype(std::declval<T>().*D::pointer)>>::value...};
+}
+
+}  // namespace nativepg::detail
+
+#endif
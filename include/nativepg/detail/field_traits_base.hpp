@@ -12,6 +12,7 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -37,6 +38,9 @@ inline constexpr std::int32_t int8_oid = 20;
 inline constexpr std::int32_t float4_oid = 700;
 inline constexpr std::int32_t float8_oid = 701;
 
+inline constexpr std::int32_t numeric_oid = 1700;
+inline constexpr std::int32_t money_oid = 790;
+
 inline constexpr std::int32_t name_oid = 19;
 
 inline constexpr std::int32_t oid_oid = 26;
@@ -457,8 +461,62 @@ struct parse_field_traits<std::uint32_t>
 };
 
 // --- Serialize
-// Types without a serialization function in nativepg/types/base.hpp (bool, bytea, char,
-// float4, float8) are intentionally left out: they can't be used as query parameters yet.
+
+// BOOL
+template <>
+struct serialize_field_traits<bool>
+{
+    static constexpr std::int32_t oid = detail::bool_oid;
+
+    static std::error_code serialize_text(bool value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_bool(value, to);
+    }
+
+    static std::error_code serialize_binary(bool value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_bool(value, to);
+    }
+};
+
+// BYTEA. Both owning vectors and spans may be used as parameters
+template <>
+struct serialize_field_traits<std::vector<std::byte>>
+{
+    static constexpr std::int32_t oid = detail::bytea_oid;
+
+    static std::error_code serialize_text(std::span<const std::byte> value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_bytea(value, to);
+    }
+
+    static std::error_code serialize_binary(std::span<const std::byte> value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_bytea(value, to);
+    }
+};
+
+template <>
+struct serialize_field_traits<std::span<const std::byte>> : serialize_field_traits<std::vector<std::byte>>
+{
+};
+
+// CHAR
+template <>
+struct serialize_field_traits<char>
+{
+    static constexpr std::int32_t oid = detail::char_oid;
+
+    static std::error_code serialize_text(char value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_char(value, to);
+    }
+
+    static std::error_code serialize_binary(char value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_char(value, to);
+    }
+};
 
 // INT2
 template <>
@@ -511,6 +569,57 @@ struct serialize_field_traits<std::int64_t>
     }
 };
 
+// OID
+template <>
+struct serialize_field_traits<std::uint32_t>
+{
+    static constexpr std::int32_t oid = detail::oid_oid;
+
+    static std::error_code serialize_text(std::uint32_t value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_int(value, to);
+    }
+
+    static std::error_code serialize_binary(std::uint32_t value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_int(value, to);
+    }
+};
+
+// FLOAT4
+template <>
+struct serialize_field_traits<float>
+{
+    static constexpr std::int32_t oid = detail::float4_oid;
+
+    static std::error_code serialize_text(float value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_float(value, to);
+    }
+
+    static std::error_code serialize_binary(float value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_float(value, to);
+    }
+};
+
+// FLOAT8
+template <>
+struct serialize_field_traits<double>
+{
+    static constexpr std::int32_t oid = detail::float8_oid;
+
+    static std::error_code serialize_text(double value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_float(value, to);
+    }
+
+    static std::error_code serialize_binary(double value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_float(value, to);
+    }
+};
+
 // TEXT. Unlike parsing, anything convertible to std::string_view is considered a string
 template <std::convertible_to<std::string_view> T>
 struct serialize_field_traits<T>
@@ -0,0 +1,97 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_DETAIL_FIELD_TRAITS_COMPOSITE_HPP
+#define NATIVEPG_DETAIL_FIELD_TRAITS_COMPOSITE_HPP
+
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/field_view.hpp"
+#include "nativepg/types/composite.hpp"
+
+namespace nativepg::detail {
+
+// Anonymous records, as returned by row(...)
+inline constexpr std::int32_t record_oid = 2249;
+inline constexpr std::int32_t record_array_oid = 2287;
+
+// Row types for tables and CREATE TYPE ... AS composites are user-defined,
+// so their OIDs are not fixed. Built-in types have OIDs below this one
+inline constexpr std::int32_t first_normal_object_oid = 16384;
+
+// Fallback, used when the struct doesn't declare its composite_type_name or the registry
+// couldn't resolve it. Any user-defined OID is accepted, including enums, domains and
+// extension types, so some mismatches are only detected by parse_binary_composite
+inline std::error_code is_compatible_composite(std::int32_t type_oid, std::int32_t record_type_oid)
+{
+    return (type_oid == record_type_oid || type_oid >= first_normal_object_oid)
+               ? std::error_code()
+               : client_errc::incompatible_field_type;
+}
+
+}  // namespace nativepg::detail
+
+namespace nativepg {
+
+// --- Parse
+
+// Composite => described struct
+template <types::composite_struct T>
+struct parse_field_traits<T>
+{
+    static constexpr std::string_view type_name = types::composite_type_name<T>;
+
+    static std::error_code is_compatible(std::int32_t type_oid)
+    {
+        return detail::is_compatible_composite(type_oid, detail::record_oid);
+    }
+
+    static std::error_code parse_text(field_view, std::int32_t, T&)
+    {
+        return client_errc::text_format_not_supported;
+    }
+
+    static std::error_code parse_binary(field_view from, std::int32_t, T& to)
+    {
+        if (from.is_null())
+            return client_errc::unexpected_null;
+        return types::parse_binary_composite(from, to);
+    }
+};
+
+// Array of composites => std::vector of described structs
+template <types::composite_struct T>
+struct parse_field_traits<std::vector<T>>
+{
+    static constexpr std::string_view array_type_name = types::composite_type_name<T>;
+
+    static std::error_code is_compatible(std::int32_t type_oid)
+    {
+        return detail::is_compatible_composite(type_oid, detail::record_array_oid);
+    }
+
+    static std::error_code parse_text(field_view, std::int32_t, std::vector<T>&)
+    {
+        return client_errc::text_format_not_supported;
+    }
+
+    static std::error_code parse_binary(field_view from, std::int32_t, std::vector<T>& to)
+    {
+        if (from.is_null())
+            return client_errc::unexpected_null;
+        return types::parse_binary_composite_array(from, to);
+    }
+};
+
+}  // namespace nativepg
+
+#endif
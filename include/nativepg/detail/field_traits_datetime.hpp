@@ -15,6 +15,7 @@
 #include <chrono>
 #include <cstdint>
 #include <system_error>
+#include <vector>
 
 #include "nativepg/client_errc.hpp"
 #include "nativepg/field_traits.hpp"
@@ -38,8 +39,6 @@ inline constexpr std::int32_t daterange_oid = 3912;
 namespace nativepg {
 
 // --- Parse
-// There is no serialization counterpart yet: nativepg/types/datetime.hpp implements
-// parsing only.
 
 // DATE
 template <>
@@ -245,6 +244,116 @@ struct parse_field_traits<types::pg_interval>
     }
 };
 
+// --- Serialize
+
+// DATE
+template <>
+struct serialize_field_traits<types::pg_date>
+{
+    static constexpr std::int32_t oid = detail::date_oid;
+
+    static std::error_code serialize_text(const types::pg_date& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_date(value, to);
+    }
+
+    static std::error_code serialize_binary(const types::pg_date& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_date(value, to);
+    }
+};
+
+// TIME
+template <>
+struct serialize_field_traits<types::pg_time>
+{
+    static constexpr std::int32_t oid = detail::time_oid;
+
+    static std::error_code serialize_text(const types::pg_time& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_time(value, to);
+    }
+
+    static std::error_code serialize_binary(const types::pg_time& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_time(value, to);
+    }
+};
+
+// TIMETZ
+template <>
+struct serialize_field_traits<types::pg_timetz>
+{
+    static constexpr std::int32_t oid = detail::timetz_oid;
+
+    static std::error_code serialize_text(const types::pg_timetz& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_timetz(value, to);
+    }
+
+    static std::error_code serialize_binary(const types::pg_timetz& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_timetz(value, to);
+    }
+};
+
+// TIMESTAMP
+template <>
+struct serialize_field_traits<types::pg_timestamp>
+{
+    static constexpr std::int32_t oid = detail::timestamp_oid;
+
+    static std::error_code serialize_text(const types::pg_timestamp& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_timestamp(value, to);
+    }
+
+    static std::error_code serialize_binary(const types::pg_timestamp& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_timestamp(value, to);
+    }
+};
+
+// TIMESTAMPTZ
+template <>
+struct serialize_field_traits<types::pg_timestamptz>
+{
+    static constexpr std::int32_t oid = detail::timestamptz_oid;
+
+    static std::error_code serialize_text(
+        const types::pg_timestamptz& value,
+        std::vector<unsigned char>& to
+    )
+    {
+        return types::serialize_text_timestamptz(value, to);
+    }
+
+    static std::error_code serialize_binary(
+        const types::pg_timestamptz& value,
+        std::vector<unsigned char>& to
+    )
+    {
+        return types::serialize_binary_timestamptz(value, to);
+    }
+};
+
+// INTERVAL
+template <>
+struct serialize_field_traits<types::pg_interval>
+{
+    static constexpr std::int32_t oid = detail::interval_oid;
+
+    static std::error_code serialize_text(const types::pg_interval& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_interval(value, to);
+    }
+
+    static std::error_code serialize_binary(const types::pg_interval& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_interval(value, to);
+    }
+};
+
 }  // namespace nativepg
 
 #endif  // NATIVEPG_DETAIL_FIELD_TRAITS_DATETIME_HPP
@@ -0,0 +1,93 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_DETAIL_FIELD_TRAITS_FIXED_HPP
+#define NATIVEPG_DETAIL_FIELD_TRAITS_FIXED_HPP
+
+#include <boost/assert.hpp>
+
+#include <cstdint>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/detail/field_traits_base.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/field_view.hpp"
+#include "nativepg/types/fixed.hpp"
+
+namespace nativepg {
+
+// --- Parse
+
+// NUMERIC, MONEY
+template <unsigned Scale, class Rep>
+struct parse_field_traits<types::pg_fixed<Scale, Rep>>
+{
+    using value_type = types::pg_fixed<Scale, Rep>;
+
+    static std::error_code is_compatible(std::int32_t type_oid)
+    {
+        if (type_oid == detail::numeric_oid || type_oid == detail::money_oid)
+            return std::error_code{};
+
+        return client_errc::incompatible_field_type;
+    }
+
+    static std::error_code parse_text(field_view from, std::int32_t type_oid, value_type& to)
+    {
+        if (from.is_null())
+            return client_errc::unexpected_null;
+        switch (type_oid)
+        {
+            case detail::numeric_oid: return types::parse_text_fixed(from, to);
+            case detail::money_oid: return types::parse_text_money(from, to);
+            default: BOOST_ASSERT(false); return {client_errc::incompatible_field_type};
+        }
+    }
+
+    static std::error_code parse_binary(field_view from, std::int32_t type_oid, value_type& to)
+    {
+        if (from.is_null())
+            return client_errc::unexpected_null;
+        switch (type_oid)
+        {
+            case detail::numeric_oid: return types::parse_binary_fixed(from, to);
+            case detail::money_oid: return types::parse_binary_money(from, to);
+            default: BOOST_ASSERT(false); return {client_errc::incompatible_field_type};
+        }
+    }
+};
+
+// --- Serialize
+
+// NUMERIC
+template <unsigned Scale, class Rep>
+struct serialize_field_traits<types::pg_fixed<Scale, Rep>>
+{
+    static constexpr std::int32_t oid = detail::numeric_oid;
+
+    static std::error_code serialize_text(
+        const types::pg_fixed<Scale, Rep>& value,
+        std::vector<unsigned char>& to
+    )
+    {
+        return types::serialize_text_fixed(value, to);
+    }
+
+    static std::error_code serialize_binary(
+        const types::pg_fixed<Scale, Rep>& value,
+        std::vector<unsigned char>& to
+    )
+    {
+        return types::serialize_binary_fixed(value, to);
+    }
+};
+
+}  // namespace nativepg
+
+#endif
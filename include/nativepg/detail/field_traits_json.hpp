@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <system_error>
+#include <vector>
 
 #include "nativepg/client_errc.hpp"
 #include "nativepg/field_traits.hpp"
@@ -32,12 +33,12 @@ inline constexpr std::int32_t jsonb_oid = 3802;
 namespace nativepg {
 
 // --- Parse
-// There is no serialization counterpart yet: nativepg/types/json.hpp implements
-// parsing only.
 
-// JSON(B) => boost::json::value
-template <>
-struct parse_field_traits<boost::json::value>
+namespace detail {
+
+// Shared implementation for all the types that can be parsed from JSON(B)
+template <class T>
+struct json_parse_traits
 {
     static inline std::error_code is_compatible(std::int32_t type_oid)
     {
@@ -46,11 +47,7 @@ struct parse_field_traits<boost::json::value>
                    : client_errc::incompatible_field_type;
     }
 
-    static inline std::error_code parse_text(
-        field_view from,
-        [[maybe_unused]] std::int32_t type_oid,
-        boost::json::value& to
-    )
+    static inline std::error_code parse_text(field_view from, [[maybe_unused]] std::int32_t type_oid, T& to)
     {
         if (from.is_null())
             return client_errc::unexpected_null;
@@ -60,7 +57,7 @@ struct parse_field_traits<boost::json::value>
         return types::parse_json(from.data_str(), to);
     }
 
-    static inline std::error_code parse_binary(field_view from, std::int32_t type_oid, boost::json::value& to)
+    static inline std::error_code parse_binary(field_view from, std::int32_t type_oid, T& to)
     {
         if (from.is_null())
             return client_errc::unexpected_null;
@@ -78,6 +75,75 @@ struct parse_field_traits<boost::json::value>
     }
 };
 
+}  // namespace detail
+
+// JSON(B) => boost::json::value. The value is allocated using its own memory resource
+template <>
+struct parse_field_traits<boost::json::value> : detail::json_parse_traits<boost::json::value>
+{
+};
+
+// JSON(B) => T, without an intermediate boost::json::value
+template <class T>
+struct parse_field_traits<types::json_as<T>> : detail::json_parse_traits<types::json_as<T>>
+{
+};
+
+// --- Serialize
+// Values are sent as JSONB, as it's the most common type. JSONB can be assigned to JSON columns.
+
+// boost::json::value => JSONB
+template <>
+struct serialize_field_traits<boost::json::value>
+{
+    static constexpr std::int32_t oid = detail::jsonb_oid;
+
+    static std::error_code serialize_text(const boost::json::value& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_json(value, to);
+    }
+
+    static std::error_code serialize_binary(const boost::json::value& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_jsonb(value, to);
+    }
+};
+
+// T => JSONB, without an intermediate boost::json::value
+template <class T>
+struct serialize_field_traits<types::json_as<T>>
+{
+    static constexpr std::int32_t oid = detail::jsonb_oid;
+
+    static std::error_code serialize_text(const types::json_as<T>& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_json(value, to);
+    }
+
+    static std::error_code serialize_binary(const types::json_as<T>& value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_jsonb(value, to);
+    }
+};
+
+// Pre-serialized JSON text => JSON. The server validates it
+template <>
+struct serialize_field_traits<types::json_text>
+{
+    static constexpr std::int32_t oid = detail::json_oid;
+
+    static std::error_code serialize_text(types::json_text value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_json(value, to);
+    }
+
+    static std::error_code serialize_binary(types::json_text value, std::vector<unsigned char>& to)
+    {
+        // The binary representation of json is plain JSON
+        return types::serialize_text_json(value, to);
+    }
+};
+
 }  // namespace nativepg
 
 #endif  // NATIVEPG_DETAIL_FIELD_TRAITS_JSON_HPP
@@ -12,6 +12,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
 
@@ -50,8 +51,14 @@ struct parse_field_traits<std::optional<T>>
         "Nested std::optional (e.g. std::optional<std::optional<T>>) is not supported"
     );
 
+    static constexpr std::string_view type_name = detail::field_type_name<T>();
+
     static std::error_code is_compatible(std::int32_t type_oid) { return field_is_compatible<T>(type_oid); }
 
+    // Keep a value prepared by a row initializer (e.g. a boost::json::value using an arena).
+    // Parsing overwrites it completely
+    static T& value_for_parse(std::optional<T>& to) { return to.has_value() ? *to : to.emplace(); }
+
     static std::error_code parse_text(field_view from, std::int32_t type_oid, std::optional<T>& to)
     {
         if (from.is_null())
@@ -59,7 +66,7 @@ struct parse_field_traits<std::optional<T>>
             to.reset();
             return std::error_code{};
         }
-        return field_parse_text(from, type_oid, to.emplace());
+        return field_parse_text(from, type_oid, value_for_parse(to));
     }
 
     static std::error_code parse_binary(field_view from, std::int32_t type_oid, std::optional<T>& to)
@@ -69,7 +76,7 @@ struct parse_field_traits<std::optional<T>>
             to.reset();
             return std::error_code{};
         }
-        return field_parse_binary(from, type_oid, to.emplace());
+        return field_parse_binary(from, type_oid, value_for_parse(to));
     }
 };
 
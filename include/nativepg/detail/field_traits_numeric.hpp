@@ -23,12 +23,6 @@
 #include "nativepg/field_view.hpp"
 #include "nativepg/types/numeric.hpp"
 
-namespace nativepg::detail {
-
-inline constexpr std::int32_t numeric_oid = 1700;
-
-}  // namespace nativepg::detail
-
 namespace nativepg {
 
 // --- Parse
@@ -10,10 +10,13 @@
 
 #include <concepts>
 #include <cstdint>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
+#include "nativepg/client_errc.hpp"
 #include "nativepg/field_view.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg {
 
@@ -51,6 +54,19 @@ struct is_unspecialized
  *
  *    static std::error_code parse_binary(field_view, std::int32_t type_oid, T&)
  *
+ * Types without a fixed OID (e.g. extension types or enums) may additionally declare
+ * the name of the Postgres type they map to. If the connection has a type_registry
+ * that resolved this name, is_compatible is not invoked, and the field's OID
+ * is compared to the resolved one, instead:
+ *
+ *    static constexpr std::string_view type_name = "citext";
+ *
+ * Arrays of such types may declare the name of their element type, instead.
+ * The field's OID is then compared to the resolved array OID:
+ *
+ *    static constexpr std::string_view array_type_name = "citext";
+ *
+ * Remember to require these names in the registry.
  */
 template <class T>
 struct parse_field_traits : detail::is_unspecialized
@@ -114,6 +130,40 @@ concept parsable_field =
         } -> std::convertible_to<std::error_code>;
     };
 
+namespace detail {
+
+// The type name declared by a parse_field_traits specialization, or an empty string
+template <class T>
+constexpr std::string_view field_type_name()
+{
+    if constexpr (requires {
+                      { parse_field_traits<T>::type_name } -> std::convertible_to<std::string_view>;
+                  })
+        return parse_field_traits<T>::type_name;
+    else
+        return {};
+}
+
+// The array element type name declared by a parse_field_traits specialization, or an empty string
+template <class T>
+constexpr std::string_view field_array_type_name()
+{
+    if constexpr (requires {
+                      { parse_field_traits<T>::array_type_name } -> std::convertible_to<std::string_view>;
+                  })
+        return parse_field_traits<T>::array_type_name;
+    else
+        return {};
+}
+
+inline std::error_code compare_resolved_oid(std::int32_t resolved_oid, std::int32_t type_oid)
+{
+    return resolved_oid == type_oid ? std::error_code()
+                                    : std::error_code(client_errc::incompatible_field_type);
+}
+
+}  // namespace detail
+
 template <class T>
 concept serializable_field =
     // If this concept is not satisfied, your type does not have the required
@@ -147,6 +197,32 @@ std::error_code field_is_compatible(std::int32_t type_oid)
     return parse_field_traits<T>::is_compatible(type_oid);
 }
 
+// Same as the above, but types declaring a type_name or array_type_name are matched by name
+// if the registry knows about it
+template <parsable_field T>
+std::error_code field_is_compatible(std::int32_t type_oid, const type_registry* types)
+{
+    constexpr std::string_view name = detail::field_type_name<T>();
+    constexpr std::string_view array_name = detail::field_array_type_name<T>();
+    if constexpr (!name.empty())
+    {
+        if (types != nullptr)
+        {
+            if (std::int32_t resolved_oid = types->oid(name))
+                return detail::compare_resolved_oid(resolved_oid, type_oid);
+        }
+    }
+    if constexpr (!array_name.empty())
+    {
+        if (types != nullptr)
+        {
+            if (std::int32_t resolved_oid = types->array_oid(array_name))
+                return detail::compare_resolved_oid(resolved_oid, type_oid);
+        }
+    }
+    return parse_field_traits<T>::is_compatible(type_oid);
+}
+
 template <parsable_field T>
 std::error_code field_parse_text(field_view from, std::int32_t type_oid, T& to)
 {
@@ -182,7 +258,9 @@ std::error_code field_serialize_binary(const T& value, std::vector<unsigned char
 // include nativepg/types/json.hpp, nativepg/types/numeric.hpp or nativepg/types/decimal.hpp
 // to enable them.
 #include "nativepg/detail/field_traits_base.hpp"
+#include "nativepg/detail/field_traits_composite.hpp"
 #include "nativepg/detail/field_traits_datetime.hpp"
+#include "nativepg/detail/field_traits_fixed.hpp"
 #include "nativepg/detail/field_traits_nullable.hpp"
 
 #endif  // NATIVEPG_FIELD_TRAITS_HPP
@@ -0,0 +1,26 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_MULTIPLEXED_ROUTING_HPP
+#define NATIVEPG_MULTIPLEXED_ROUTING_HPP
+
+namespace nativepg {
+
+// How a co_multiplexed_pool chooses the connection that runs a request
+enum class multiplexed_routing
+{
+    // The connection with the fewest bytes waiting to be written or in flight.
+    // Keeps pipelines short when requests have different sizes or durations
+    least_loaded,
+
+    // Each connection in turn. Cheaper, but doesn't react to slow connections
+    round_robin,
+};
+
+}  // namespace nativepg
+
+#endif
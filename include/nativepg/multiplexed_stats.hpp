@@ -0,0 +1,37 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_MULTIPLEXED_STATS_HPP
+#define NATIVEPG_MULTIPLEXED_STATS_HPP
+
+#include <cstddef>
+
+namespace nativepg {
+
+// Counters describing how a multiplexed connection coalesces requests into writes.
+// Dividing requests_written and bytes_written by writes yields the average batch size
+struct multiplexed_stats
+{
+    // The number of writes issued to the server
+    std::size_t writes{};
+
+    // The number of requests written
+    std::size_t requests_written{};
+
+    // The number of bytes written
+    std::size_t bytes_written{};
+
+    // The number of requests in the biggest write
+    std::size_t max_requests_per_write{};
+
+    // The number of bytes in the biggest write
+    std::size_t max_bytes_per_write{};
+};
+
+}  // namespace nativepg
+
+#endif
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_NOTIFICATION_BATCH_HPP
+#define NATIVEPG_NOTIFICATION_BATCH_HPP
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "nativepg/notification_event.hpp"
+
+namespace nativepg {
+
+// Identifies a channel within a multiplexed connection. The names of channels with subscriptions
+// are interned, so comparing IDs is cheaper than comparing names
+using notification_channel_id = std::uint32_t;
+
+// The ID of channels that have never had subscriptions. They aren't interned,
+// so memory doesn't grow with the number of distinct channels notified
+inline constexpr notification_channel_id no_channel_id = static_cast<notification_channel_id>(-1);
+
+namespace detail {
+
+class notification_buffer;
+
+struct notification_record
+{
+    notification_event_type type;
+    std::int32_t backend_pid;
+    notification_channel_id channel_id;
+    std::string_view channel;    // Points into the connection's channel table. Unused for no_channel_id
+    std::size_t channel_offset;  // For no_channel_id, the name is stored in the batch, like payloads
+    std::size_t channel_size;
+    std::size_t payload_offset;
+    std::size_t payload_size;
+    std::size_t num_dropped;
+};
+
+}  // namespace detail
+
+// Like notification_event, but without owning its strings
+struct notification_view
+{
+    // What did happen?
+    notification_event_type type;
+
+    // If type == notify, the process ID of the notifying backend
+    std::int32_t backend_pid;
+
+    // If type == notify or overflow, the ID of the channel that was notified,
+    // or no_channel_id if it has never had subscriptions
+    notification_channel_id channel_id;
+
+    // If type == notify or overflow, the channel that was notified
+    std::string_view channel;
+
+    // If type == notify, the payload passed to NOTIFY
+    std::string_view payload;
+
+    // If type == overflow, the number of notifications to channel that were discarded
+    std::size_t num_dropped;
+};
+
+// A set of notification events, read at once by a consumer. Payloads are stored
+// contiguously, and reading into the same batch again reuses its memory, so
+// receiving notifications doesn't allocate in steady state.
+// The names of channels with subscriptions point into the connection, which must outlive the views.
+// The rest are stored along with the payloads.
+class notification_batch
+{
+    std::vector<detail::notification_record> records_;
+    std::vector<char> payloads_;  // Payloads and the names of channels without an ID
+
+    friend class detail::notification_buffer;
+
+    std::string_view channel_name(const detail::notification_record& rec) const
+    {
+        if (rec.channel_id == no_channel_id)
+            return {payloads_.data() + rec.channel_offset, rec.channel_size};
+        return rec.channel;
+    }
+
+public:
+    class iterator
+    {
+        const notification_batch* self_{};
+        std::size_t index_{};
+
+        friend class notification_batch;
+        iterator(const notification_batch* self, std::size_t index) noexcept : self_(self), index_(index) {}
+
+    public:
+        using value_type = notification_view;
+        using reference = notification_view;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        iterator() = default;
+
+        notification_view operator*() const { return (*self_)[index_]; }
+
+        iterator& operator++() noexcept
+        {
+            ++index_;
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            auto res = *this;
+            ++index_;
+            return res;
+        }
+
+        bool operator==(const iterator& rhs) const noexcept { return index_ == rhs.index_; }
+    };
+
+    notification_batch() = default;
+
+    bool empty() const noexcept { return records_.empty(); }
+    std::size_t size() const noexcept { return records_.size(); }
+
+    notification_view operator[](std::size_t i) const
+    {
+        BOOST_ASSERT(i < size());
+        const auto& rec = records_[i];
+        return {
+            rec.type,
+            rec.backend_pid,
+            rec.channel_id,
+            channel_name(rec),
+            {payloads_.data() + rec.payload_offset, rec.payload_size},
+            rec.num_dropped,
+        };
+    }
+
+    iterator begin() const noexcept { return {this, 0u}; }
+    iterator end() const noexcept { return {this, size()}; }
+
+    // Removes all events, keeping the memory for reuse
+    void clear() noexcept
+    {
+        records_.clear();
+        payloads_.clear();
+    }
+};
+
+}  // namespace nativepg
+
+#endif
@@ -8,6 +8,8 @@
 #ifndef NATIVEPG_NOTIFICATION_EVENT_HPP
 #define NATIVEPG_NOTIFICATION_EVENT_HPP
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 
@@ -18,6 +20,22 @@ enum class notification_event_type
     notify,
     connect,
     disconnect,
+
+    // Notifications were discarded because the queue was full.
+    // Consumers relying on them (e.g. caches) should resynchronize
+    overflow,
+};
+
+// What to do with notifications received while the queue is full
+enum class notification_overflow_policy
+{
+    // Discard them. An overflow event per channel records how many were discarded.
+    // Responses to requests are never delayed by a slow consumer
+    drop,
+
+    // Stop reading from the server until the consumer makes space. No notification is lost,
+    // but responses to all requests in the connection are delayed, too
+    block,
 };
 
 // TODO: this should use a flat memory layout
@@ -29,11 +47,33 @@ struct notification_event
     // If type == notify, the process ID of the notifying backend
     std::int32_t backend_pid{};
 
-    // If type == notify, the channel that was notified
+    // If type == notify or overflow, the channel that was notified
     std::string channel{};
 
     // If type == notify, the payload passed to NOTIFY
     std::string payload{};
+
+    // If type == overflow, the number of notifications to channel that were discarded
+    std::size_t num_dropped{};
+};
+
+// Counters describing how notifications are delivered, since construction
+struct notification_stats
+{
+    // The number of notifications received from the server, including discarded ones
+    std::size_t received{};
+
+    // The number of notifications discarded because the queue was full
+    std::size_t dropped{};
+
+    // The maximum number of events that have been queued at once
+    std::size_t max_queued{};
+
+    // The time the oldest event in the last batch read by the consumer spent queued
+    std::chrono::steady_clock::duration last_lag{};
+
+    // The maximum value that last_lag has taken
+    std::chrono::steady_clock::duration max_lag{};
 };
 
 }  // namespace nativepg
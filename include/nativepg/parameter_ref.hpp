@@ -10,16 +10,77 @@
 
 #include <boost/endian/conversion.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <string_view>
 #include <system_error>
+#include <vector>
 
 #include "nativepg/field_traits.hpp"
+#include "nativepg/protocol/format_codes.hpp"
+#include "nativepg/types/base.hpp"
 
 namespace nativepg {
 
+// A BYTEA parameter that references caller-owned memory instead of being copied
+// into the request. Use it for large values. The referenced memory must be kept alive
+// until the request has been executed. When sent in the binary format, the request
+// points to this memory, and the data is written using vectored I/O.
+// The text format requires hex-encoding, so the value is copied in this case.
+struct borrowed_bytea
+{
+    std::span<const std::byte> data;
+};
+
+// Same as borrowed_bytea, but for TEXT parameters. The value is referenced
+// in both the text and binary formats.
+struct borrowed_text
+{
+    std::string_view data;
+};
+
+// Creates parameters that reference memory rather than copying it
+inline borrowed_bytea borrow_bytea(std::span<const std::byte> data) noexcept { return {data}; }
+inline borrowed_text borrow_text(std::string_view data) noexcept { return {data}; }
+
+// These are used as fallback when the parameter is serialized into a plain buffer
+template <>
+struct serialize_field_traits<borrowed_bytea>
+{
+    static constexpr std::int32_t oid = detail::bytea_oid;
+
+    static std::error_code serialize_text(borrowed_bytea value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_bytea(value.data, to);
+    }
+
+    static std::error_code serialize_binary(borrowed_bytea value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_bytea(value.data, to);
+    }
+};
+
+template <>
+struct serialize_field_traits<borrowed_text>
+{
+    static constexpr std::int32_t oid = detail::text_oid;
+
+    static std::error_code serialize_text(borrowed_text value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_text_text(value.data, to);
+    }
+
+    static std::error_code serialize_binary(borrowed_text value, std::vector<unsigned char>& to)
+    {
+        return types::serialize_binary_text(value.data, to);
+    }
+};
+
 class parameter_ref
 {
     using serialize_fn = std::error_code (*)(const void* param, std::vector<unsigned char>& buffer);
+    using borrow_fn = bool (*)(const void* param, protocol::format_code fmt, std::span<const unsigned char>&);
 
     template <class T>
     static std::error_code do_serialize_text(const void* param, std::vector<unsigned char>& buffer)
@@ -33,9 +94,41 @@ class parameter_ref
         return field_serialize_binary(*static_cast<const T*>(param), buffer);
     }
 
+    static bool do_borrow_bytea(
+        const void* param,
+        protocol::format_code fmt,
+        std::span<const unsigned char>& to
+    )
+    {
+        if (fmt != protocol::format_code::binary)
+            return false;
+        auto data = static_cast<const borrowed_bytea*>(param)->data;
+        to = {reinterpret_cast<const unsigned char*>(data.data()), data.size()};
+        return true;
+    }
+
+    static bool do_borrow_text(const void* param, protocol::format_code, std::span<const unsigned char>& to)
+    {
+        auto data = static_cast<const borrowed_text*>(param)->data;
+        to = {reinterpret_cast<const unsigned char*>(data.data()), data.size()};
+        return true;
+    }
+
+    template <class T>
+    static constexpr borrow_fn get_borrow_fn()
+    {
+        if constexpr (std::same_as<T, borrowed_bytea>)
+            return &do_borrow_bytea;
+        else if constexpr (std::same_as<T, borrowed_text>)
+            return &do_borrow_text;
+        else
+            return nullptr;
+    }
+
     const void* value_;
     serialize_fn text_;
     serialize_fn binary_;
+    borrow_fn borrow_;
     std::int32_t oid_;
 
 public:
@@ -45,6 +138,7 @@ public:
         : value_(&value),
           text_(&do_serialize_text<T>),
           binary_(&do_serialize_binary<T>),
+          borrow_(get_borrow_fn<T>()),
           oid_(field_serialize_oid<T>)
     {
         static_assert(serializable_field<T>);  // TODO: could we make the error messages clearer here?
@@ -58,6 +152,14 @@ public:
     {
         return binary_(value_, buffer);
     }
+
+    // If the parameter references caller-owned memory that can be sent as-is
+    // using the given format, sets data to it and returns true.
+    // Otherwise, the parameter must be serialized.
+    bool borrow(protocol::format_code fmt, std::span<const unsigned char>& data) const
+    {
+        return borrow_ && borrow_(value_, fmt, data);
+    }
 };
 
 }  // namespace nativepg
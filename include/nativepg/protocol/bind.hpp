@@ -25,6 +25,14 @@ namespace detail {
 struct bind_context_access;
 }
 
+// Parameter data that is referenced, rather than copied into the serialization buffer.
+// It logically goes at offset within the buffer, before the byte that is there.
+struct borrowed_chunk
+{
+    std::size_t offset;
+    std::span<const unsigned char> data;
+};
+
 // Used within the user-supplied callback for bind parameters.
 // For each parameter you want to add, call start_parameter(),
 // then serialize the parameter into buffer()
@@ -34,7 +42,10 @@ class bind_context
 
     std::size_t num_params_{};
     std::size_t param_offset_{no_offset};
+    std::size_t param_borrowed_size_{};
+    std::size_t borrowed_size_{};
     std::vector<unsigned char>& buff_;
+    std::vector<borrowed_chunk>* borrowed_{};
     std::error_code err_;
 
     friend struct detail::bind_context_access;
@@ -45,9 +56,32 @@ public:
     // Constructor - usually called by the library
     bind_context(std::vector<unsigned char>& buff) noexcept : buff_(buff) {}
 
+    // Constructor that allows borrowing data - usually called by the library
+    bind_context(std::vector<unsigned char>& buff, std::vector<borrowed_chunk>& borrowed) noexcept
+        : buff_(buff), borrowed_(&borrowed)
+    {
+    }
+
     // Retrieves the serialization buffer
     std::vector<unsigned char>& buffer() noexcept { return buff_; }
 
+    // Adds data to the current parameter without copying it into buffer().
+    // The referenced memory must be kept alive until the message has been written.
+    // If the context doesn't support borrowing, the data is copied.
+    void add_borrowed(std::span<const unsigned char> data)
+    {
+        if (borrowed_)
+        {
+            borrowed_->push_back({buff_.size(), data});
+            param_borrowed_size_ += data.size();
+            borrowed_size_ += data.size();
+        }
+        else
+        {
+            buff_.insert(buff_.end(), data.begin(), data.end());
+        }
+    }
+
     // Starts a parameter. Add its value with one or several add_parameter_chunk calls
     void start_parameter()
     {
@@ -94,6 +128,14 @@ struct bind
 };
 std::error_code serialize(const bind& msg, std::vector<unsigned char>& to);
 
+// Same as the above, but parameters may reference data rather than copying it.
+// Such data is not written to the buffer, and a chunk is appended to borrowed instead.
+std::error_code serialize(
+    const bind& msg,
+    std::vector<unsigned char>& to,
+    std::vector<borrowed_chunk>& borrowed
+);
+
 struct bind_complete
 {
 };
@@ -9,10 +9,12 @@
 #define NATIVEPG_PROTOCOL_CONNECTION_STATE_HPP
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "nativepg/extended_error.hpp"
 #include "nativepg/protocol/detail/read_buffer.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg::protocol {
 
@@ -32,6 +34,10 @@ struct connection_state
 
     // TODO: this is safe for now, but is there any case where it may not be?
     diagnostics shared_diag;
+
+    // Types without a fixed OID known by this connection. May be shared
+    // with other connections, and may be null
+    std::shared_ptr<type_registry> types;
 };
 
 }  // namespace nativepg::protocol
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_PROTOCOL_DETAIL_COPY_IN_BUFFER_HPP
+#define NATIVEPG_PROTOCOL_DETAIL_COPY_IN_BUFFER_HPP
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "nativepg/protocol/copy.hpp"
+#include "nativepg/protocol/header.hpp"
+
+namespace nativepg::protocol::detail {
+
+// The server rejects messages bigger than 1GB. Bigger chunks are split
+inline constexpr std::size_t copy_data_max_size = 0x3fff0000u;
+
+// Builds the header of a CopyData message containing size bytes
+inline std::array<unsigned char, 5u> copy_data_header(std::size_t size)
+{
+    BOOST_ASSERT(size <= copy_data_max_size);
+    std::array<unsigned char, 5u> res;
+    [[maybe_unused]] auto ec = serialize_header(
+        {copy_data_message_type, static_cast<std::int32_t>(size + 4u)},
+        res
+    );
+    BOOST_ASSERT(!ec);
+    return res;
+}
+
+// Coalesces small chunks of COPY FROM STDIN data into big CopyData messages,
+// so we don't pay one message header and one write per row.
+// Chunks at least as big as the flush size are better sent directly, without copying them.
+class copy_in_buffer
+{
+    // 5 bytes of header, then the data of the pending CopyData message, then any terminating message
+    std::vector<unsigned char> buff_;
+    std::size_t flush_size_;
+
+    std::size_t data_size() const { return buff_.size() - 5u; }
+
+    // Writes the header of the pending message
+    void finish_data()
+    {
+        auto header = copy_data_header(data_size());
+        std::copy(header.begin(), header.end(), buff_.begin());
+    }
+
+public:
+    static constexpr std::size_t default_flush_size = 64u * 1024u;
+
+    // Pending data and an appended chunk are both smaller than the flush size,
+    // so this keeps messages within copy_data_max_size
+    static constexpr std::size_t max_flush_size = copy_data_max_size / 2u;
+
+    explicit copy_in_buffer(std::size_t flush_size = default_flush_size)
+        : buff_(5u), flush_size_((std::clamp)(flush_size, std::size_t(1u), max_flush_size))
+    {
+    }
+
+    std::size_t flush_size() const { return flush_size_; }
+    void set_flush_size(std::size_t value)
+    {
+        flush_size_ = (std::clamp)(value, std::size_t(1u), max_flush_size);
+    }
+
+    // Is there any pending data?
+    bool empty() const { return buff_.size() == 5u; }
+
+    // Should data be sent directly, rather than being appended?
+    bool is_big(std::size_t size) const { return size >= flush_size_; }
+
+    // Appends data to the pending message. Returns true if it should be flushed
+    bool append(std::span<const unsigned char> data)
+    {
+        BOOST_ASSERT(data.size() <= copy_data_max_size - data_size());
+        buff_.insert(buff_.end(), data.begin(), data.end());
+        return data_size() >= flush_size_;
+    }
+
+    // Returns the pending CopyData message, ready to be written.
+    // Call clear() once written
+    std::span<const unsigned char> flush()
+    {
+        BOOST_ASSERT(!empty());
+        finish_data();
+        return buff_;
+    }
+
+    // Returns the pending CopyData message, if any, followed by a CopyDone
+    std::span<const unsigned char> finish()
+    {
+        if (empty())
+            buff_.clear();
+        else
+            finish_data();
+        [[maybe_unused]] auto ec = serialize(copy_done{}, buff_);
+        BOOST_ASSERT(!ec);
+        return buff_;
+    }
+
+    // Discards any pending data, and returns a CopyFail message with the given reason.
+    // The reason is sent as a NULL-terminated string, so it's cut at the first NULL character
+    std::span<const unsigned char> fail(std::string_view reason)
+    {
+        reason = reason.substr(0u, reason.find('\0'));
+        buff_.clear();
+        [[maybe_unused]] auto ec = serialize(copy_fail{reason}, buff_);
+        BOOST_ASSERT(!ec);
+        return buff_;
+    }
+
+    // Discards the contents, keeping the memory
+    void clear() { buff_.resize(5u); }
+};
+
+}  // namespace nativepg::protocol::detail
+
+#endif
@@ -38,6 +38,8 @@ public:
         return ec ? extended_error{ec, {}} : read_fsm_.get_handler().result();
     }
 
+    const request& get_request() const { return read_fsm_.get_request(); }
+
 private:
     int resume_point_{0};
     read_response_fsm read_fsm_;
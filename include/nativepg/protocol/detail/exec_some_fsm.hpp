@@ -39,6 +39,8 @@ public:
         copy_out,
         copy_data,
         copy_data_with_eof,
+        copy_in,
+        copy_both,
         done,
     };
 
@@ -48,6 +50,8 @@ public:
         result(std::error_code ec = {}) noexcept : type_(result_type::done), data_(ec) {}
         result(result_type t) noexcept : type_(t) {}
         result(protocol::copy_out_response value) noexcept : type_(result_type::copy_out), data_(value) {}
+        result(protocol::copy_in_response value) noexcept : type_(result_type::copy_in), data_(value) {}
+        result(protocol::copy_both_response value) noexcept : type_(result_type::copy_both), data_(value) {}
 
         result_type type() const { return type_; }
         std::error_code error() const
@@ -60,6 +64,16 @@ public:
             BOOST_ASSERT(type_ == result_type::copy_out);
             return data_.copy_out;
         }
+        protocol::copy_in_response get_copy_in() const
+        {
+            BOOST_ASSERT(type_ == result_type::copy_in);
+            return data_.copy_in;
+        }
+        protocol::copy_both_response get_copy_both() const
+        {
+            BOOST_ASSERT(type_ == result_type::copy_both);
+            return data_.copy_both;
+        }
 
     private:
         result_type type_{result_type::done};
@@ -68,9 +82,13 @@ public:
         {
             std::error_code ec;
             protocol::copy_out_response copy_out;
+            protocol::copy_in_response copy_in;
+            protocol::copy_both_response copy_both;
 
             data_t(std::error_code ec = {}) noexcept : ec(ec) {}
             data_t(protocol::copy_out_response value) noexcept : copy_out(value) {}
+            data_t(protocol::copy_in_response value) noexcept : copy_in(value) {}
+            data_t(protocol::copy_both_response value) noexcept : copy_both(value) {}
         } data_;
     };
 
@@ -85,7 +103,7 @@ public:
             NATIVEPG_CORO_INITIAL
 
             // Initial checks
-            if (auto req_ec = setup_request(fsm_.get_request(), fsm_.get_handler()))
+            if (auto req_ec = setup_request(fsm_.get_request(), fsm_.get_handler(), st.types.get()))
                 return {req_ec};
 
             copy_buffs.clear();
@@ -140,6 +158,20 @@ public:
                         // We're entering COPY OUT, notify the user
                         NATIVEPG_YIELD(resume_point_, 4, res.message.get_copy_out_response())
                     }
+                    else if (res.message.type() == any_backend_message::kind::copy_in_response)
+                    {
+                        // We're entering COPY IN. The user sends the data and finishes the COPY
+                        // before resuming us. The server won't send anything else until then
+                        // (except for an error, if the data is rejected)
+                        NATIVEPG_YIELD(resume_point_, 7, res.message.get_copy_in_response())
+                    }
+                    else if (res.message.type() == any_backend_message::kind::copy_both_response)
+                    {
+                        // We're entering CopyBoth (replication). The server streams data
+                        // as CopyData messages, which we return as in COPY OUT.
+                        // The user may send data at any time, and finishes with CopyDone
+                        NATIVEPG_YIELD(resume_point_, 8, res.message.get_copy_both_response())
+                    }
                     else if (res.message.type() == any_backend_message::kind::copy_data)
                     {
                         // Store them, we'll return the entire batch when ready
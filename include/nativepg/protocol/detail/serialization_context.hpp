@@ -28,6 +28,7 @@ class serialization_context
 {
     std::vector<unsigned char>& buffer_;
     std::size_t header_offset_{static_cast<std::size_t>(-1)};  // where is the message header?
+    std::size_t external_size_{};  // bytes in the message that are not stored in buffer_
     std::error_code err_;
 
 public:
@@ -74,6 +75,10 @@ public:
 
     void add_byte(unsigned char byte) { buffer_.push_back(byte); }
 
+    // Records that the message contains size bytes that are not stored in the buffer
+    // (e.g. borrowed parameters)
+    void add_external_size(std::size_t size) { external_size_ += size; }
+
     void add_header(char msg_type)
     {
         // There shouldn't be an in-progress message
@@ -98,7 +103,7 @@ public:
 
         // Compute the length to serialize. Everything except the type
         BOOST_ASSERT(buffer_.size() >= header_offset_ + 5u);
-        auto size = buffer_.size() - header_offset_ - 1u;
+        auto size = buffer_.size() - header_offset_ - 1u + external_size_;
 
         // Check that the length doesn't exceed an int32
         if (size > (std::numeric_limits<std::int32_t>::max)())
@@ -109,6 +114,7 @@ public:
 
         // Record that we're no longer composing a message
         header_offset_ = static_cast<std::size_t>(-1);
+        external_size_ = 0u;
 
         // Done
         return {};
@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_PROTOCOL_PGOUTPUT_HPP
+#define NATIVEPG_PROTOCOL_PGOUTPUT_HPP
+
+// Messages generated by pgoutput, the built-in logical decoding output plugin,
+// contained in xlog_data messages. Protocol version 1, or later versions without
+// streaming of in-progress transactions or two-phase commit.
+// Messages are views into the data they were parsed from, and don't copy anything.
+// Relation messages describe the tables referenced by the following messages, and are sent
+// once per session (or after the table changes), so they should be stored by the application.
+
+#include <boost/variant2/variant.hpp>
+#include <system_error>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "nativepg/protocol/describe.hpp"  // random_access_traits<std::int32_t>
+#include "nativepg/protocol/views.hpp"
+
+namespace nativepg {
+namespace protocol {
+namespace pgoutput {
+
+enum class tuple_column_kind : unsigned char
+{
+    // The value is NULL.
+    null = 'n',
+
+    // An unchanged TOASTed value. The actual value is not sent.
+    unchanged_toast = 'u',
+
+    // The value is in text format.
+    text = 't',
+
+    // The value is in binary format.
+    binary = 'b',
+};
+
+struct tuple_column
+{
+    tuple_column_kind kind;
+
+    // The serialized value, if kind is text or binary. Empty otherwise.
+    std::span<const unsigned char> value;
+};
+
+struct relation_column
+{
+    // Whether the column is part of the key.
+    bool is_key;
+
+    // The name of the column.
+    std::string_view name;
+
+    // The OID of the column's data type.
+    std::int32_t type_oid;
+
+    // Type modifier of the column (atttypmod).
+    std::int32_t type_modifier;
+};
+
+}  // namespace pgoutput
+
+namespace detail {
+
+// Collections impl
+template <>
+struct forward_traits<pgoutput::tuple_column>
+{
+    static pgoutput::tuple_column dereference(const unsigned char* data);
+    static const unsigned char* advance(const unsigned char* data);
+};
+
+template <>
+struct forward_traits<pgoutput::relation_column>
+{
+    static pgoutput::relation_column dereference(const unsigned char* data);
+    static const unsigned char* advance(const unsigned char* data);
+};
+
+}  // namespace detail
+
+namespace pgoutput {
+
+// The columns of a row
+using tuple_data = forward_parsing_view<tuple_column>;
+
+// Which columns are contained in the old row of updates and deletes
+enum class old_tuple_kind : unsigned char
+{
+    // There is no old row.
+    none = 0,
+
+    // The old row contains only the columns of the replica identity (e.g. the primary key).
+    key = 'K',
+
+    // The old row contains all the columns (REPLICA IDENTITY FULL).
+    full = 'O',
+};
+
+struct begin_message
+{
+    // The final LSN of the transaction.
+    std::uint64_t final_lsn;
+
+    // Commit timestamp of the transaction.
+    std::int64_t commit_time;
+
+    // Xid of the transaction.
+    std::int32_t xid;
+};
+
+struct commit_message
+{
+    // Flags; currently unused.
+    std::uint8_t flags;
+
+    // The LSN of the commit.
+    std::uint64_t commit_lsn;
+
+    // The end LSN of the transaction. Acknowledge this position once the transaction has been processed.
+    std::uint64_t end_lsn;
+
+    // Commit timestamp of the transaction.
+    std::int64_t commit_time;
+};
+
+struct origin_message
+{
+    // The LSN of the commit on the origin server.
+    std::uint64_t commit_lsn;
+
+    // Name of the origin.
+    std::string_view name;
+};
+
+struct relation_message
+{
+    // OID of the relation.
+    std::int32_t oid;
+
+    // Namespace (empty string for pg_catalog).
+    std::string_view nspname;
+
+    // Relation name.
+    std::string_view name;
+
+    // Replica identity setting for the relation (same as relreplident in pg_class).
+    char replica_identity;
+
+    // The relation's columns.
+    forward_parsing_view<relation_column> columns;
+};
+
+struct type_message
+{
+    // OID of the data type.
+    std::int32_t oid;
+
+    // Namespace (empty string for pg_catalog).
+    std::string_view nspname;
+
+    // Name of the data type.
+    std::string_view name;
+};
+
+struct insert_message
+{
+    // OID of the relation corresponding to the ID in the relation message.
+    std::int32_t relation_oid;
+
+    // The inserted row.
+    tuple_data new_tuple;
+};
+
+struct update_message
+{
+    // OID of the relation corresponding to the ID in the relation message.
+    std::int32_t relation_oid;
+
+    // Whether old_tuple is present, and which columns it contains.
+    old_tuple_kind old_kind;
+
+    // The old row, if old_kind is not none.
+    tuple_data old_tuple;
+
+    // The updated row.
+    tuple_data new_tuple;
+};
+
+struct delete_message
+{
+    // OID of the relation corresponding to the ID in the relation message.
+    std::int32_t relation_oid;
+
+    // Which columns old_tuple contains. Never none.
+    old_tuple_kind old_kind;
+
+    // The deleted row.
+    tuple_data old_tuple;
+};
+
+struct truncate_message
+{
+    // Option bits for TRUNCATE: 1 for CASCADE, 2 for RESTART IDENTITY.
+    std::uint8_t options;
+
+    // OIDs of the relations corresponding to the ID in the relation message.
+    random_access_parsing_view<std::int32_t> relation_oids;
+};
+
+struct logical_message
+{
+    // Flags; either 0 for no flags or 1 if the logical decoding message is transactional.
+    std::uint8_t flags;
+
+    // The LSN of the logical decoding message.
+    std::uint64_t lsn;
+
+    // The prefix of the logical decoding message.
+    std::string_view prefix;
+
+    // The content of the logical decoding message.
+    std::span<const unsigned char> content;
+};
+
+// Any of the messages generated by pgoutput. Messages for streamed or two-phase
+// transactions are rejected with client_errc::protocol_value_error
+using message = boost::variant2::variant<
+    begin_message,
+    commit_message,
+    origin_message,
+    relation_message,
+    type_message,
+    insert_message,
+    update_message,
+    delete_message,
+    truncate_message,
+    logical_message>;
+std::error_code parse(std::span<const unsigned char> data, message& to);
+
+}  // namespace pgoutput
+}  // namespace protocol
+}  // namespace nativepg
+
+#endif
@@ -0,0 +1,83 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_PROTOCOL_REPLICATION_HPP
+#define NATIVEPG_PROTOCOL_REPLICATION_HPP
+
+// Messages exchanged during replication (START_REPLICATION), as the contents of CopyData messages.
+// Positions in the write-ahead log (LSNs) are 64 bit unsigned integers.
+// Times are microseconds since midnight on 2000-01-01 (the Postgres epoch).
+
+#include <boost/variant2/variant.hpp>
+#include <system_error>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace nativepg {
+namespace protocol {
+
+struct xlog_data
+{
+    // The starting point of the WAL data in this message.
+    std::uint64_t wal_start;
+
+    // The current end of WAL on the server.
+    std::uint64_t wal_end;
+
+    // The server's system clock at the time of transmission.
+    std::int64_t send_time;
+
+    // A section of the WAL data stream. In logical replication, a message
+    // generated by the output plugin (e.g. a pgoutput message).
+    std::span<const unsigned char> data;
+};
+
+struct primary_keepalive
+{
+    // The current end of WAL on the server.
+    std::uint64_t wal_end;
+
+    // The server's system clock at the time of transmission.
+    std::int64_t send_time;
+
+    // If true, the client should reply to this message as soon as possible, to avoid a timeout disconnect.
+    bool reply_requested;
+};
+
+// Any of the messages that the server sends during replication
+using replication_message = boost::variant2::variant<xlog_data, primary_keepalive>;
+std::error_code parse(std::span<const unsigned char> data, replication_message& to);
+
+struct standby_status_update
+{
+    // The location of the last WAL byte + 1 received and written to disk in the standby.
+    std::uint64_t written;
+
+    // The location of the last WAL byte + 1 flushed to disk in the standby.
+    // The server may discard WAL before this position.
+    std::uint64_t flushed;
+
+    // The location of the last WAL byte + 1 applied in the standby.
+    std::uint64_t applied;
+
+    // The client's system clock at the time of transmission.
+    std::int64_t send_time;
+
+    // If true, the client requests the server to reply to this message immediately.
+    bool reply_requested;
+};
+
+// Serializes the message without any header. Send it as a CopyData message
+// (e.g. using co_connection::write_copy_message)
+std::error_code serialize(const standby_status_update& msg, std::vector<unsigned char>& to);
+
+}  // namespace protocol
+}  // namespace nativepg
+
+#endif
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_REPLICATION_HPP
+#define NATIVEPG_REPLICATION_HPP
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "nativepg/protocol/replication.hpp"
+
+namespace nativepg {
+
+// Formats a WAL position as Postgres does (e.g. 16/B374D848), for use in START_REPLICATION
+inline std::string format_lsn(std::uint64_t lsn)
+{
+    char buff[32];
+    auto* end = std::to_chars(buff, buff + sizeof(buff), static_cast<std::uint32_t>(lsn >> 32u), 16).ptr;
+    *end++ = '/';
+    end = std::to_chars(end, buff + sizeof(buff), static_cast<std::uint32_t>(lsn), 16).ptr;
+    std::string res(buff, end);
+    std::transform(res.begin(), res.end(), res.begin(), [](char c) {
+        return c >= 'a' && c <= 'f' ? static_cast<char>(c - 'a' + 'A') : c;
+    });
+    return res;
+}
+
+// Parses a WAL position formatted as Postgres does (e.g. 16/B374D848)
+inline std::optional<std::uint64_t> parse_lsn(std::string_view value)
+{
+    auto slash = value.find('/');
+    if (slash == std::string_view::npos)
+        return {};
+    std::uint32_t high = 0u, low = 0u;
+    const char* last = value.data() + value.size();
+    auto res1 = std::from_chars(value.data(), value.data() + slash, high, 16);
+    auto res2 = std::from_chars(value.data() + slash + 1u, last, low, 16);
+    if (res1.ec != std::errc() || res1.ptr != value.data() + slash || slash == 0u || res2.ec != std::errc() ||
+        res2.ptr != last || slash + 1u == value.size())
+        return {};
+    return (static_cast<std::uint64_t>(high) << 32u) | low;
+}
+
+// Converts a point in time to the representation used in replication messages:
+// microseconds since midnight on 2000-01-01
+inline std::int64_t to_replication_time(std::chrono::system_clock::time_point tp)
+{
+    // Seconds between the Unix and the Postgres epochs
+    constexpr std::chrono::seconds epoch_offset{946684800};
+    auto res = std::chrono::duration_cast<std::chrono::microseconds>(tp.time_since_epoch() - epoch_offset);
+    return res.count();
+}
+
+/**
+ * Decides when to send standby status updates during logical replication.
+ *
+ * Acknowledging each transaction with its own status update costs a message per
+ * transaction, and the server does work for each one. Instead, the application
+ * reports the positions it has processed with confirm(), and an update is sent
+ * every once in a while, reporting the last one:
+ *
+ *   - When the server requests it (in a primary_keepalive).
+ *   - When the confirmed position has advanced max_unreported_bytes since the last update.
+ *   - When interval has elapsed since the last update, even if nothing changed,
+ *     so that the server doesn't disconnect us (see wal_sender_timeout).
+ *
+ * This class performs no I/O and reads no clocks. Pass every message received from the server
+ * to on_message(). After processing a batch of messages, call needs_update() and, if true,
+ * send the message returned by make_update().
+ */
+class replication_feedback
+{
+    std::uint64_t received_{};
+    std::uint64_t confirmed_{};
+    std::uint64_t reported_{};
+    std::chrono::steady_clock::time_point last_sent_{};
+    std::chrono::steady_clock::duration interval_;
+    std::uint64_t max_unreported_bytes_;
+    bool reply_requested_{};
+
+public:
+    static constexpr std::chrono::seconds default_interval{10};
+    static constexpr std::uint64_t default_max_unreported_bytes = 16u * 1024u * 1024u;
+
+    // start_lsn is the position where replication started
+    explicit replication_feedback(
+        std::uint64_t start_lsn = 0u,
+        std::chrono::steady_clock::duration interval = default_interval,
+        std::uint64_t max_unreported_bytes = default_max_unreported_bytes
+    )
+        : received_(start_lsn),
+          confirmed_(start_lsn),
+          reported_(start_lsn),
+          interval_(interval),
+          max_unreported_bytes_(max_unreported_bytes)
+    {
+    }
+
+    // The position after the last byte received
+    std::uint64_t received_lsn() const { return received_; }
+
+    // The last position passed to confirm()
+    std::uint64_t confirmed_lsn() const { return confirmed_; }
+
+    // The confirmed position in the last update
+    std::uint64_t reported_lsn() const { return reported_; }
+
+    void on_message(const protocol::xlog_data& msg)
+    {
+        received_ = (std::max)(received_, msg.wal_start + msg.data.size());
+    }
+
+    void on_message(const protocol::primary_keepalive& msg)
+    {
+        if (msg.reply_requested)
+            reply_requested_ = true;
+    }
+
+    void on_message(const protocol::replication_message& msg)
+    {
+        boost::variant2::visit([this](const auto& value) { on_message(value); }, msg);
+    }
+
+    // Marks all the changes before lsn (e.g. commit_message::end_lsn) as processed.
+    // The server may discard them, and they won't be sent again after a reconnection
+    void confirm(std::uint64_t lsn) { confirmed_ = (std::max)(confirmed_, lsn); }
+
+    // Should a status update be sent now?
+    bool needs_update(std::chrono::steady_clock::time_point now) const
+    {
+        return reply_requested_ || confirmed_ - reported_ >= max_unreported_bytes_ ||
+               now - last_sent_ >= interval_;
+    }
+
+    // Composes a status update and records it as sent. Changes are reported as written
+    // once received, and as flushed and applied once confirmed. wall_now is reported to the server
+    protocol::standby_status_update make_update(
+        std::chrono::steady_clock::time_point now,
+        std::chrono::system_clock::time_point wall_now
+    )
+    {
+        reported_ = confirmed_;
+        last_sent_ = now;
+        reply_requested_ = false;
+        return {
+            .written = (std::max)(received_, confirmed_),
+            .flushed = confirmed_,
+            .applied = confirmed_,
+            .send_time = to_replication_time(wall_now),
+            .reply_requested = false,
+        };
+    }
+};
+
+}  // namespace nativepg
+
+#endif
@@ -64,6 +64,7 @@ struct statement
 class request
 {
     std::vector<unsigned char> buffer_;
+    std::vector<protocol::borrowed_chunk> borrowed_;
     std::vector<request_message_type> types_;
     bool autosync_;
 
@@ -100,10 +101,47 @@ public:
     bool autosync() const { return autosync_; }
     void set_autosync(bool value) { autosync_ = value; }
 
-    // Returns the serialized payload
+    // Returns the serialized payload. If the request contains borrowed parameters
+    // (see borrowed_bytea), their data is not included here. Use for_each_payload_segment
+    // to get the complete payload in this case.
     std::span<const unsigned char> payload() const { return buffer_; }
     std::span<const request_message_type> messages() const { return types_; }
 
+    // Does the payload reference caller-owned memory?
+    bool has_borrowed_data() const { return !borrowed_.empty(); }
+
+    // The borrowed chunks of the payload, sorted by offset
+    std::span<const protocol::borrowed_chunk> borrowed_chunks() const { return borrowed_; }
+
+    // Returns the total size of the payload, including borrowed data
+    std::size_t payload_size() const
+    {
+        std::size_t res = buffer_.size();
+        for (const auto& chunk : borrowed_)
+            res += chunk.data.size();
+        return res;
+    }
+
+    // Invokes fn(std::span<const unsigned char>) for each contiguous segment of the payload,
+    // in order. Segments alternate between the request's buffer and borrowed memory.
+    // Concatenating them yields the complete payload.
+    template <class Fn>
+    void for_each_payload_segment(Fn&& fn) const
+    {
+        std::span<const unsigned char> buff{buffer_};
+        std::size_t offset = 0u;
+        for (const auto& chunk : borrowed_)
+        {
+            if (chunk.offset > offset)
+                fn(buff.subspan(offset, chunk.offset - offset));
+            if (!chunk.data.empty())
+                fn(chunk.data);
+            offset = chunk.offset;
+        }
+        if (offset < buff.size())
+            fn(buff.subspan(offset));
+    }
+
     // Adds a simple query (PQsendQuery)
     request& add_simple_query(std::string_view q) { return add(protocol::query{q}); }
 
@@ -268,7 +306,17 @@ public:
 
     request& add_sync() { return add(protocol::sync{}); }
 
-    request& add(const protocol::bind& value) { return add_advanced_impl(value, request_message_type::bind); }
+    request& add(const protocol::bind& value)
+    {
+        types_.reserve(types_.size() + 1u);  // strong guarantee
+        std::size_t num_borrowed = borrowed_.size();
+        auto ec = protocol::serialize(value, buffer_, borrowed_);
+        if (ec)
+            borrowed_.resize(num_borrowed);
+        check(ec);
+        types_.push_back(request_message_type::bind);
+        return *this;
+    }
 
     request& add(const protocol::close& value)
     {
@@ -8,6 +8,8 @@
 #ifndef NATIVEPG_INTO_HPP
 #define NATIVEPG_INTO_HPP
 
+#include <concepts>
+#include <utility>
 #include <vector>
 
 #include "nativepg/responses/resultset_callback.hpp"
@@ -33,6 +35,18 @@ resultset_callback_t<T, detail::into_handler<T>> into(std::vector<T>& vec, comma
     return resultset_callback_t<T, detail::into_handler<T>>{detail::into_handler<T>{vec}, out_info};
 }
 
+// Same, but invoking row_init on each row before parsing it.
+// E.g. into(vec, types::json_storage{arena}) allocates JSON members from arena
+template <class T, std::invocable<T&> RowInit>
+resultset_callback_t<T, detail::into_handler<T>, RowInit> into(
+    std::vector<T>& vec,
+    RowInit row_init,
+    command_info* out_info = nullptr
+)
+{
+    return {detail::into_handler<T>{vec}, std::move(row_init), out_info};
+}
+
 }  // namespace nativepg
 
 #endif
@@ -71,6 +71,13 @@ const extended_error* response_get_result(const H0& h0, const HRest&... hrest)
     }
 }
 
+template <class H>
+void maybe_set_type_registry(H& h, const type_registry* types)
+{
+    if constexpr (type_registry_aware<H>)
+        h.set_type_registry(types);
+}
+
 }  // namespace detail
 
 template <response_handler... Handlers>
@@ -99,6 +106,11 @@ public:
         );
     }
 
+    void set_type_registry(const type_registry* types)
+    {
+        std::apply([types](auto&... h) { (detail::maybe_set_type_registry(h, types), ...); }, handlers_);
+    }
+
     void on_message(const any_request_message& msg, std::size_t offset)
     {
         // Advance to the next element, if required
@@ -25,6 +25,7 @@
 #include "nativepg/protocol/notice_error.hpp"
 #include "nativepg/protocol/parse.hpp"
 #include "nativepg/request.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg {
 
@@ -74,17 +75,27 @@ concept response_handler = requires(
     { handler.result() } -> std::same_as<const extended_error&>;
 };
 
+// Handlers that parse fields may optionally satisfy this concept, to get access
+// to the connection's type registry (see type_registry). It's invoked
+// before setup, and the registry outlives the operation. It may be nullptr.
+template <class T>
+concept type_registry_aware = requires(T& handler, const type_registry* types) {
+    { handler.set_type_registry(types) };
+};
+
 // Type-erased reference to a response handler
 class response_handler_ref
 {
     using setup_fn = handler_setup_result (*)(void*, const request&, std::size_t);
     using on_message_fn = void (*)(void*, const any_request_message&, std::size_t);
     using result_fn = const extended_error& (*)(const void*);
+    using set_type_registry_fn = void (*)(void*, const type_registry*);
 
     void* obj_;
     setup_fn setup_;
     on_message_fn on_message_;
     result_fn result_;
+    set_type_registry_fn set_type_registry_;
 
     template <class T>
     static handler_setup_result do_setup(void* obj, const request& req, std::size_t offset)
@@ -104,13 +115,26 @@ class response_handler_ref
         return static_cast<const T*>(obj)->result();
     }
 
+    template <class T>
+    static void do_set_type_registry(void* obj, const type_registry* types)
+    {
+        if constexpr (type_registry_aware<T>)
+            static_cast<T*>(obj)->set_type_registry(types);
+    }
+
 public:
     template <response_handler T>
     response_handler_ref(T* obj) noexcept
-        : obj_(obj), setup_(&do_setup<T>), on_message_(&do_on_message<T>), result_(&do_result<T>)
+        : obj_(obj),
+          setup_(&do_setup<T>),
+          on_message_(&do_on_message<T>),
+          result_(&do_result<T>),
+          set_type_registry_(&do_set_type_registry<T>)
     {
     }
 
+    void set_type_registry(const type_registry* types) { set_type_registry_(obj_, types); }
+
     handler_setup_result setup(const request& req, std::size_t offset) { return setup_(obj_, req, offset); }
     void on_message(const any_request_message& req, std::size_t offset)
     {
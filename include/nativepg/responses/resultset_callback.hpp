@@ -13,6 +13,7 @@
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
 #include "nativepg/detail/row_traits.hpp"
@@ -46,11 +47,22 @@ std::error_code compute_pos_map(
     std::span<pos_map_entry> output
 );
 
+// The default row initializer: rows are value-initialized, and nothing else is done
+struct no_row_init
+{
+    template <class T>
+    void operator()(T&) const noexcept
+    {
+    }
+};
+
 }  // namespace detail
 
 // Handles a resultset (i.e. a row_description + data_rows + command_complete)
-// by invoking a user-supplied callback
-template <class T, std::invocable<T&&> Callback>
+// by invoking a user-supplied callback.
+// RowInit is invoked on each value-initialized row before parsing its fields into it.
+// It lets members use custom memory resources (see types::json_storage).
+template <class T, std::invocable<T&&> Callback, std::invocable<T&> RowInit = detail::no_row_init>
 class resultset_callback_t
 {
     enum class state_t
@@ -65,7 +77,9 @@ class resultset_callback_t
     std::vector<field_view> random_access_data_;
     extended_error err_;
     Callback cb_;
+    RowInit row_init_;
     command_info* info_{};
+    const type_registry* types_{};
 
     void store_error(std::error_code ec)
     {
@@ -122,9 +136,9 @@ class resultset_callback_t
                 mp_transform<std::type_identity, detail::row_field_types_t<T>>;
             std::size_t idx = 0u;
             boost::mp11::mp_for_each<type_identities>(
-                [&idx, &ec, &pos_map = self.pos_map_](auto type_identity) {
+                [&idx, &ec, &pos_map = self.pos_map_, types = self.types_](auto type_identity) {
                     using FieldType = typename decltype(type_identity)::type;
-                    auto ec2 = field_is_compatible<FieldType>(pos_map[idx++].type_oid);
+                    auto ec2 = field_is_compatible<FieldType>(pos_map[idx++].type_oid, types);
                     if (!ec)
                         ec = ec2;
                 }
@@ -153,6 +167,7 @@ class resultset_callback_t
 
             // Now invoke parse
             T row{};
+            self.row_init_(row);
             std::error_code ec;
             std::size_t idx = 0u;
             detail::for_each_member(row, [&ec, &idx, &self = this->self](auto& member) {
@@ -211,6 +226,14 @@ public:
     {
     }
 
+    template <std::invocable<T&&> Cb>
+    resultset_callback_t(Cb&& cb, RowInit row_init, command_info* out_info = nullptr)
+        : cb_(std::forward<Cb>(cb)), row_init_(std::move(row_init)), info_(out_info)
+    {
+    }
+
+    void set_type_registry(const type_registry* types) { types_ = types; }
+
     handler_setup_result setup(const request& req, std::size_t offset)
     {
         state_ = state_t::parsing_meta;
@@ -235,6 +258,17 @@ auto resultset_callback(Callback&& cb, command_info* info = nullptr)
     return resultset_callback_t<T, std::decay_t<Callback>>{std::forward<Callback>(cb), info};
 }
 
+// Same, but invoking row_init on each row before parsing it
+template <class T, std::invocable<T&&> Callback, std::invocable<T&> RowInit>
+auto resultset_callback(Callback&& cb, RowInit row_init, command_info* info = nullptr)
+{
+    return resultset_callback_t<T, std::decay_t<Callback>, RowInit>{
+        std::forward<Callback>(cb),
+        std::move(row_init),
+        info
+    };
+}
+
 }  // namespace nativepg
 
 #endif
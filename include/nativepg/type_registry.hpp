@@ -0,0 +1,106 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_TYPE_REGISTRY_HPP
+#define NATIVEPG_TYPE_REGISTRY_HPP
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nativepg {
+
+/**
+ * Maps type names to OIDs, for types that don't have a fixed OID:
+ * types created by extensions (e.g. citext, hstore), enums, domains
+ * and user-defined composites.
+ *
+ * Call `require` with the names your application uses. Connections
+ * holding a registry look up the pending names in pg_type once, after
+ * connecting. Names are resolved using to_regtype, so they may be
+ * schema-qualified. The registry can be shared between connections to the same
+ * database (as connection pools do), so each name is only looked up once.
+ *
+ * parse_field_traits specializations declaring a `type_name` are then
+ * matched by comparing the resolved OID with the one sent by the server.
+ *
+ * This class is not thread-safe. Connections sharing a registry
+ * must run in the same execution context.
+ */
+class type_registry
+{
+    struct entry
+    {
+        // 0 if the name hasn't been looked up yet, or the type doesn't exist
+        std::int32_t oid{};
+        std::int32_t array_oid{};
+        bool looked_up{};
+    };
+
+    std::map<std::string, entry, std::less<>> entries_;
+
+    const entry* find(std::string_view name) const
+    {
+        auto it = entries_.find(name);
+        return it == entries_.end() ? nullptr : &it->second;
+    }
+
+public:
+    type_registry() = default;
+
+    // Marks a type name to be looked up by connections using this registry.
+    // Has no effect if the name was already required
+    void require(std::string_view name) { entries_.try_emplace(std::string(name)); }
+
+    // Stores the result of a lookup. oid is 0 if the type doesn't exist
+    void add(std::string_view name, std::int32_t oid, std::int32_t array_oid)
+    {
+        auto it = entries_.try_emplace(std::string(name)).first;
+        it->second = {oid, array_oid, true};
+    }
+
+    // The OID of a type, or 0 if it's unknown
+    std::int32_t oid(std::string_view name) const
+    {
+        const auto* ent = find(name);
+        return ent ? ent->oid : 0;
+    }
+
+    // The OID of the array type whose elements are of the given type, or 0 if it's unknown
+    std::int32_t array_oid(std::string_view name) const
+    {
+        const auto* ent = find(name);
+        return ent ? ent->array_oid : 0;
+    }
+
+    // Names that have been required but not looked up yet
+    std::vector<std::string_view> pending() const
+    {
+        std::vector<std::string_view> res;
+        for (const auto& [name, ent] : entries_)
+        {
+            if (!ent.looked_up)
+                res.push_back(name);
+        }
+        return res;
+    }
+
+    // Forgets all lookup results, so names are looked up again on the next connection.
+    // Use this if types are dropped and re-created (e.g. after DROP EXTENSION)
+    void invalidate()
+    {
+        for (auto& [name, ent] : entries_)
+            ent = {};
+    }
+};
+
+}  // namespace nativepg
+
+#endif
@@ -9,6 +9,8 @@
 #define NATIVEPG_TYPES_HPP
 
 #include "types/base.hpp"
+#include "types/composite.hpp"
 #include "types/datetime.hpp"
+#include "types/fixed.hpp"
 
 #endif  // NATIVEPG_TYPES_HPP
@@ -12,7 +12,10 @@
 
 #include <algorithm>
 #include <charconv>
+#include <cmath>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <span>
 #include <string>
@@ -62,6 +65,14 @@ std::error_code parse_text_to_number(const std::string_view& sv, T& to)
     return {};
 }
 
+// Decodes size hex characters into size / 2 bytes. size must be even.
+// Returns false if any of the characters is not a hex digit.
+// Uses SIMD instructions when the CPU supports them.
+bool hex_decode(const char* input, std::size_t size, unsigned char* output) noexcept;
+
+// Encodes size bytes into 2 * size lowercase hex characters
+void hex_encode(const unsigned char* input, std::size_t size, char* output) noexcept;
+
 }  // namespace detail
 
 // BOOL => bool;
@@ -86,6 +97,18 @@ std::error_code parse_binary_bool(const field_view& from, T& to)
     return {};
 }
 
+inline std::error_code serialize_text_bool(bool value, std::vector<unsigned char>& to)
+{
+    to.push_back(value ? 't' : 'f');
+    return {};
+}
+
+inline std::error_code serialize_binary_bool(bool value, std::vector<unsigned char>& to)
+{
+    to.push_back(value ? 1u : 0u);
+    return {};
+}
+
 // BYTEA => std::vector<std::byte>>;
 template <class T = std::vector<std::byte>>
 std::error_code parse_text_bytea(const field_view& from, T& to)
@@ -97,15 +120,11 @@ std::error_code parse_text_bytea(const field_view& from, T& to)
     sv.remove_prefix(2);
     if (sv.size() % 2 != 0)
         return client_errc::protocol_value_error;
-    to.clear();
-    to.reserve(sv.size() / 2);
-    for (std::size_t i = 0; i < sv.size(); i += 2)
+    to.resize(sv.size() / 2);
+    if (!detail::hex_decode(sv.data(), sv.size(), reinterpret_cast<unsigned char*>(to.data())))
     {
-        unsigned char byte{};
-        if (auto [ptr, ec] = std::from_chars(sv.data() + i, sv.data() + i + 2, byte, 16);
-            ec != std::errc{} || ptr != sv.data() + i + 2)
-            return client_errc::protocol_value_error;
-        to.push_back(static_cast<std::byte>(byte));
+        to.clear();
+        return client_errc::protocol_value_error;
     }
     return {};
 }
@@ -122,6 +141,33 @@ std::error_code parse_binary_bytea(const field_view& from, T& to)
     return {};
 }
 
+inline std::error_code serialize_text_bytea(std::span<const std::byte> value, std::vector<unsigned char>& to)
+{
+    // \x followed by hex pairs
+    const auto offset = to.size();
+    to.resize(offset + 2u + value.size() * 2u);
+    unsigned char* ptr = to.data() + offset;
+    ptr[0] = '\\';
+    ptr[1] = 'x';
+    detail::hex_encode(
+        reinterpret_cast<const unsigned char*>(value.data()),
+        value.size(),
+        reinterpret_cast<char*>(ptr + 2)
+    );
+    return {};
+}
+
+inline std::error_code serialize_binary_bytea(
+    std::span<const std::byte> value,
+    std::vector<unsigned char>& to
+)
+{
+    // Binary format is raw bytes
+    const auto* data = reinterpret_cast<const unsigned char*>(value.data());
+    to.insert(to.end(), data, data + value.size());
+    return {};
+}
+
 // "CHAR" => char (INTERNAL CHAR NOT CHAR(N) / CHARACTER(N)!)
 template <class T>
 std::error_code parse_text_char(const field_view& from, T& to)
@@ -142,6 +188,19 @@ std::error_code parse_binary_char(const field_view& from, T& to)
     return {};
 }
 
+// The text and binary representations of "char" are the same single byte
+inline std::error_code serialize_text_char(char value, std::vector<unsigned char>& to)
+{
+    to.push_back(static_cast<unsigned char>(value));
+    return {};
+}
+
+inline std::error_code serialize_binary_char(char value, std::vector<unsigned char>& to)
+{
+    to.push_back(static_cast<unsigned char>(value));
+    return {};
+}
+
 // INT => std::int_t
 template <class T>
 std::error_code parse_text_int(const field_view& from, T& to)
@@ -199,6 +258,40 @@ std::error_code parse_binary_float(const field_view& from, T& to)
     return {};
 }
 
+template <std::floating_point T>
+std::error_code serialize_text_float(T value, std::vector<unsigned char>& to)
+{
+    // Special values are spelled the way the server prints them
+    std::string_view special;
+    if (std::isnan(value))
+        special = "NaN";
+    else if (std::isinf(value))
+        special = value > 0 ? "Infinity" : "-Infinity";
+    if (!special.empty())
+    {
+        to.insert(to.end(), special.begin(), special.end());
+        return {};
+    }
+
+    // The shortest representation that round-trips. The buffer is always big enough
+    char buffer[64];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    if (result.ec != std::errc{})
+        return std::error_code(std::make_error_code(result.ec));
+    to.insert(to.end(), buffer, result.ptr);
+    return {};
+}
+
+template <std::floating_point T>
+std::error_code serialize_binary_float(T value, std::vector<unsigned char>& to)
+{
+    constexpr std::size_t size = sizeof(T);
+    auto offset = to.size();
+    to.resize(offset + size);
+    boost::endian::endian_store<T, size, boost::endian::order::big>(to.data() + offset, value);
+    return {};
+}
+
 // TEXT | VARCHAR => std::string
 template <class T = std::string>
 std::error_code parse_text_text(const field_view& from, T& to)
@@ -0,0 +1,168 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_TYPES_COMPOSITE_HPP
+#define NATIVEPG_TYPES_COMPOSITE_HPP
+
+#include <boost/describe/members.hpp>
+#include <boost/endian/conversion.hpp>
+#include <system_error>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/detail/row_traits.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/field_view.hpp"
+
+// Composite types (records) and arrays of composites, mapped to Boost.Describe structs.
+// Composite fields are matched to struct members by position, since the wire format
+// doesn't include field names. Each member is parsed using its own parse_field_traits,
+// so composites can be nested. Only the binary format is supported.
+//
+// | Type                  | OID            | C++ type                 |
+// |-----------------------|----------------|--------------------------|
+// | record, row types     | 2249, user     | described struct         |
+// | record[], row types[] | 2287, user     | std::vector<struct>      |
+
+namespace nativepg::types {
+
+// A struct that can be used to parse composites
+template <class T>
+concept composite_struct = boost::describe::has_describe_members<T>::value;
+
+// Specialize this to declare the Postgres composite type a struct maps to, e.g.
+//
+//    template <>
+//    inline constexpr std::string_view nativepg::types::composite_type_name<item> = "inventory_item";
+//
+// and require the name in the connection's type_registry. Fields are then accepted
+// only if their type (or, for std::vector<item>, their array type) is the resolved one.
+// Otherwise, any record or user-defined type is accepted, and mismatches are
+// only detected when parsing each value.
+template <class T>
+inline constexpr std::string_view composite_type_name{};
+
+namespace detail {
+
+// Splits the next int32 from the input
+inline bool consume_int32(std::span<const unsigned char>& data, std::int32_t& to)
+{
+    if (data.size() < 4u)
+        return false;
+    to = boost::endian::endian_load<std::int32_t, 4, boost::endian::order::big>(data.data());
+    data = data.subspan(4u);
+    return true;
+}
+
+// Splits a length-prefixed value from the input. A length of -1 represents a NULL
+inline bool consume_field(std::span<const unsigned char>& data, field_view& to)
+{
+    std::int32_t len{};
+    if (!consume_int32(data, len))
+        return false;
+    if (len == -1)
+    {
+        to = field_view();
+        return true;
+    }
+    if (len < 0 || data.size() < static_cast<std::size_t>(len))
+        return false;
+    to = field_view(data.first(static_cast<std::size_t>(len)));
+    data = data.subspan(static_cast<std::size_t>(len));
+    return true;
+}
+
+}  // namespace detail
+
+// Composite => T (BINARY). The format is the number of fields, followed by
+// the type OID, length and contents of each field
+template <composite_struct T>
+std::error_code parse_binary_composite(field_view from, T& to)
+{
+    auto data = from.data();
+    std::int32_t num_fields{};
+    if (!detail::consume_int32(data, num_fields))
+        return client_errc::protocol_value_error;
+    if (num_fields < 0 || static_cast<std::size_t>(num_fields) != nativepg::detail::row_size_v<T>)
+        return client_errc::incompatible_field_type;
+
+    std::error_code ec;
+    nativepg::detail::for_each_member(to, [&ec, &data](auto& member) {
+        if (ec)
+            return;
+
+        std::int32_t type_oid{};
+        field_view fv;
+        if (!detail::consume_int32(data, type_oid) || !detail::consume_field(data, fv))
+        {
+            ec = client_errc::protocol_value_error;
+            return;
+        }
+
+        using member_type = std::remove_cvref_t<decltype(member)>;
+        ec = field_is_compatible<member_type>(type_oid);
+        if (!ec)
+            ec = field_parse_binary(fv, type_oid, member);
+    });
+    if (ec)
+        return ec;
+
+    return data.empty() ? std::error_code() : std::error_code(client_errc::extra_bytes);
+}
+
+// Array of composites => std::vector<T> (BINARY). The format is the number of dimensions,
+// a flag, the element type OID, the size and lower bound of each dimension,
+// and the length and contents of each element. Only one-dimensional arrays are supported.
+template <composite_struct T>
+std::error_code parse_binary_composite_array(field_view from, std::vector<T>& to)
+{
+    auto data = from.data();
+    std::int32_t num_dims{}, flags{}, elem_oid{};
+    if (!detail::consume_int32(data, num_dims) || !detail::consume_int32(data, flags) ||
+        !detail::consume_int32(data, elem_oid))
+        return client_errc::protocol_value_error;
+
+    // Empty arrays have zero dimensions
+    to.clear();
+    if (num_dims == 0)
+        return data.empty() ? std::error_code() : std::error_code(client_errc::extra_bytes);
+    if (num_dims != 1)
+        return client_errc::incompatible_field_type;
+
+    std::int32_t size{}, lower_bound{};
+    if (!detail::consume_int32(data, size) || !detail::consume_int32(data, lower_bound) || size < 0)
+        return client_errc::protocol_value_error;
+
+    if (auto ec = field_is_compatible<T>(elem_oid))
+        return ec;
+
+    // Each element has at least its length. Check before allocating
+    if (data.size() / 4u < static_cast<std::size_t>(size))
+        return client_errc::protocol_value_error;
+    to.reserve(static_cast<std::size_t>(size));
+
+    for (std::int32_t i = 0; i < size; ++i)
+    {
+        field_view fv;
+        if (!detail::consume_field(data, fv))
+            return client_errc::protocol_value_error;
+        if (auto ec = field_parse_binary(fv, elem_oid, to.emplace_back()))
+            return ec;
+    }
+
+    return data.empty() ? std::error_code() : std::error_code(client_errc::extra_bytes);
+}
+
+}  // namespace nativepg::types
+
+#endif
@@ -8,8 +8,11 @@
 #include <charconv>
 #include <chrono>
 #include <cctype>
+#include <cstdint>
+#include <limits>
 #include <span>
 #include <string_view>
+#include <vector>
 
 #include "nativepg/client_errc.hpp"
 
@@ -289,6 +292,167 @@ inline std::error_code parse_tz_suffix(
     return {};
 }
 
+// Fast path for the fixed layout that the server uses by default (DateStyle=ISO):
+// YYYY-MM-DD HH:MM:SS[.ffffff][+HH[:MM]]. Digits and separators are validated
+// 8 bytes at a time (SWAR). These functions return false if the input doesn't follow
+// the layout exactly or is out of range, and the generic parser should be used then.
+// This covers BC dates, infinities, years with more than 4 digits and unusual offsets.
+namespace iso {
+
+inline constexpr std::uint64_t ones = 0x0101010101010101u;
+
+inline std::uint64_t load8(const char* p)
+{
+    return boost::endian::endian_load<std::uint64_t, 8, boost::endian::order::little>(
+        reinterpret_cast<const unsigned char*>(p)
+    );
+}
+
+// Builds the digit mask and the expected separators for an 8 character
+// pattern, where 'd' stands for a digit
+constexpr std::uint64_t digit_mask(const char (&pattern)[9])
+{
+    std::uint64_t res = 0u;
+    for (unsigned i = 0; i < 8u; ++i)
+        if (pattern[i] == 'd')
+            res |= std::uint64_t(0xff) << (8u * i);
+    return res;
+}
+
+constexpr std::uint64_t separators(const char (&pattern)[9])
+{
+    std::uint64_t res = 0u;
+    for (unsigned i = 0; i < 8u; ++i)
+        if (pattern[i] != 'd')
+            res |= std::uint64_t(static_cast<unsigned char>(pattern[i])) << (8u * i);
+    return res;
+}
+
+// Checks that v matches the pattern: digit bytes are '0'-'9', and the rest equal the separators.
+// A byte is a digit if its high nibble is 3, and it still is after adding 6
+inline bool matches(std::uint64_t v, std::uint64_t mask, std::uint64_t seps)
+{
+    const std::uint64_t high_nibbles = mask & (ones * 0xf0u);
+    const std::uint64_t expected = mask & (ones * 0x30u);
+    return ((v & ~mask) == seps) & ((v & high_nibbles) == expected) &
+           (((v + ones * 0x06u) & high_nibbles) == expected);
+}
+
+// For every digit byte i, computes 10 * digit[i] + digit[i + 1] into byte i.
+// Requires matches() to be true
+inline std::uint64_t digit_pairs(std::uint64_t v, std::uint64_t mask)
+{
+    const std::uint64_t digits = (v & mask) - (mask & (ones * 0x30u));
+    return digits * 10u + (digits >> 8u);
+}
+
+inline unsigned byte_at(std::uint64_t v, unsigned i) { return static_cast<unsigned>(v >> (8u * i)) & 0xffu; }
+
+// YYYY-MM-DD, exactly 10 characters
+inline bool parse_date(const char* p, std::chrono::sys_days& to)
+{
+    // Two overlapping loads cover all the characters
+    constexpr std::uint64_t mask1 = digit_mask("dddd-dd-"), seps1 = separators("dddd-dd-");
+    constexpr std::uint64_t mask2 = digit_mask("dd-dd-dd"), seps2 = separators("dd-dd-dd");
+    const std::uint64_t v1 = load8(p), v2 = load8(p + 2);
+    if (!(matches(v1, mask1, seps1) & matches(v2, mask2, seps2)))
+        return false;
+
+    const std::uint64_t pairs1 = digit_pairs(v1, mask1), pairs2 = digit_pairs(v2, mask2);
+    const int year = static_cast<int>(byte_at(pairs1, 0) * 100u + byte_at(pairs1, 2));
+    const std::chrono::year_month_day ymd{
+        std::chrono::year{year},
+        std::chrono::month{byte_at(pairs2, 3)},
+        std::chrono::day{byte_at(pairs2, 6)}
+    };
+    if (!ymd.ok())
+        return false;
+    to = std::chrono::sys_days{ymd};
+    return true;
+}
+
+// HH:MM:SS[.ffffff]. Hours must be below 24. Sets p past the parsed characters
+inline bool parse_time(const char*& p, const char* last, std::chrono::microseconds& to)
+{
+    constexpr std::uint64_t mask = digit_mask("dd:dd:dd"), seps = separators("dd:dd:dd");
+    if (last - p < 8)
+        return false;
+    const std::uint64_t v = load8(p);
+    if (!matches(v, mask, seps))
+        return false;
+    const std::uint64_t pairs = digit_pairs(v, mask);
+    const unsigned hours = byte_at(pairs, 0), minutes = byte_at(pairs, 3), seconds = byte_at(pairs, 6);
+    if ((hours > 23u) | (minutes > 59u) | (seconds > 59u))
+        return false;
+    p += 8;
+
+    // The server strips trailing zeros from the fraction
+    std::int64_t us = 0;
+    if (p != last && *p == '.')
+    {
+        ++p;
+        int num_digits = 0;
+        for (; p != last && num_digits < 6; ++p, ++num_digits)
+        {
+            const unsigned digit = static_cast<unsigned char>(*p) - static_cast<unsigned>('0');
+            if (digit > 9u)
+                break;
+            us = us * 10 + digit;
+        }
+        if (num_digits == 0)
+            return false;
+        constexpr std::int64_t scale[] = {1000000, 100000, 10000, 1000, 100, 10, 1};
+        us *= scale[num_digits];
+    }
+
+    to = std::chrono::microseconds{(hours * 3600 + minutes * 60 + seconds) * std::int64_t(1000000) + us};
+    return true;
+}
+
+// +HH or +HH:MM, consuming the rest of the input
+inline bool parse_offset(const char* p, const char* last, std::chrono::seconds& to)
+{
+    const auto size = last - p;
+    if ((size != 3 && size != 6) || (p[0] != '+' && p[0] != '-'))
+        return false;
+    const unsigned h1 = static_cast<unsigned char>(p[1]) - static_cast<unsigned>('0');
+    const unsigned h2 = static_cast<unsigned char>(p[2]) - static_cast<unsigned>('0');
+    unsigned m1 = 0u, m2 = 0u;
+    if (size == 6)
+    {
+        if (p[3] != ':')
+            return false;
+        m1 = static_cast<unsigned char>(p[4]) - static_cast<unsigned>('0');
+        m2 = static_cast<unsigned char>(p[5]) - static_cast<unsigned>('0');
+    }
+    if ((h1 > 9u) | (h2 > 9u) | (m1 > 5u) | (m2 > 9u))
+        return false;
+    const int hours = static_cast<int>(h1 * 10u + h2);
+    if (hours > 15)
+        return false;
+    const int res = hours * 3600 + static_cast<int>(m1 * 10u + m2) * 60;
+    to = std::chrono::seconds{p[0] == '+' ? res : -res};
+    return true;
+}
+
+// YYYY-MM-DD HH:MM:SS[.ffffff], setting p past the parsed characters
+inline bool parse_timestamp(const char*& p, const char* last, std::chrono::microseconds& to)
+{
+    if (last - p < 19 || p[10] != ' ')
+        return false;
+    std::chrono::sys_days date;
+    if (!parse_date(p, date))
+        return false;
+    p += 11;
+    std::chrono::microseconds tod;
+    if (!parse_time(p, last, tod))
+        return false;
+    to = date.time_since_epoch() + tod;
+    return true;
+}
+
+}  // namespace iso
+
 }  // namespace detail
 
 
@@ -298,6 +462,13 @@ template <class T = std::chrono::sys_days>
 std::error_code parse_text_date(std::span<const unsigned char> from, T& to) noexcept
 {
     std::string_view sv{reinterpret_cast<const char*>(from.data()), from.size()};
+    std::chrono::sys_days fast_res;
+    if (sv.size() == 10u && detail::iso::parse_date(sv.data(), fast_res))
+    {
+        to = fast_res;
+        return {};
+    }
+
     if (detail::parse_infinity(sv, to))
         return {};
 
@@ -346,6 +517,14 @@ std::error_code parse_text_time(std::span<const unsigned char> from, T& to) noex
     if (from.empty())
         return client_errc::protocol_value_error;
     std::string_view sv{reinterpret_cast<const char*>(from.data()), from.size()};
+    const char* p = sv.data();
+    std::chrono::microseconds fast_res;
+    if (detail::iso::parse_time(p, sv.data() + sv.size(), fast_res) && p == sv.data() + sv.size())
+    {
+        to = fast_res;
+        return {};
+    }
+
     sv = detail::trim(sv);
     std::size_t pos = 0;
     std::chrono::microseconds out{};
@@ -379,6 +558,16 @@ template <class T = types::pg_timetz>
 std::error_code parse_text_timetz(std::span<const unsigned char> from, T& to) noexcept
 {
     std::string_view sv{reinterpret_cast<const char*>(from.data()), from.size()};
+    const char* p = sv.data();
+    const char* last = sv.data() + sv.size();
+    std::chrono::microseconds fast_tod;
+    std::chrono::seconds fast_offset;
+    if (detail::iso::parse_time(p, last, fast_tod) && detail::iso::parse_offset(p, last, fast_offset))
+    {
+        to = T{fast_tod, fast_offset};
+        return {};
+    }
+
     sv = detail::trim(sv);
     std::size_t pos = 0;
     std::chrono::microseconds time_of_day;
@@ -425,6 +614,14 @@ template <class T = types::pg_timestamp>
 std::error_code parse_text_timestamp(std::span<const unsigned char> from, T& to) noexcept
 {
     std::string_view sv{reinterpret_cast<const char*>(from.data()), from.size()};
+    const char* p = sv.data();
+    std::chrono::microseconds fast_res;
+    if (detail::iso::parse_timestamp(p, sv.data() + sv.size(), fast_res) && p == sv.data() + sv.size())
+    {
+        to = T{fast_res};
+        return {};
+    }
+
     if (detail::parse_infinity(sv, to))
         return {};
 
@@ -496,6 +693,16 @@ template <class T = types::pg_timestamptz>
 std::error_code parse_text_timestamptz(std::span<const unsigned char> from, T& to) noexcept
 {
     std::string_view sv{reinterpret_cast<const char*>(from.data()), from.size()};
+    const char* p = sv.data();
+    const char* last = sv.data() + sv.size();
+    std::chrono::microseconds fast_res;
+    std::chrono::seconds fast_offset;
+    if (detail::iso::parse_timestamp(p, last, fast_res) && detail::iso::parse_offset(p, last, fast_offset))
+    {
+        to = T{fast_res - std::chrono::duration_cast<std::chrono::microseconds>(fast_offset)};
+        return {};
+    }
+
     if (detail::parse_infinity(sv, to))
         return {};
 
@@ -672,6 +879,273 @@ std::error_code parse_binary_interval(
 }
 
 
+namespace detail {
+
+// PostgreSQL's binary date and time representations are relative to 2000-01-01
+inline constexpr std::chrono::sys_days pg_epoch_date{std::chrono::year{2000} / 1 / 1};
+inline constexpr std::int64_t pg_epoch_us = 946684800000000;  // 2000-01-01 since 1970-01-01
+
+// Writes value in decimal, left-padded with zeros to width digits
+inline void append_padded(std::vector<unsigned char>& to, std::int64_t value, int width)
+{
+    char buffer[32];
+    auto res = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    for (auto len = res.ptr - buffer; len < width; ++len)
+        to.push_back('0');
+    to.insert(to.end(), buffer, res.ptr);
+}
+
+inline void append_str(std::vector<unsigned char>& to, std::string_view value)
+{
+    to.insert(to.end(), value.begin(), value.end());
+}
+
+// YYYY-MM-DD, with a BC suffix when required. Years before 1 AD are numbered
+// 0 = 1 BC, -1 = 2 BC... by std::chrono
+inline void append_date(std::vector<unsigned char>& to, std::chrono::sys_days value, bool& bc)
+{
+    const std::chrono::year_month_day ymd{value};
+    int year = static_cast<int>(ymd.year());
+    bc = year <= 0;
+    if (bc)
+        year = 1 - year;
+    append_padded(to, year, 4);
+    to.push_back('-');
+    append_padded(to, static_cast<unsigned>(ymd.month()), 2);
+    to.push_back('-');
+    append_padded(to, static_cast<unsigned>(ymd.day()), 2);
+}
+
+// HH:MM:SS.ffffff. Hours may exceed 24, as required by intervals
+inline void append_time(std::vector<unsigned char>& to, std::chrono::microseconds value)
+{
+    std::int64_t us = value.count();
+    if (us < 0)
+    {
+        to.push_back('-');
+        us = -us;
+    }
+    append_padded(to, us / 3600000000, 2);
+    to.push_back(':');
+    append_padded(to, us / 60000000 % 60, 2);
+    to.push_back(':');
+    append_padded(to, us / 1000000 % 60, 2);
+    to.push_back('.');
+    append_padded(to, us % 1000000, 6);
+}
+
+// +HH:MM[:SS]
+inline void append_utc_offset(std::vector<unsigned char>& to, std::chrono::seconds value)
+{
+    std::int64_t secs = value.count();
+    to.push_back(secs < 0 ? '-' : '+');
+    if (secs < 0)
+        secs = -secs;
+    append_padded(to, secs / 3600, 2);
+    to.push_back(':');
+    append_padded(to, secs / 60 % 60, 2);
+    if (secs % 60 != 0)
+    {
+        to.push_back(':');
+        append_padded(to, secs % 60, 2);
+    }
+}
+
+inline void append_timestamp(std::vector<unsigned char>& to, std::chrono::microseconds since_epoch)
+{
+    const auto days = std::chrono::floor<std::chrono::days>(since_epoch);
+    bool bc = false;
+    append_date(to, std::chrono::sys_days{days}, bc);
+    to.push_back(' ');
+    append_time(to, since_epoch - days);
+    if (bc)
+        append_str(to, " BC");
+}
+
+template <class T>
+void append_be(std::vector<unsigned char>& to, T value)
+{
+    const auto offset = to.size();
+    to.resize(offset + sizeof(T));
+    boost::endian::endian_store<T, sizeof(T), boost::endian::order::big>(to.data() + offset, value);
+}
+
+// Microseconds since 1970 => microseconds since 2000, with infinities mapped
+// to the values the server uses for them
+inline std::error_code to_pg_timestamp(std::int64_t us_since_1970, bool pinf, bool ninf, std::int64_t& to)
+{
+    if (pinf)
+        to = (std::numeric_limits<std::int64_t>::max)();
+    else if (ninf)
+        to = (std::numeric_limits<std::int64_t>::min)();
+    else if (us_since_1970 < (std::numeric_limits<std::int64_t>::min)() + pg_epoch_us)
+        return client_errc::value_too_big;
+    else
+        to = us_since_1970 - pg_epoch_us;
+    return {};
+}
+
+}  // namespace detail
+
+// std::chrono::sys_days => DATE (TEXT)
+inline std::error_code serialize_text_date(pg_date value, std::vector<unsigned char>& to)
+{
+    if (value == pg_date::max())
+        detail::append_str(to, "infinity");
+    else if (value == pg_date::min())
+        detail::append_str(to, "-infinity");
+    else
+    {
+        bool bc = false;
+        detail::append_date(to, value, bc);
+        if (bc)
+            detail::append_str(to, " BC");
+    }
+    return {};
+}
+
+// std::chrono::sys_days => DATE (BINARY). int32 days since 2000-01-01
+inline std::error_code serialize_binary_date(pg_date value, std::vector<unsigned char>& to)
+{
+    std::int32_t days{};
+    if (value == pg_date::max())
+        days = (std::numeric_limits<std::int32_t>::max)();
+    else if (value == pg_date::min())
+        days = (std::numeric_limits<std::int32_t>::min)();
+    else
+    {
+        const auto count = static_cast<std::int64_t>((value - detail::pg_epoch_date).count());
+        if (count <= (std::numeric_limits<std::int32_t>::min)() ||
+            count >= (std::numeric_limits<std::int32_t>::max)())
+            return client_errc::value_too_big;
+        days = static_cast<std::int32_t>(count);
+    }
+    detail::append_be(to, days);
+    return {};
+}
+
+// std::chrono::microseconds => TIME (TEXT)
+inline std::error_code serialize_text_time(pg_time value, std::vector<unsigned char>& to)
+{
+    detail::append_time(to, value);
+    return {};
+}
+
+// std::chrono::microseconds => TIME (BINARY). int64 microseconds since midnight
+inline std::error_code serialize_binary_time(pg_time value, std::vector<unsigned char>& to)
+{
+    detail::append_be<std::int64_t>(to, value.count());
+    return {};
+}
+
+// pg_timetz => TIMETZ (TEXT)
+inline std::error_code serialize_text_timetz(const pg_timetz& value, std::vector<unsigned char>& to)
+{
+    detail::append_time(to, value.time_since_midnight);
+    detail::append_utc_offset(to, value.utc_offset);
+    return {};
+}
+
+// pg_timetz => TIMETZ (BINARY). int64 microseconds since midnight + int32 seconds WEST of UTC
+inline std::error_code serialize_binary_timetz(const pg_timetz& value, std::vector<unsigned char>& to)
+{
+    detail::append_be<std::int64_t>(to, value.time_since_midnight.count());
+    detail::append_be(to, static_cast<std::int32_t>(-value.utc_offset.count()));
+    return {};
+}
+
+// pg_timestamp => TIMESTAMP (TEXT)
+inline std::error_code serialize_text_timestamp(const pg_timestamp& value, std::vector<unsigned char>& to)
+{
+    if (value == pg_timestamp::max())
+        detail::append_str(to, "infinity");
+    else if (value == pg_timestamp::min())
+        detail::append_str(to, "-infinity");
+    else
+        detail::append_timestamp(to, value.time_since_epoch());
+    return {};
+}
+
+// pg_timestamp => TIMESTAMP (BINARY). int64 microseconds since 2000-01-01
+inline std::error_code serialize_binary_timestamp(const pg_timestamp& value, std::vector<unsigned char>& to)
+{
+    std::int64_t us{};
+    auto ec = detail::to_pg_timestamp(
+        value.time_since_epoch().count(),
+        value == pg_timestamp::max(),
+        value == pg_timestamp::min(),
+        us
+    );
+    if (ec)
+        return ec;
+    detail::append_be(to, us);
+    return {};
+}
+
+// pg_timestamptz => TIMESTAMPTZ (TEXT). Always sent in UTC
+inline std::error_code serialize_text_timestamptz(
+    const pg_timestamptz& value,
+    std::vector<unsigned char>& to
+)
+{
+    if (value == pg_timestamptz::max())
+        detail::append_str(to, "infinity");
+    else if (value == pg_timestamptz::min())
+        detail::append_str(to, "-infinity");
+    else
+    {
+        const auto days = std::chrono::floor<std::chrono::days>(value.time_since_epoch());
+        bool bc = false;
+        detail::append_date(to, std::chrono::sys_days{days}, bc);
+        to.push_back(' ');
+        detail::append_time(to, value.time_since_epoch() - days);
+        detail::append_str(to, "+00");
+        if (bc)
+            detail::append_str(to, " BC");
+    }
+    return {};
+}
+
+// pg_timestamptz => TIMESTAMPTZ (BINARY). int64 microseconds since 2000-01-01 UTC
+inline std::error_code serialize_binary_timestamptz(
+    const pg_timestamptz& value,
+    std::vector<unsigned char>& to
+)
+{
+    std::int64_t us{};
+    auto ec = detail::to_pg_timestamp(
+        value.time_since_epoch().count(),
+        value == pg_timestamptz::max(),
+        value == pg_timestamptz::min(),
+        us
+    );
+    if (ec)
+        return ec;
+    detail::append_be(to, us);
+    return {};
+}
+
+// pg_interval => INTERVAL (TEXT). Uses the postgres style, e.g. 1 mons 2 days 03:04:05.000006
+inline std::error_code serialize_text_interval(const pg_interval& value, std::vector<unsigned char>& to)
+{
+    detail::append_padded(to, value.months, 1);
+    detail::append_str(to, " mons ");
+    detail::append_padded(to, value.days, 1);
+    detail::append_str(to, " days ");
+    detail::append_time(to, value.time);
+    return {};
+}
+
+// pg_interval => INTERVAL (BINARY). int64 microseconds + int32 days + int32 months
+inline std::error_code serialize_binary_interval(const pg_interval& value, std::vector<unsigned char>& to)
+{
+    detail::append_be<std::int64_t>(to, value.time.count());
+    detail::append_be<std::int32_t>(to, value.days);
+    detail::append_be<std::int32_t>(to, value.months);
+    return {};
+}
+
+
 }
 
 #endif  // NATIVEPG_TYPES_DATETIME_HPP
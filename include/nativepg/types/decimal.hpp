@@ -44,8 +44,128 @@ namespace nativepg::types {
 
 namespace detail {
 
+// Number of decimal digits required to represent value (0 requires 1 digit)
+inline int count_decimal_digits(std::uint64_t value) noexcept
+{
+    int res = 1;
+    for (; value >= 10u; value /= 10u)
+        ++res;
+    return res;
+}
+
+// Constructs a decimal from a significand and an exponent, if the value is representable exactly
+// (i.e. no rounding or underflow/overflow would happen). Returns false otherwise.
+template <class T>
+bool decimal_from_parts(std::uint64_t significand, int exponent, bool negative, T& to) noexcept
+{
+    if (significand != 0u)
+    {
+        const int num_digits = count_decimal_digits(significand);
+        if (num_digits > std::numeric_limits<T>::digits10 ||
+            exponent < std::numeric_limits<T>::min_exponent10 ||
+            exponent + num_digits - 1 > std::numeric_limits<T>::max_exponent10)
+            return false;
+    }
+
+    T result{significand, exponent};
+    to = negative ? -result : result;
+    return true;
+}
+
+// Fast path for text values with a fixed scale (e.g. -1234.5678), which is what the server sends
+// for numeric columns. Anything else (exponents, NaN, infinities, too many digits) is left
+// to boost::decimal::from_chars. Returns false if the fast path is not applicable.
+template <class T>
+bool parse_text_decimal_fixed(std::string_view sv, T& to) noexcept
+{
+    constexpr std::uint64_t max_significand = (std::numeric_limits<std::uint64_t>::max)();
+
+    const char* p = sv.data();
+    const char* const end = p + sv.size();
+
+    // Sign. A leading '+' is rejected by from_chars, so leave that to the fallback
+    const bool negative = p != end && *p == '-';
+    if (negative)
+        ++p;
+
+    std::uint64_t significand = 0u;
+    int frac_digits = 0;
+    bool has_point = false;
+    bool has_digits = false;
+    for (; p != end; ++p)
+    {
+        const char c = *p;
+        if (c >= '0' && c <= '9')
+        {
+            const auto digit = static_cast<std::uint64_t>(c - '0');
+            if (significand > (max_significand - digit) / 10u)
+                return false;
+            significand = significand * 10u + digit;
+            frac_digits += has_point;
+            has_digits = true;
+        }
+        else if (c == '.' && !has_point)
+        {
+            has_point = true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    if (!has_digits)
+        return false;
+
+    return decimal_from_parts(significand, -frac_digits, negative, to);
 }
 
+// Fast path for binary values. The base-10000 groups are concatenated into an integer significand,
+// with an exponent derived from the weight. This constructs the decimal directly, without
+// any intermediate arithmetic. Requires that the groups fit in 64 bits, that the value is representable
+// exactly in T, and that it has no more fractional digits than dscale (the server never sends
+// such values, but the slow path rounds them). Returns false if the fast path is not applicable.
+template <class T>
+bool parse_binary_decimal_groups(
+    const unsigned char* groups,
+    std::uint16_t ndigits,
+    std::int16_t weight,
+    std::uint16_t dscale,
+    bool negative,
+    T& to
+) noexcept
+{
+    constexpr std::uint64_t max_significand = (std::numeric_limits<std::uint64_t>::max)();
+
+    std::uint64_t significand = 0u;
+    for (std::uint16_t i = 0; i < ndigits; ++i)
+    {
+        const auto group = boost::endian::endian_load<std::uint16_t, 2, boost::endian::order::big>(
+            groups + i * 2u
+        );
+        if (group >= 10000u || significand > (max_significand - group) / 10000u)
+            return false;
+        significand = significand * 10000u + group;
+    }
+
+    // value = significand * 10000^(weight - ndigits + 1)
+    int exponent = 4 * (static_cast<int>(weight) - static_cast<int>(ndigits) + 1);
+
+    // Remove trailing zeros, so that the significand is as short as possible
+    while (significand != 0u && significand % 10u == 0u)
+    {
+        significand /= 10u;
+        ++exponent;
+    }
+
+    if (significand != 0u && -exponent > static_cast<int>(dscale))
+        return false;
+
+    return decimal_from_parts(significand, exponent, negative, to);
+}
+
+}  // namespace detail
+
 template <class T>
     requires std::same_as<T, boost::decimal::decimal32_t> || std::same_as<T, boost::decimal::decimal64_t> ||
              std::same_as<T, boost::decimal::decimal128_t>
@@ -53,6 +173,10 @@ std::error_code parse_text_decimal(const field_view& from, T& to)
 {
     const std::string_view sv = from.data_str();
 
+    // Fixed-scale values that fit in T exactly can skip the generic parser
+    if (detail::parse_text_decimal_fixed(sv, to))
+        return {};
+
     // Note: from_chars is noexcept and parses in place, avoiding the heap allocation that the
     // throwing string constructor would incur on malformed input.
     if (const auto res = boost::decimal::from_chars(sv, to);
@@ -104,6 +228,15 @@ std::error_code parse_binary_decimal(const field_view& from, T& to)
         return client_errc::protocol_value_error;
     }
 
+    // If the value is exactly representable, construct it directly
+    if (sign == 0x0000 || sign == 0x4000)
+    {
+        const bool negative = sign == 0x4000;
+        if (detail::parse_binary_decimal_groups(bytes.data() + 8, ndigits, weight, dscale, negative, to))
+            return {};
+    }
+
+    // Otherwise, accumulate the digits. This is slower and may round at each step
     T result{0};
     const T base_10k{10000};
 
@@ -0,0 +1,401 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_TYPES_FIXED_HPP
+#define NATIVEPG_TYPES_FIXED_HPP
+
+#include <boost/endian/conversion.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/field_view.hpp"
+
+namespace nativepg::types {
+
+// clang-format off
+/*
+ Type mapping
+| Type      | Category | OID  | C++ type             | Storage size |
+|-----------|----------|------|----------------------|--------------|
+| numeric   | numeric  | 1700 | pg_fixed<Scale, Rep> | sizeof(Rep)  |
+| money     | numeric  | 790  | pg_fixed<Scale, Rep> | sizeof(Rep)  |
+*/
+// clang-format on
+
+// The integer types that may be used as the representation of a pg_fixed.
+// Any signed integer of at least 32 bits works, including 128-bit integers
+// on compilers that provide them.
+template <class T>
+concept fixed_point_rep = std::numeric_limits<T>::is_specialized && std::numeric_limits<T>::is_integer &&
+                          std::numeric_limits<T>::is_signed && std::numeric_limits<T>::digits >= 31;
+
+// A fixed-point decimal number with Scale fractional digits, stored as a scaled integer.
+// For instance, pg_fixed<4>{123456} represents 12.3456.
+// Suitable for numeric(P, S) columns with a small enough precision (e.g. numeric(18, 4) fits
+// into the default 64-bit representation), and for money. Unlike arbitrary precision types,
+// parsing and serializing these never allocates.
+template <unsigned Scale, fixed_point_rep Rep = std::int64_t>
+struct pg_fixed
+{
+    static_assert(Scale <= static_cast<unsigned>(std::numeric_limits<Rep>::digits10), "Scale is too big");
+
+    using rep = Rep;
+    static constexpr unsigned scale = Scale;
+
+    // The number, multiplied by 10^Scale
+    Rep value{};
+
+    friend constexpr bool operator==(const pg_fixed&, const pg_fixed&) noexcept = default;
+};
+
+namespace detail {
+
+// 10^exp. Returns false on overflow
+template <class Rep>
+constexpr bool fixed_pow10(unsigned exp, Rep& to) noexcept
+{
+    Rep res = 1;
+    for (unsigned i = 0; i < exp; ++i)
+    {
+        if (res > (std::numeric_limits<Rep>::max)() / 10)
+            return false;
+        res *= 10;
+    }
+    to = res;
+    return true;
+}
+
+// acc = acc * mul - sub, where acc <= 0, mul > 0 and sub >= 0. Values are accumulated
+// as negative numbers, so the minimum value of Rep can be represented. Returns false on overflow
+template <class Rep>
+constexpr bool fixed_mul_sub(Rep& acc, Rep mul, Rep sub) noexcept
+{
+    constexpr Rep min_value = (std::numeric_limits<Rep>::min)();
+    if (acc < (min_value + sub) / mul)
+        return false;
+    acc = acc * mul - sub;
+    return true;
+}
+
+// Transforms a value accumulated by fixed_mul_sub into the final one
+template <class Rep>
+constexpr bool fixed_apply_sign(Rep acc, bool negative, Rep& to) noexcept
+{
+    if (negative)
+    {
+        to = acc;
+        return true;
+    }
+    if (acc == (std::numeric_limits<Rep>::min)())
+        return false;
+    to = -acc;
+    return true;
+}
+
+// The absolute value of value % mod, valid for negative values, too
+template <class Rep>
+constexpr unsigned fixed_abs_rem(Rep value, Rep mod) noexcept
+{
+    const Rep res = value % mod;
+    return static_cast<unsigned>(res < 0 ? -res : res);
+}
+
+// Parses a decimal number with an optional sign and fractional part.
+// money values are formatted according to lc_monetary (e.g. $1,234.56 or -$1,234.56):
+// currency symbols, group separators and blanks are skipped, and parentheses are
+// interpreted as negative numbers. The decimal point is assumed to be '.'
+template <unsigned Scale, class Rep>
+std::error_code parse_text_fixed_impl(std::string_view sv, bool is_money, Rep& to) noexcept
+{
+    Rep acc = 0;
+    bool negative = false;
+    bool has_point = false;
+    bool has_digits = false;
+    unsigned frac_digits = 0;
+
+    for (std::size_t i = 0; i < sv.size(); ++i)
+    {
+        const char c = sv[i];
+        if (c >= '0' && c <= '9')
+        {
+            const Rep digit = c - '0';
+            has_digits = true;
+            if (frac_digits == Scale && has_point)
+            {
+                // Digits beyond our scale may only be zeros
+                if (digit != 0)
+                    return client_errc::incompatible_response_length;
+                continue;
+            }
+            if (!fixed_mul_sub(acc, Rep(10), digit))
+                return client_errc::value_out_of_range;
+            frac_digits += has_point ? 1u : 0u;
+        }
+        else if (c == '.' && !has_point)
+        {
+            has_point = true;
+        }
+        else if (c == '-' && !has_digits && !negative && (is_money || i == 0u))
+        {
+            negative = true;
+        }
+        else if (is_money && c == '(' && !has_digits && !negative)
+        {
+            negative = true;
+        }
+        else if (!is_money)
+        {
+            // NaN and infinities are valid numeric values, but can't be represented
+            if (sv == "NaN" || sv == "Infinity" || sv == "-Infinity")
+                return client_errc::value_out_of_range;
+            return client_errc::protocol_value_error;
+        }
+    }
+
+    if (!has_digits)
+        return client_errc::protocol_value_error;
+
+    // Pad the fractional digits up to our scale
+    Rep multiplier{};
+    if (!fixed_pow10(Scale - frac_digits, multiplier) || !fixed_mul_sub(acc, multiplier, Rep(0)) ||
+        !fixed_apply_sign(acc, negative, to))
+        return client_errc::value_out_of_range;
+
+    return {};
+}
+
+}  // namespace detail
+
+// NUMERIC => pg_fixed (TEXT)
+template <unsigned Scale, class Rep>
+std::error_code parse_text_fixed(const field_view& from, pg_fixed<Scale, Rep>& to) noexcept
+{
+    return detail::parse_text_fixed_impl<Scale>(from.data_str(), false, to.value);
+}
+
+// NUMERIC => pg_fixed (BINARY)
+// The base-10000 digit groups are accumulated directly into the scaled integer.
+// Digits beyond Scale must be zero, and the result must fit in Rep.
+template <unsigned Scale, class Rep>
+std::error_code parse_binary_fixed(const field_view& from, pg_fixed<Scale, Rep>& to) noexcept
+{
+    const auto bytes = from.data();
+    if (bytes.size() < 8u)
+        return client_errc::protocol_value_error;
+
+    const auto ndigits = boost::endian::endian_load<std::uint16_t, 2, boost::endian::order::big>(
+        bytes.data()
+    );
+    const auto weight = boost::endian::endian_load<std::int16_t, 2, boost::endian::order::big>(
+        bytes.data() + 2
+    );
+    const auto sign = boost::endian::endian_load<std::uint16_t, 2, boost::endian::order::big>(
+        bytes.data() + 4
+    );
+
+    // NaN and infinities can't be represented
+    if (sign == 0xC000 || sign == 0xD000 || sign == 0xF000)
+        return client_errc::value_out_of_range;
+    if (sign != 0x0000 && sign != 0x4000)
+        return client_errc::protocol_value_error;
+
+    if (bytes.size() != 8u + ndigits * 2u)
+        return client_errc::protocol_value_error;
+
+    Rep acc = 0;
+    int acc_exp = 0;  // acc must be multiplied by 10^acc_exp to obtain the scaled value
+    for (std::uint16_t i = 0; i < ndigits; ++i)
+    {
+        const auto group = boost::endian::endian_load<std::uint16_t, 2, boost::endian::order::big>(
+            bytes.data() + 8u + i * 2u
+        );
+        if (group >= 10000u)
+            return client_errc::protocol_value_error;
+
+        // The exponent of this group's units, once scaled
+        const int exp = 4 * (weight - i) + static_cast<int>(Scale);
+
+        if (exp >= 0)
+        {
+            // The group is entirely within our precision
+            if (!detail::fixed_mul_sub(acc, Rep(10000), Rep(group)))
+                return client_errc::value_out_of_range;
+            acc_exp = exp;
+        }
+        else if (exp > -4)
+        {
+            // The group contains our least significant digits. Digits beyond our scale may only be zeros
+            Rep divisor{}, multiplier{};
+            detail::fixed_pow10(static_cast<unsigned>(-exp), divisor);
+            detail::fixed_pow10(static_cast<unsigned>(4 + exp), multiplier);
+            if (group % divisor != 0)
+                return client_errc::incompatible_response_length;
+            if (!detail::fixed_mul_sub(acc, multiplier, Rep(group / divisor)))
+                return client_errc::value_out_of_range;
+            acc_exp = 0;
+        }
+        else if (group != 0u)
+        {
+            // The group is entirely beyond our scale
+            return client_errc::incompatible_response_length;
+        }
+    }
+
+    // Adjust the accumulated value if the last groups were omitted because they were zero
+    Rep multiplier{};
+    if (acc != 0 && (!detail::fixed_pow10(static_cast<unsigned>(acc_exp), multiplier) ||
+                     !detail::fixed_mul_sub(acc, multiplier, Rep(0))))
+        return client_errc::value_out_of_range;
+
+    if (!detail::fixed_apply_sign(acc, sign == 0x4000, to.value))
+        return client_errc::value_out_of_range;
+
+    return {};
+}
+
+// MONEY => pg_fixed (TEXT)
+template <unsigned Scale, class Rep>
+std::error_code parse_text_money(const field_view& from, pg_fixed<Scale, Rep>& to) noexcept
+{
+    return detail::parse_text_fixed_impl<Scale>(from.data_str(), true, to.value);
+}
+
+// MONEY => pg_fixed (BINARY)
+// The server sends an int64 with the amount in the currency's smallest unit.
+// This assumes two fractional digits, which is what most lc_monetary settings use.
+template <unsigned Scale, class Rep>
+std::error_code parse_binary_money(const field_view& from, pg_fixed<Scale, Rep>& to) noexcept
+{
+    constexpr unsigned money_scale = 2u;
+
+    if (from.data().size() != 8u)
+        return client_errc::protocol_value_error;
+    const auto value = boost::endian::endian_load<std::int64_t, 8, boost::endian::order::big>(
+        from.data().data()
+    );
+
+    // Make sure that the value fits in Rep
+    if (value < (std::numeric_limits<Rep>::min)() || value > (std::numeric_limits<Rep>::max)())
+        return client_errc::value_out_of_range;
+    const auto rep_value = static_cast<Rep>(value);
+
+    if constexpr (Scale >= money_scale)
+    {
+        Rep multiplier{};
+        if (!detail::fixed_pow10(Scale - money_scale, multiplier))
+            return client_errc::value_out_of_range;
+        if (rep_value > (std::numeric_limits<Rep>::max)() / multiplier ||
+            rep_value < (std::numeric_limits<Rep>::min)() / multiplier)
+            return client_errc::value_out_of_range;
+        to.value = rep_value * multiplier;
+    }
+    else
+    {
+        Rep divisor{};
+        detail::fixed_pow10(money_scale - Scale, divisor);
+        if (rep_value % divisor != 0)
+            return client_errc::incompatible_response_length;
+        to.value = rep_value / divisor;
+    }
+
+    return {};
+}
+
+// pg_fixed => NUMERIC (TEXT)
+template <unsigned Scale, class Rep>
+std::error_code serialize_text_fixed(const pg_fixed<Scale, Rep>& value, std::vector<unsigned char>& to)
+{
+    // Decimal digits, least significant first, followed by the sign
+    constexpr std::size_t max_size = static_cast<std::size_t>(std::numeric_limits<Rep>::digits10) + 4u;
+    std::array<unsigned char, max_size> buff;
+    std::size_t size = 0u;
+
+    // Extracting digits from the signed value works for the minimum value, too
+    Rep v = value.value;
+    for (unsigned i = 0; v != 0 || i <= Scale; ++i)
+    {
+        if (i == Scale && Scale != 0u)
+            buff[size++] = '.';
+        buff[size++] = static_cast<unsigned char>('0' + detail::fixed_abs_rem(v, Rep(10)));
+        v /= 10;
+    }
+    if (value.value < 0)
+        buff[size++] = '-';
+
+    to.insert(to.end(), buff.rbegin() + static_cast<std::ptrdiff_t>(max_size - size), buff.rend());
+    return {};
+}
+
+// pg_fixed => NUMERIC (BINARY)
+template <unsigned Scale, class Rep>
+std::error_code serialize_binary_fixed(const pg_fixed<Scale, Rep>& value, std::vector<unsigned char>& to)
+{
+    // Fractional digits are padded with zeros so they fill entire base-10000 groups
+    constexpr unsigned pad = (4u - Scale % 4u) % 4u;
+    constexpr int frac_groups = static_cast<int>((Scale + pad) / 4u);
+    constexpr std::size_t max_groups = (static_cast<std::size_t>(std::numeric_limits<Rep>::digits10) + 8u) /
+                                       4u;
+
+    // Compute the groups, least significant first
+    std::array<std::uint16_t, max_groups> groups;
+    std::size_t num_groups = 0u;
+    Rep v = value.value;
+    if (v != 0)
+    {
+        // The first group holds the least significant (4 - pad) digits, shifted by pad
+        Rep first_mod{}, first_mul{};
+        detail::fixed_pow10(4u - pad, first_mod);
+        detail::fixed_pow10(pad, first_mul);
+        groups[num_groups++] = static_cast<std::uint16_t>(
+            detail::fixed_abs_rem(v, first_mod) * static_cast<unsigned>(first_mul)
+        );
+        v /= first_mod;
+        while (v != 0)
+        {
+            groups[num_groups++] = static_cast<std::uint16_t>(detail::fixed_abs_rem(v, Rep(10000)));
+            v /= 10000;
+        }
+    }
+
+    // Trailing zero groups are omitted
+    std::size_t first_group = 0u;
+    while (first_group < num_groups && groups[first_group] == 0u)
+        ++first_group;
+
+    const auto ndigits = static_cast<std::int16_t>(num_groups - first_group);
+    const auto weight = static_cast<std::int16_t>(
+        num_groups == 0u ? 0 : static_cast<int>(num_groups) - 1 - frac_groups
+    );
+    const std::uint16_t sign = value.value < 0 ? 0x4000 : 0x0000;
+
+    // Header
+    const auto offset = to.size();
+    to.resize(offset + 8u + static_cast<std::size_t>(ndigits) * 2u);
+    unsigned char* ptr = to.data() + offset;
+    boost::endian::endian_store<std::int16_t, 2, boost::endian::order::big>(ptr, ndigits);
+    boost::endian::endian_store<std::int16_t, 2, boost::endian::order::big>(ptr + 2, weight);
+    boost::endian::endian_store<std::uint16_t, 2, boost::endian::order::big>(ptr + 4, sign);
+    boost::endian::endian_store<std::uint16_t, 2, boost::endian::order::big>(ptr + 6, Scale);
+    ptr += 8;
+
+    // Groups, most significant first
+    for (std::size_t i = num_groups; i > first_group; --i, ptr += 2)
+        boost::endian::endian_store<std::uint16_t, 2, boost::endian::order::big>(ptr, groups[i - 1u]);
+
+    return {};
+}
+
+}  // namespace nativepg::types
+
+#endif  // NATIVEPG_TYPES_FIXED_HPP
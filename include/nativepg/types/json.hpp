@@ -9,23 +9,125 @@
 #define NATIVEPG_TYPES_JSON_HPP
 
 #include <boost/json/parse.hpp>
+#include <boost/json/parse_into.hpp>
+#include <boost/json/parser.hpp>
+#include <boost/json/serializer.hpp>
+#include <boost/json/storage_ptr.hpp>
 #include <boost/json/value.hpp>
+#include <boost/system/error_code.hpp>
 #include <system_error>
 
+#include <cstddef>
+#include <memory>
+#include <optional>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "nativepg/client_errc.hpp"
+#include "nativepg/detail/row_traits.hpp"
 #include "nativepg/field_view.hpp"
 
 namespace nativepg::types {
 
+// Wraps a type to be parsed from or serialized to JSON(B) directly, without building
+// a boost::json::value first. T must be supported by boost::json::parse_into
+// and boost::json::serializer (e.g. a Boost.Describe-annotated struct, a container or a scalar).
+template <class T>
+struct json_as
+{
+    T value{};
+
+    bool operator==(const json_as&) const = default;
+};
+
+// Already serialized JSON text, to be sent as a JSON parameter.
+// It's copied into the request as-is, without being parsed or validated.
+struct json_text
+{
+    std::string_view value;
+};
+
+// Row initializer for into() and resultset_callback(). Makes the boost::json::value
+// and std::optional<boost::json::value> members of each row use storage, so they're parsed into it. With a boost::json::monotonic_resource
+// shared by all the rows in a resultset, parsing JSON doesn't allocate from the heap for every field.
+// The resource must outlive the rows.
+struct json_storage
+{
+    boost::json::storage_ptr storage;
+
+    template <class Row>
+    void operator()(Row& row) const
+    {
+        nativepg::detail::for_each_member(row, [this](auto& member) {
+            // Assigning a value doesn't change its memory resource, so re-create it.
+            // Optionals are engaged, and reset if the field is NULL
+            using member_type = std::remove_cvref_t<decltype(member)>;
+            if constexpr (std::is_same_v<member_type, boost::json::value>)
+            {
+                std::destroy_at(&member);
+                std::construct_at(&member, storage);
+            }
+            else if constexpr (std::is_same_v<member_type, std::optional<boost::json::value>>)
+            {
+                member.emplace(storage);
+            }
+        });
+    }
+};
+
+namespace detail {
+
+// Size of the stack buffer used by the parser and the serializer. Documents that
+// don't nest too deeply don't require them to allocate
+inline constexpr std::size_t json_stack_buffer_size = 512u;
+
+// Minimum number of bytes to make available to the serializer in each step
+inline constexpr std::size_t json_serialize_chunk_size = 256u;
+
+// Serializes value directly into the end of to, without intermediate strings
+template <class T>
+void serialize_json_impl(const T& value, std::vector<unsigned char>& to)
+{
+    unsigned char temp[json_stack_buffer_size];
+    boost::json::serializer sr(boost::json::storage_ptr(), temp, sizeof(temp));
+    sr.reset(&value);
+    while (!sr.done())
+    {
+        // Grow in bounded steps. Resizing to the whole capacity would zero-fill it every time,
+        // and to is usually a request buffer with lots of spare capacity
+        const std::size_t offset = to.size();
+        to.resize(offset + json_serialize_chunk_size);
+        auto written = sr.read(reinterpret_cast<char*>(to.data() + offset), to.size() - offset);
+        to.resize(offset + written.size());
+    }
+}
+
+inline std::string_view jsonb_payload(const field_view& from)
+{
+    const auto bytes = from.data();
+    return {reinterpret_cast<const char*>(bytes.data() + 1), bytes.size() - 1};
+}
+
+}  // namespace detail
+
+// The resulting value uses the memory resource of to. Construct it with an arena
+// (e.g. a boost::json::monotonic_resource shared by all the rows in a resultset)
+// to avoid allocating from the heap for every field.
 inline std::error_code parse_json(const std::string_view& json_text, boost::json::value& to)
 {
     if (json_text.empty())
         return {};
+    unsigned char temp[detail::json_stack_buffer_size];
+    boost::json::parser p(boost::json::storage_ptr(), boost::json::parse_options(), temp, sizeof(temp));
+    p.reset(to.storage());
     std::error_code ec{};
-    to = boost::json::parse(json_text, ec);
-    return ec;
+    p.write(json_text, ec);
+    if (ec)
+        return ec;
+    to = p.release();
+    return {};
 }
 
 // JSONB => boost::json::value (BINARY)
@@ -35,13 +137,71 @@ inline std::error_code parse_binary_jsonb(const field_view& from, boost::json::v
     const auto bytes = from.data();
     if (bytes.empty() || bytes[0] != 1)
         return client_errc::protocol_value_error;
-    return parse_json(std::string_view{reinterpret_cast<const char*>(bytes.data() + 1), bytes.size() - 1}, to);
+    return parse_json(detail::jsonb_payload(from), to);
+}
+
+// JSON(B) => T, skipping the DOM
+template <class T>
+std::error_code parse_json(const std::string_view& json_text, json_as<T>& to)
+{
+    if (json_text.empty())
+        return {};
+    boost::system::error_code ec;
+    boost::json::parse_into(to.value, json_text, ec);
+    return ec;
+}
+
+template <class T>
+std::error_code parse_binary_jsonb(const field_view& from, json_as<T>& to)
+{
+    const auto bytes = from.data();
+    if (bytes.empty() || bytes[0] != 1)
+        return client_errc::protocol_value_error;
+    return parse_json(detail::jsonb_payload(from), to);
+}
+
+// boost::json::value => JSON(B) (TEXT). Both json and jsonb use plain JSON
+inline std::error_code serialize_text_json(const boost::json::value& value, std::vector<unsigned char>& to)
+{
+    detail::serialize_json_impl(value, to);
+    return {};
+}
+
+// boost::json::value => JSONB (BINARY). A version byte followed by the JSON text
+inline std::error_code serialize_binary_jsonb(const boost::json::value& value, std::vector<unsigned char>& to)
+{
+    to.push_back(1u);
+    detail::serialize_json_impl(value, to);
+    return {};
+}
+
+// T => JSON(B), skipping the DOM
+template <class T>
+std::error_code serialize_text_json(const json_as<T>& value, std::vector<unsigned char>& to)
+{
+    detail::serialize_json_impl(value.value, to);
+    return {};
+}
+
+template <class T>
+std::error_code serialize_binary_jsonb(const json_as<T>& value, std::vector<unsigned char>& to)
+{
+    to.push_back(1u);
+    detail::serialize_json_impl(value.value, to);
+    return {};
+}
+
+// Pre-serialized JSON => JSON (TEXT and BINARY, which are the same)
+inline std::error_code serialize_text_json(json_text value, std::vector<unsigned char>& to)
+{
+    to.insert(to.end(), value.value.begin(), value.value.end());
+    return {};
 }
 
 }  // namespace nativepg::types
 
-// Registers parse_field_traits<T> specializations for boost::json::value. Included here (rather than
-// force-included by field_traits.hpp) so that only TUs opting into this header pay for it.
+// Registers field traits specializations for boost::json::value, json_as<T> and json_text. Included here
+// (rather than force-included by field_traits.hpp) so that only TUs opting into this header pay for it.
 #include "nativepg/detail/field_traits_json.hpp"
 
 #endif  // NATIVEPG_TYPES_JSON_HPP
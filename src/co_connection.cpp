@@ -10,14 +10,22 @@
 #include <boost/capy/buffers/make_buffer.hpp>
 #include <boost/capy/ex/execution_context.hpp>
 #include <boost/capy/io_task.hpp>
+#include <boost/capy/when_any.hpp>
 #include <boost/capy/write.hpp>
 #include <boost/corosio/connect.hpp>
 #include <boost/corosio/resolver.hpp>
 #include <boost/corosio/tcp_socket.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
 #include <vector>
 
 #include "nativepg/co_connection.hpp"
@@ -25,11 +33,16 @@
 #include "nativepg/extended_error.hpp"
 #include "nativepg/protocol/connection_state.hpp"
 #include "nativepg/protocol/detail/connect_fsm.hpp"
+#include "nativepg/protocol/detail/copy_in_buffer.hpp"
 #include "nativepg/protocol/detail/exec_fsm.hpp"
 #include "nativepg/protocol/detail/exec_some_fsm.hpp"
 #include "nativepg/protocol/parse_message.hpp"
 #include "nativepg/request.hpp"
 #include "nativepg/responses/response_handler.hpp"
+#include "nativepg/type_registry.hpp"
+#include "nativepg_internal/copy_file_sender.hpp"
+#include "nativepg_internal/copy_out_queue.hpp"
+#include "nativepg_internal/type_resolution.hpp"
 
 namespace capy = boost::capy;
 namespace corosio = boost::corosio;
@@ -43,7 +56,9 @@ struct co_connection::impl
     protocol::connection_state st{};
     capy::any_stream stream{&sock};
     std::vector<capy::const_buffer> copy_out_buffers;
+    std::vector<capy::const_buffer> write_buffers;
     std::optional<protocol::detail::exec_some_fsm> exec_some_fsm;
+    protocol::detail::copy_in_buffer copy_in;
 
     explicit impl(capy::execution_context& ctx) : resolv(ctx), sock(ctx) {}
 
@@ -63,6 +78,211 @@ struct co_connection::impl
         exec_some_fsm.emplace(&req, handler);
     }
 
+    // Writes a request's payload. Requests with borrowed parameters are written
+    // using vectored I/O, to avoid copying them.
+    capy::io_task<> write_request(const request& req)
+    {
+        if (!req.has_borrowed_data())
+        {
+            auto [ec, bytes] = co_await capy::write(stream, capy::make_buffer(req.payload()));
+            co_return {ec};
+        }
+
+        write_buffers.clear();
+        req.for_each_payload_segment([this](std::span<const unsigned char> seg) {
+            write_buffers.push_back(capy::make_buffer(seg));
+        });
+        auto [ec, bytes] = co_await capy::write(stream, write_buffers);
+        co_return {ec};
+    }
+
+    // Writes a message built by copy_in, and clears it
+    capy::io_task<> write_copy_in(std::span<const unsigned char> msg)
+    {
+        auto [ec, bytes] = co_await capy::write(stream, capy::make_buffer(msg));
+        copy_in.clear();
+        co_return {ec};
+    }
+
+    capy::io_task<> write_copy_data(std::span<const unsigned char> data)
+    {
+        BOOST_ASSERT(exec_some_fsm.has_value());
+
+        // Small chunks are coalesced
+        if (!copy_in.is_big(data.size()))
+        {
+            if (copy_in.append(data))
+                co_return co_await write_copy_in(copy_in.flush());
+            co_return {};
+        }
+
+        // Big ones are sent directly, after any pending data
+        if (!copy_in.empty())
+        {
+            auto [ec] = co_await write_copy_in(copy_in.flush());
+            if (ec)
+                co_return {ec};
+        }
+        while (!data.empty())
+        {
+            auto chunk = data.first((std::min)(data.size(), protocol::detail::copy_data_max_size));
+            auto header = protocol::detail::copy_data_header(chunk.size());
+            std::array<capy::const_buffer, 2u> buffs{
+                capy::make_buffer(std::span<const unsigned char>(header)),
+                capy::make_buffer(chunk),
+            };
+            auto [ec, bytes] = co_await capy::write(stream, buffs);
+            if (ec)
+                co_return {ec};
+            data = data.subspan(chunk.size());
+        }
+        co_return {};
+    }
+
+    capy::io_task<> write_copy_message(std::span<const unsigned char> msg)
+    {
+        BOOST_ASSERT(exec_some_fsm.has_value());
+        BOOST_ASSERT(msg.size() <= protocol::detail::copy_data_max_size);
+
+        // Any pending data goes first, in the same write
+        auto header = protocol::detail::copy_data_header(msg.size());
+        std::array<capy::const_buffer, 3u> buffs{
+            capy::make_buffer(copy_in.empty() ? std::span<const unsigned char>() : copy_in.flush()),
+            capy::make_buffer(std::span<const unsigned char>(header)),
+            capy::make_buffer(msg),
+        };
+        auto [ec, bytes] = co_await capy::write(stream, buffs);
+        copy_in.clear();
+        co_return {ec};
+    }
+
+    capy::io_task<> copy_from_file(int fd, std::size_t chunk_size)
+    {
+        BOOST_ASSERT(exec_some_fsm.has_value());
+#ifdef NATIVEPG_HAS_COPY_FROM_FILE
+        // Send anything written by write_copy_data first
+        if (!copy_in.empty())
+        {
+            if (auto [ec] = co_await write_copy_in(copy_in.flush()); ec)
+                co_return {ec};
+        }
+
+        detail::copy_file_sender sender{fd, chunk_size, copy_in};
+        while (true)
+        {
+            auto res = sender.next(sock.native_handle());
+            if (res.type == detail::copy_file_sender::result_type::done)
+            {
+                if (res.data.empty())
+                    co_return {res.ec};
+                auto [ec] = co_await write_copy_in(res.data);
+                co_return {ec ? ec : res.ec};
+            }
+            auto [ec, bytes] = co_await capy::write(stream, capy::make_buffer(res.data));
+            if (ec)
+                co_return {ec};
+        }
+#else
+        static_cast<void>(fd);
+        static_cast<void>(chunk_size);
+        co_return {std::make_error_code(std::errc::function_not_supported)};
+#endif
+    }
+
+    // copy_out_to tasks. Like the multiplexed connection tasks, they don't return
+    // an error code, so when_any finishes when either of them returns
+    capy::io_task<> copy_out_reader(detail::copy_out_queue& queue, std::error_code& out_ec)
+    {
+        while (true)
+        {
+            auto [ec, res] = co_await exec_some();
+            if (ec)
+            {
+                out_ec = ec;
+                co_return {};
+            }
+
+            switch (res.type())
+            {
+                case exec_some_result::kind::copy_out_data:
+                {
+                    for (auto buff : res.get_copy_out_data())
+                    {
+                        std::span<const unsigned char> data{
+                            static_cast<const unsigned char*>(buff.data()),
+                            buff.size()
+                        };
+                        if (auto [ec2] = co_await queue.append(data); ec2)
+                            co_return {};
+                    }
+                    queue.flush_if_idle();
+                    break;
+                }
+                case exec_some_result::kind::copy_in:
+                {
+                    auto msg = copy_in.fail("COPY FROM STDIN is not supported by copy_out_to");
+                    if (auto [ec2] = co_await write_copy_in(msg); ec2)
+                    {
+                        out_ec = ec2;
+                        co_return {};
+                    }
+                    break;
+                }
+                case exec_some_result::kind::done:
+                {
+                    // Let the writer finish
+                    queue.finish();
+                    [[maybe_unused]] auto [ec2] = co_await queue.wait_drained();
+                    co_return {};
+                }
+                default: break;
+            }
+        }
+    }
+
+    capy::io_task<> copy_out_writer(
+        capy::any_stream& sink,
+        detail::copy_out_queue& queue,
+        std::error_code& out_ec
+    )
+    {
+        std::vector<capy::const_buffer> buffs;
+        while (true)
+        {
+            if (auto [ec] = co_await queue.wait_data(); ec)
+                co_return {};
+
+            // Write all the buffers that are ready at once
+            buffs.clear();
+            for (const auto& buff : queue.start_write())
+                buffs.push_back(capy::make_buffer(std::span<const unsigned char>(buff)));
+            if (!buffs.empty())
+            {
+                auto [ec, bytes] = co_await capy::write(sink, buffs);
+                if (ec)
+                {
+                    out_ec = ec;
+                    co_return {};
+                }
+            }
+            queue.end_write();
+
+            if (queue.drained())
+                co_return {};
+        }
+    }
+
+    capy::io_task<> copy_out_to(capy::any_stream& sink, copy_out_options opts)
+    {
+        detail::copy_out_queue queue{opts.max_buffers, opts.buffer_size};
+        std::error_code read_ec, write_ec;
+        [[maybe_unused]] auto res = co_await capy::when_any(
+            copy_out_reader(queue, read_ec),
+            copy_out_writer(sink, queue, write_ec)
+        );
+        co_return {read_ec ? read_ec : write_ec};
+    }
+
     capy::io_task<> read_some_messages()
     {
         while (true)
@@ -100,10 +320,7 @@ struct co_connection::impl
             {
                 case protocol::detail::exec_some_fsm::result_type::write:
                 {
-                    auto [ec, bytes] = co_await capy::write(
-                        stream,
-                        capy::make_buffer(fsm.get_request().payload())
-                    );
+                    auto [ec] = co_await write_request(fsm.get_request());
                     if (ec)
                         co_return {ec, {}};
                     break;
@@ -119,6 +336,16 @@ struct co_connection::impl
                 {
                     co_return {{}, exec_some_result{act.get_copy_out()}};
                 }
+                case protocol::detail::exec_some_fsm::result_type::copy_in:
+                {
+                    copy_in.clear();
+                    co_return {{}, exec_some_result{act.get_copy_in()}};
+                }
+                case protocol::detail::exec_some_fsm::result_type::copy_both:
+                {
+                    copy_in.clear();
+                    co_return {{}, exec_some_result{act.get_copy_both()}};
+                }
                 case protocol::detail::exec_some_fsm::result_type::copy_data:
                 {
                     co_return {
@@ -192,7 +419,14 @@ capy::io_task<> co_connection::connect(connect_params params, diagnostics* diag)
             {
                 if (diag)
                     *diag = impl_->st.shared_diag;
-                co_return {res.error()};
+                if (res.error())
+                    co_return {res.error()};
+
+                // Replication connections only accept simple queries,
+                // but type resolution uses the extended protocol
+                if (!params.replication.empty())
+                    co_return {};
+                co_return co_await resolve_types(diag);
             }
             default: BOOST_ASSERT(false); co_return {};
         }
@@ -213,6 +447,12 @@ capy::io_task<> co_connection::exec(const request& req, response_handler_ref han
         {
             case protocol::startup_fsm::result_type::write:
             {
+                if (req.has_borrowed_data())
+                {
+                    auto [ec] = co_await impl_->write_request(req);
+                    res = fsm_.resume(impl_->st, ec, 0u);
+                    break;
+                }
                 auto [ec, bytes] = co_await capy::write(impl_->sock, capy::make_buffer(res.write_data()));
                 res = fsm_.resume(impl_->st, ec, bytes);
                 break;
@@ -235,6 +475,26 @@ capy::io_task<> co_connection::exec(const request& req, response_handler_ref han
     }
 }
 
+void co_connection::set_type_registry(std::shared_ptr<type_registry> types)
+{
+    impl_->st.types = std::move(types);
+}
+
+capy::io_task<> co_connection::resolve_types(diagnostics* diag)
+{
+    if (!impl_->st.types)
+        co_return {};
+
+    detail::type_resolution resolution{*impl_->st.types};
+    if (resolution.empty())
+        co_return {};
+
+    auto [ec] = co_await exec(resolution.get_request(), resolution.handler(), diag);
+    if (!ec)
+        resolution.on_success();
+    co_return {ec};
+}
+
 void co_connection::setup_request(const request& req, response_handler_ref handler)
 {
     return impl_->setup_request(req, handler);
@@ -242,6 +502,42 @@ void co_connection::setup_request(const request& req, response_handler_ref handl
 
 capy::io_task<exec_some_result> co_connection::exec_some() { return impl_->exec_some(); }
 
+capy::io_task<> co_connection::write_copy_data(std::span<const unsigned char> data)
+{
+    return impl_->write_copy_data(data);
+}
+
+capy::io_task<> co_connection::write_copy_message(std::span<const unsigned char> msg)
+{
+    return impl_->write_copy_message(msg);
+}
+
+capy::io_task<> co_connection::finish_copy_in()
+{
+    BOOST_ASSERT(impl_->exec_some_fsm.has_value());
+    return impl_->write_copy_in(impl_->copy_in.finish());
+}
+
+capy::io_task<> co_connection::abort_copy_in(std::string_view reason)
+{
+    BOOST_ASSERT(impl_->exec_some_fsm.has_value());
+    return impl_->write_copy_in(impl_->copy_in.fail(reason));
+}
+
+std::size_t co_connection::copy_in_flush_size() const { return impl_->copy_in.flush_size(); }
+
+void co_connection::set_copy_in_flush_size(std::size_t value) { impl_->copy_in.set_flush_size(value); }
+
+capy::io_task<> co_connection::copy_from_file(int fd, std::size_t chunk_size)
+{
+    return impl_->copy_from_file(fd, chunk_size);
+}
+
+capy::io_task<> co_connection::copy_out_to(capy::any_stream& sink, copy_out_options opts)
+{
+    return impl_->copy_out_to(sink, opts);
+}
+
 capy::io_task<> co_connection::read_some_messages() { return impl_->read_some_messages(); }
 
 capy::any_stream& co_connection::stream() { return impl_->stream; }
@@ -5,17 +5,32 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 //
 
+#include <boost/assert.hpp>
 #include <boost/capy/buffers/make_buffer.hpp>
 #include <boost/capy/cond.hpp>
 #include <boost/capy/delay.hpp>
 #include <boost/capy/error.hpp>
 #include <boost/capy/ex/async_event.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/ex/executor_ref.hpp>
+#include <boost/capy/ex/run.hpp>
+#include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/ex/this_coro.hpp>
+#include <boost/capy/io_result.hpp>
 #include <boost/capy/io_task.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/timeout.hpp>
 #include <boost/capy/when_any.hpp>
 #include <boost/capy/write.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <stop_token>
+#include <string_view>
 #include <system_error>
 #include <utility>
 
@@ -25,33 +40,153 @@
 #include "nativepg/protocol/any_backend_message.hpp"
 #include "nativepg/protocol/parse_message.hpp"
 #include "nativepg_internal/check_request.hpp"
+#include "nativepg_internal/multiplexed_connection/health_monitor.hpp"
 #include "nativepg_internal/multiplexed_connection/multiplexer.hpp"
+#include "nativepg_internal/multiplexed_connection/remote_exec.hpp"
 #include "nativepg_internal/notification_queue.hpp"
 
 namespace capy = boost::capy;
 
+namespace {
+
+// A request being executed by exec(). Lives in its coroutine frame
+struct exec_op : nativepg::detail::multiplexer_elem
+{
+    capy::async_event done_event;
+    std::error_code result_ec;
+
+    exec_op(const nativepg::request& req, nativepg::response_handler_ref handler)
+        : nativepg::detail::multiplexer_elem{&req, handler, &on_done}
+    {
+    }
+
+    static void on_done(nativepg::detail::multiplexer_elem& elm, std::error_code ec)
+    {
+        auto& self = static_cast<exec_op&>(elm);
+        self.result_ec = ec;
+        self.done_event.set();
+    }
+};
+
+// A request being executed by exec(), when called from outside the connection's execution context.
+// Lives in its coroutine frame. Notifications from the connection's context are posted
+// to the caller's one, setting done_event (completion) or cancel_done (acknowledging a cancellation)
+struct remote_exec_op : nativepg::detail::remote_exec_node
+{
+    capy::executor_ref caller_ex;
+    capy::async_event done_event;
+    capy::async_event cancel_done;
+
+    remote_exec_op(
+        const nativepg::request& req,
+        nativepg::response_handler_ref handler,
+        capy::executor_ref ex
+    )
+        : nativepg::detail::remote_exec_node{req, handler, &notify_caller}, caller_ex(ex)
+    {
+    }
+
+    static capy::task<> set_event(capy::async_event& evt)
+    {
+        evt.set();
+        co_return;
+    }
+
+    // Runs in the connection's context
+    static void notify_caller(nativepg::detail::remote_exec_node& node, notification n)
+    {
+        auto& self = static_cast<remote_exec_op&>(node);
+        auto& evt = n == notification::done ? self.done_event : self.cancel_done;
+        capy::run_async(self.caller_ex)(set_event(evt));
+    }
+};
+
+}  // namespace
+
 struct nativepg::co_multiplexed_connection::impl
 {
     co_connection conn;
     detail::multiplexer mpx;
     capy::async_event write_evt;
-    detail::notification_queue notif_queue{256u};  // TODO: make configurable
+    capy::async_event batch_full_evt;  // pending requests reached max_write_batch_size
+    detail::notification_queue notif_queue{256u, notification_overflow_policy::drop};
+    std::chrono::steady_clock::duration write_linger{};
+    std::size_t max_write_batch_size{(std::numeric_limits<std::size_t>::max)()};
+    std::size_t max_queued_requests{(std::numeric_limits<std::size_t>::max)()};
+    std::atomic<std::chrono::steady_clock::duration> request_timeout{};  // Read by exec() from any thread
+
+    // Submission of requests from other threads. The connection's executor is published
+    // by run(), and is required to wake it up. Submissions made before wait until run() opens the queue
+    capy::execution_context* ctx;
+    detail::remote_exec_queue remote;
+    std::optional<capy::executor_ref> executor;  // Written once, before remote is opened
+
+    // Bytes of the requests being executed by exec(). Used for load balancing
+    std::atomic<std::size_t> outstanding_bytes{0u};
+
+    // Health checks
+    detail::health_monitor health;
+    capy::async_event never_evt;  // Never set. Waited on when health checks are disabled
+
+    explicit impl(boost::capy::execution_context& ctx) : conn(ctx), ctx(&ctx) {}
+
+    // Moves the requests submitted from other threads to the multiplexer
+    void drain_submissions()
+    {
+        on_submissions(remote.drain(mpx, max_queued_requests, conn.state().types.get()));
+    }
 
-    explicit impl(boost::capy::execution_context& ctx) : conn(ctx) {}
+    // Signals the writer that it has job to be done, if requests were submitted
+    void on_submissions(bool any)
+    {
+        if (!any)
+            return;
+        write_evt.set();
+        if (mpx.pending_bytes() >= max_write_batch_size)
+            batch_full_evt.set();
+    }
+
+    // Posted to the connection's context by the producer that finds the submission queue empty
+    capy::task<> drain_task()
+    {
+        drain_submissions();
+        co_return;
+    }
+
+    // Posted to the connection's context when a remote exec() is cancelled
+    capy::task<> cancel_task(remote_exec_op& op)
+    {
+        on_submissions(remote.cancel(op, mpx, max_queued_requests, conn.state().types.get()));
+        co_return;
+    }
 
     // These tasks don't return an error code so when_any
     // finishes when they return
+    capy::io_task<> linger_timer()
+    {
+        [[maybe_unused]] auto [ec] = co_await capy::delay(write_linger);
+        co_return {};
+    }
+
+    capy::io_task<> wait_batch_full()
+    {
+        [[maybe_unused]] auto [ec] = co_await batch_full_evt.wait();
+        co_return {};
+    }
+
     capy::io_task<> writer()
     {
         auto& stream = conn.stream();
+        auto tok = co_await capy::this_coro::stop_token;
+        bool has_leftovers = false;  // did the last batch leave requests behind?
 
         while (true)
         {
-            // Attempt to prepare any pending requests
-            auto buff = mpx.prepare_write();
+            // Requests submitted from other threads join this batch
+            drain_submissions();
 
-            // No more requests to write. Wait for more
-            if (buff.empty())
+            // No requests to write, or too many in flight. Wait until this changes
+            if (!mpx.can_write())
             {
                 write_evt.clear();
                 auto [ec] = co_await write_evt.wait();
@@ -60,8 +195,27 @@ struct nativepg::co_multiplexed_connection::impl
                 continue;
             }
 
-            // Write the request.
-            // TODO: this will have to change once we implement health checks
+            // Give other requests the chance to join this write, unless the batch is already full.
+            // Requests left behind by the previous batch have already waited
+            if (write_linger > std::chrono::steady_clock::duration::zero() && !has_leftovers &&
+                mpx.pending_bytes() < max_write_batch_size)
+            {
+                batch_full_evt.clear();
+                [[maybe_unused]] auto res = co_await capy::when_any(linger_timer(), wait_batch_full());
+                if (tok.stop_requested())
+                    co_return {};
+            }
+
+            // Compose the batch. All pending requests might have been cancelled
+            bool was_idle = mpx.in_flight_count() == 0u;
+            auto buff = mpx.prepare_write(max_write_batch_size);
+            has_leftovers = mpx.has_pending();
+            if (buff.empty())
+                continue;
+
+            health.on_write(was_idle, std::chrono::steady_clock::now());
+
+            // Write the request
             auto [ec, bytes] = co_await capy::write(stream, capy::make_buffer(buff));
             if (ec)
                 co_return {};
@@ -77,6 +231,7 @@ struct nativepg::co_multiplexed_connection::impl
             // Read until we have at least one message
             if (auto [ec] = co_await conn.read_some_messages(); ec)
                 co_return {ec};
+            health.on_read(std::chrono::steady_clock::now());
 
             // Process each message
             auto bytes = st.read_buffer.committed_area();
@@ -101,15 +256,10 @@ struct nativepg::co_multiplexed_connection::impl
                 // Account for the message bytes
                 consumed += res.size;
 
-                // Handle notifications
-                // TODO: although this is a valid backpressure strategy,
-                // it interacts poorly with running requests in the same coroutine.
-                // This is known in Boost.Redis. I'd like to make it better. Options include
-                //    a. Let exec() and read_notifies() handle run()'s work. This buys built-in
-                //       backpressure, but eliminates the option of built-in health-checks.
-                //    b. Make exec() unblock the reader if it's waiting for a message.
-                //       Makes the upper limit soft. May need to tear down the connection
-                //       if too many notifications stack.
+                // Handle notifications. If the queue is full, the overflow policy decides.
+                // By default, notifications are discarded, so the response path is never blocked.
+                // Waiting for space only happens if the user asked for it, and delays
+                // responses to all requests until the consumer catches up
                 if (res.message.type() == protocol::any_backend_message::kind::notification_response)
                 {
                     const auto& notif_msg = res.message.get_notification_response();
@@ -123,10 +273,47 @@ struct nativepg::co_multiplexed_connection::impl
                 {
                     // We have a message, deliver it.
                     // An error here means an irrecoverable failure
+                    auto in_flight = mpx.in_flight_count();
                     if (auto ec = mpx.on_message(res.message))
                         co_return {};
+
+                    // A request completed, which may let the writer send queued ones
+                    if (mpx.in_flight_count() < in_flight && mpx.can_write())
+                        write_evt.set();
                 }
             }
+
+            // Pick up requests submitted from other threads while we were reading
+            drain_submissions();
+        }
+    }
+
+    // Sends periodic pings, and returns if the connection looks dead, so that run() reconnects
+    capy::io_task<> health_checker()
+    {
+        using clock = std::chrono::steady_clock;
+
+        health.reset(clock::now());
+
+        while (true)
+        {
+            // Wait until the next check is due. If health checks are disabled, just wait for cancellation
+            auto now = clock::now();
+            auto next = health.next_check(mpx, now);
+            if (next == (clock::time_point::max)())
+            {
+                [[maybe_unused]] auto [ec] = co_await never_evt.wait();
+                co_return {};
+            }
+            if (auto [ec] = co_await capy::delay(next - now); ec)
+                co_return {};
+
+            switch (health.check(mpx, clock::now()))
+            {
+                case detail::health_monitor::action::stalled: co_return {};
+                case detail::health_monitor::action::ping: write_evt.set(); break;
+                default: break;
+            }
         }
     }
 
@@ -134,11 +321,28 @@ struct nativepg::co_multiplexed_connection::impl
     {
         auto tok = co_await capy::this_coro::stop_token;
 
+        // Publish our executor, so other threads can submit requests and wake us up.
+        // Submissions made before publishing were parked, and are handed to us now
+        if (!remote.is_open())
+        {
+            executor = co_await capy::this_coro::executor;
+            on_submissions(remote.open(mpx, max_queued_requests, conn.state().types.get()));
+        }
+        drain_submissions();
+
         while (true)
         {
             // Try to connect
+            write_linger = cfg.write_linger;
+            max_write_batch_size = cfg.max_write_batch_size;
+            max_queued_requests = cfg.max_queued_requests;
+            mpx.set_in_flight_limits(cfg.max_in_flight_requests, cfg.max_in_flight_bytes);
+            request_timeout = cfg.request_timeout;
+            health.set_config(cfg.ping_interval, cfg.stall_timeout);
+            notif_queue.set_limits(cfg.max_queued_notifications, cfg.notification_overflow);
             // TODO: this is doing a copy
             // TODO: are we properly resetting state here?
+            conn.set_type_registry(cfg.types);
             auto [ec] = co_await conn.connect(cfg.transport);
             if (tok.stop_requested())
                 co_return {capy::error::canceled};
@@ -149,7 +353,7 @@ struct nativepg::co_multiplexed_connection::impl
                 notif_queue.add_connect();
 
                 // Run the tasks
-                [[maybe_unused]] auto res = co_await capy::when_any(writer(), reader());
+                [[maybe_unused]] auto res = co_await capy::when_any(writer(), reader(), health_checker());
                 if (tok.stop_requested())
                     co_return {capy::error::canceled};
 
@@ -169,43 +373,113 @@ struct nativepg::co_multiplexed_connection::impl
         }
     }
 
-    boost::capy::io_task<> exec(const request& req, response_handler_ref handler, diagnostics* = nullptr)
+    // Requests from the connection's context access the multiplexer directly.
+    // The rest go through the submission queue. On timeout, the inner operation
+    // is cancelled, which abandons the request. This is in the path of every request,
+    // so it's kept to a single coroutine on top of do_exec/do_remote_exec
+    boost::capy::io_task<> exec(const request& req, response_handler_ref handler, diagnostics* diag)
+    {
+        std::size_t size = req.payload_size();
+        outstanding_bytes.fetch_add(size, std::memory_order_relaxed);
+        auto ex = co_await capy::this_coro::executor;
+        auto timeout = request_timeout.load(std::memory_order_relaxed);
+        bool has_timeout = timeout > std::chrono::steady_clock::duration::zero();
+        capy::io_result<> res;
+        bool is_local = &ex.context() == ctx;
+        if (is_local && has_timeout)
+            res = co_await capy::timeout(do_exec(req, handler, diag), timeout);
+        else if (is_local)
+            res = co_await do_exec(req, handler, diag);
+        else if (has_timeout)
+            res = co_await capy::timeout(do_remote_exec(req, handler, ex), timeout);
+        else
+            res = co_await do_remote_exec(req, handler, ex);
+        outstanding_bytes.fetch_sub(size, std::memory_order_relaxed);
+        co_return res;
+    }
+
+    boost::capy::io_task<> do_remote_exec(
+        const request& req,
+        response_handler_ref handler,
+        capy::executor_ref ex
+    )
+    {
+        // Submit the request. The first submission of a batch wakes up the connection.
+        // If run() hasn't published its executor yet, the request is parked until it does
+        remote_exec_op op{req, handler, ex};
+        if (remote.submit(op))
+            capy::run_async(*executor)(drain_task());
+
+        // Wait for the response to arrive
+        auto [wait_ec] = co_await op.done_event.wait();
+        static_cast<void>(wait_ec);
+
+        // As in do_exec, checking the event is more reliable than checking wait_ec.
+        // On cancellation, the connection must forget about op before we return.
+        // This wait can't be cancelled, so replace the stop token
+        if (!op.done_event.is_set())
+        {
+            // If run() hasn't taken op yet, there's nobody to notify
+            if (remote.withdraw(op))
+                co_return {boost::capy::error::canceled};
+
+            // Otherwise, run() has published its executor
+            capy::run_async(*executor)(cancel_task(op));
+            co_await capy::run(std::stop_token())([&op]() -> capy::task<> {
+                auto [ec] = co_await op.cancel_done.wait();
+                static_cast<void>(ec);
+
+                // If op completed while we were cancelling, its notification is on the way
+                if (op.done_posted)
+                {
+                    auto [ec2] = co_await op.done_event.wait();
+                    static_cast<void>(ec2);
+                }
+            }());
+            co_return {boost::capy::error::canceled};
+        }
+
+        co_return {op.result_ec ? op.result_ec : std::error_code(handler.result().code)};
+    }
+
+    boost::capy::io_task<> do_exec(const request& req, response_handler_ref handler, diagnostics*)
     {
         // Check that the request is valid
-        if (auto req_ec = protocol::detail::setup_request(req, handler))
+        if (auto req_ec = protocol::detail::setup_request(req, handler, conn.state().types.get()))
             co_return {req_ec};
         // TODO: diagnostics
 
-        // Setup
-        boost::capy::async_event done_event;
-        std::error_code result_ec;
-        auto on_done = [&result_ec, &done_event](std::error_code ec) {
-            result_ec = ec;
-            done_event.set();
-        };
+        // Fail fast if the queue is full, rather than adding to the latency of every request
+        if (mpx.pending_count() >= max_queued_requests)
+            co_return {client_errc::queue_full};
+
+        // Setup. The queue node lives in our frame, so enqueueing doesn't allocate
+        exec_op op{req, handler};
 
         // Add the request to the multiplexer
-        auto* elm = mpx.add(&req, handler, on_done);
+        mpx.add(op);
 
         // Signal the writer that it has job to be done
         write_evt.set();
+        if (mpx.pending_bytes() >= max_write_batch_size)
+            batch_full_evt.set();
 
         // Wait for the response to arrive
-        auto [wait_ec] = co_await done_event.wait();
+        auto [wait_ec] = co_await op.done_event.wait();
         static_cast<void>(wait_ec);
 
         // We're done. If the event was set, the request has completed without cancellations.
-        // No cleanup is required. The element will probably be invalid at this point (elm dangles)
+        // The multiplexer has already removed op from the queue, so no cleanup is required.
         // If the event wasn't set, we were cancelled (checking this is more reliable that checking
         // wait_ec, because there may be a reschedule between cancellation and resuming, while the
-        // callback is sync). On cancellation, elm is valid and should be marked as cancelled.
-        if (done_event.is_set())
+        // callback is sync). On cancellation, op is still queued and must be removed before we return.
+        if (op.done_event.is_set())
         {
-            co_return {result_ec ? result_ec : std::error_code(handler.result().code)};
+            co_return {op.result_ec ? op.result_ec : std::error_code(handler.result().code)};
         }
         else
         {
-            mpx.cancel(elm);
+            mpx.cancel(op);
             co_return {boost::capy::error::canceled};
         }
     }
@@ -216,6 +490,10 @@ nativepg::co_multiplexed_connection::co_multiplexed_connection(boost::capy::exec
 {
 }
 
+nativepg::co_multiplexed_connection::co_multiplexed_connection(
+    co_multiplexed_connection&&
+) noexcept = default;
+
 nativepg::co_multiplexed_connection& nativepg::co_multiplexed_connection::operator=(
     co_multiplexed_connection&&
 ) noexcept = default;
@@ -242,3 +520,54 @@ boost::capy::io_task<> nativepg::co_multiplexed_connection::read_notifications(
 {
     return impl_->notif_queue.read_events(output);
 }
+
+nativepg::multiplexed_stats nativepg::co_multiplexed_connection::stats() const { return impl_->mpx.stats(); }
+
+std::size_t nativepg::co_multiplexed_connection::outstanding_bytes() const
+{
+    return impl_->outstanding_bytes.load(std::memory_order_relaxed);
+}
+
+boost::capy::io_task<> nativepg::co_multiplexed_connection::read_notifications(notification_batch& output)
+{
+    return impl_->notif_queue.read_events(output);
+}
+
+nativepg::notification_subscription nativepg::co_multiplexed_connection::subscribe(std::string_view channel)
+{
+    return notification_subscription(impl_->notif_queue.subscribe(channel));
+}
+
+nativepg::notification_stats nativepg::co_multiplexed_connection::get_notification_stats() const
+{
+    return impl_->notif_queue.stats();
+}
+
+nativepg::notification_subscription::notification_subscription(
+    std::unique_ptr<detail::notification_subscriber> impl
+) noexcept
+    : impl_(std::move(impl))
+{
+}
+
+nativepg::notification_subscription::notification_subscription() noexcept = default;
+nativepg::notification_subscription::notification_subscription(
+    notification_subscription&&
+) noexcept = default;
+nativepg::notification_subscription& nativepg::notification_subscription::operator=(
+    notification_subscription&&
+) noexcept = default;
+nativepg::notification_subscription::~notification_subscription() = default;
+
+nativepg::notification_channel_id nativepg::notification_subscription::channel_id() const
+{
+    BOOST_ASSERT(valid());
+    return impl_->channel;
+}
+
+boost::capy::io_task<> nativepg::notification_subscription::read(notification_batch& output)
+{
+    BOOST_ASSERT(valid());
+    BOOST_ASSERT(impl_->queue != nullptr);
+    return impl_->queue->read_events(*impl_, output);
+}
@@ -0,0 +1,182 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/assert.hpp>
+#include <boost/capy/error.hpp>
+#include <boost/capy/ex/execution_context.hpp>
+#include <boost/capy/ex/this_coro.hpp>
+#include <boost/capy/io_task.hpp>
+#include <boost/capy/when_any.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "nativepg/co_multiplexed_connection.hpp"
+#include "nativepg/co_multiplexed_pool.hpp"
+#include "nativepg/type_registry.hpp"
+#include "nativepg_internal/multiplexed_connection/router.hpp"
+
+namespace capy = boost::capy;
+
+namespace {
+
+// The connections that run in a single execution context
+struct shard
+{
+    capy::execution_context* ctx;
+    std::vector<nativepg::co_multiplexed_connection> conns;
+    nativepg::multiplexed_config config;  // Only accessed from ctx
+    std::size_t next{};                   // Routing state. Only accessed from ctx
+
+    shard(capy::execution_context& ctx, std::size_t num_conns, const nativepg::multiplexed_config& cfg)
+        : ctx(&ctx), config(cfg)
+    {
+        // type_registry is not thread-safe, so each context gets its own copy
+        if (config.types)
+            config.types = std::make_shared<nativepg::type_registry>(*config.types);
+
+        conns.reserve(num_conns);
+        for (std::size_t i = 0; i < num_conns; ++i)
+            conns.emplace_back(ctx);
+    }
+};
+
+}  // namespace
+
+struct nativepg::co_multiplexed_pool::impl
+{
+    multiplexed_pool_params params;
+    std::vector<shard> shards;
+    std::atomic<std::size_t> next{0u};  // Routing state for requests not served by a single shard
+
+    impl(std::span<capy::execution_context* const> contexts, multiplexed_pool_params&& params)
+        : params(std::move(params))
+    {
+        BOOST_ASSERT(!contexts.empty());
+        BOOST_ASSERT(this->params.connections_per_context > 0u);
+        shards.reserve(contexts.size());
+        for (auto* ctx : contexts)
+        {
+            BOOST_ASSERT(ctx != nullptr);
+            shards.emplace_back(*ctx, this->params.connections_per_context, this->params.connection);
+        }
+    }
+
+    // Returns null if ctx is not one of our contexts
+    shard* find_shard(capy::execution_context& ctx)
+    {
+        // The number of contexts is usually the number of threads, so a linear search is fine
+        for (auto& s : shards)
+        {
+            if (s.ctx == &ctx)
+                return &s;
+        }
+        return nullptr;
+    }
+
+    std::size_t size() const { return shards.size() * params.connections_per_context; }
+
+    co_multiplexed_connection& connection(std::size_t index)
+    {
+        auto per_context = params.connections_per_context;
+        return shards[index / per_context].conns[index % per_context];
+    }
+
+    // Connections are thread-safe for exec(), and their load counters are atomic
+    co_multiplexed_connection& select(capy::execution_context& ctx)
+    {
+        // Keep the request in the caller's context, if possible
+        auto* s = params.executor_affinity ? find_shard(ctx) : nullptr;
+        if (s)
+        {
+            auto& conns = s->conns;
+            auto load = [&conns](std::size_t i) { return conns[i].outstanding_bytes(); };
+            return conns[detail::select_connection(params.routing, conns.size(), s->next++, load)];
+        }
+
+        // Consider all connections
+        auto start = next.fetch_add(1u, std::memory_order_relaxed);
+        auto load = [this](std::size_t i) { return connection(i).outstanding_bytes(); };
+        return connection(detail::select_connection(params.routing, size(), start, load));
+    }
+
+    // Runs conns[first, last). Each connection only finishes when cancelled,
+    // so this finishes once all of them have been cancelled
+    capy::io_task<> run_range(shard& s, std::size_t first, std::size_t last)
+    {
+        if (last - first == 1u)
+            co_return co_await s.conns[first].run(s.config);
+        std::size_t mid = first + (last - first) / 2u;
+        [[maybe_unused]] auto res = co_await capy::when_any(
+            run_range(s, first, mid),
+            run_range(s, mid, last)
+        );
+        co_return {capy::error::canceled};
+    }
+
+    capy::io_task<> run()
+    {
+        auto ex = co_await capy::this_coro::executor;
+        auto* s = find_shard(ex.context());
+        BOOST_ASSERT_MSG(s != nullptr, "co_multiplexed_pool::run called from a context it doesn't own");
+        co_return co_await run_range(*s, 0u, s->conns.size());
+    }
+
+    capy::io_task<> exec(const request& req, response_handler_ref handler, diagnostics* diag)
+    {
+        auto ex = co_await capy::this_coro::executor;
+        co_return co_await select(ex.context()).exec(req, handler, diag);
+    }
+};
+
+nativepg::co_multiplexed_pool::co_multiplexed_pool(
+    std::span<capy::execution_context* const> contexts,
+    multiplexed_pool_params params
+)
+    : impl_(std::make_unique<impl>(contexts, std::move(params)))
+{
+}
+
+nativepg::co_multiplexed_pool::co_multiplexed_pool(
+    capy::execution_context& ctx,
+    multiplexed_pool_params params
+)
+{
+    capy::execution_context* contexts[] = {&ctx};
+    impl_ = std::make_unique<impl>(contexts, std::move(params));
+}
+
+nativepg::co_multiplexed_pool::co_multiplexed_pool(co_multiplexed_pool&&) noexcept = default;
+
+nativepg::co_multiplexed_pool& nativepg::co_multiplexed_pool::operator=(
+    co_multiplexed_pool&&
+) noexcept = default;
+
+nativepg::co_multiplexed_pool::~co_multiplexed_pool() = default;
+
+boost::capy::io_task<> nativepg::co_multiplexed_pool::run() { return impl_->run(); }
+
+boost::capy::io_task<> nativepg::co_multiplexed_pool::exec(
+    const request& req,
+    response_handler_ref handler,
+    diagnostics* diag
+)
+{
+    return impl_->exec(req, handler, diag);
+}
+
+std::size_t nativepg::co_multiplexed_pool::size() const { return impl_->size(); }
+
+nativepg::co_multiplexed_connection& nativepg::co_multiplexed_pool::connection(std::size_t index)
+{
+    BOOST_ASSERT(index < size());
+    return impl_->connection(index);
+}
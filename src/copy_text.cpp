@@ -0,0 +1,252 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <bit>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "nativepg/copy_text_reader.hpp"
+#include "nativepg/field_view.hpp"
+
+// Tokenizer for the text COPY format. The kernels locate the next delimiter,
+// newline or backslash. Same dispatch scheme as the hex kernels:
+// x86-64 always has SSE2, and AVX2 is detected at runtime.
+#if defined(__SSE2__) || defined(_M_X64)
+#define NATIVEPG_COPY_TEXT_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(NATIVEPG_COPY_TEXT_SSE2) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define NATIVEPG_COPY_TEXT_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// --- Scalar
+
+std::size_t find_special_scalar(const unsigned char* data, std::size_t size, unsigned char delimiter)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const unsigned char c = data[i];
+        if (c == delimiter || c == '\n' || c == '\\')
+            return i;
+    }
+    return size;
+}
+
+// --- SSE2
+
+#ifdef NATIVEPG_COPY_TEXT_SSE2
+
+std::size_t find_special_sse2(const unsigned char* data, std::size_t size, unsigned char delimiter)
+{
+    const __m128i delim = _mm_set1_epi8(static_cast<char>(delimiter));
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i backslash = _mm_set1_epi8('\\');
+
+    std::size_t i = 0u;
+    for (; i + 16u <= size; i += 16u)
+    {
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const __m128i matches = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chars, delim), _mm_cmpeq_epi8(chars, newline)),
+            _mm_cmpeq_epi8(chars, backslash)
+        );
+        if (const int mask = _mm_movemask_epi8(matches))
+            return i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+    }
+    return i + find_special_scalar(data + i, size - i, delimiter);
+}
+
+#endif
+
+// --- AVX2
+
+#ifdef NATIVEPG_COPY_TEXT_AVX2
+
+__attribute__((target("avx2"))) std::size_t find_special_avx2(
+    const unsigned char* data,
+    std::size_t size,
+    unsigned char delimiter
+)
+{
+    const __m256i delim = _mm256_set1_epi8(static_cast<char>(delimiter));
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+
+    std::size_t i = 0u;
+    for (; i + 32u <= size; i += 32u)
+    {
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        const __m256i matches = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chars, delim), _mm256_cmpeq_epi8(chars, newline)),
+            _mm256_cmpeq_epi8(chars, backslash)
+        );
+        if (const int mask = _mm256_movemask_epi8(matches))
+            return i + static_cast<std::size_t>(std::countr_zero(static_cast<unsigned>(mask)));
+    }
+    return i + find_special_sse2(data + i, size - i, delimiter);
+}
+
+#endif
+
+// --- Dispatch
+
+using find_special_fn = std::size_t (*)(const unsigned char*, std::size_t, unsigned char);
+
+find_special_fn select_kernel()
+{
+#ifdef NATIVEPG_COPY_TEXT_AVX2
+    if (__builtin_cpu_supports("avx2"))
+        return &find_special_avx2;
+#endif
+#ifdef NATIVEPG_COPY_TEXT_SSE2
+    return &find_special_sse2;
+#else
+    return &find_special_scalar;
+#endif
+}
+
+std::size_t find_special(const unsigned char* data, std::size_t size, unsigned char delimiter)
+{
+    static const find_special_fn fn = select_kernel();
+    return fn(data, size, delimiter);
+}
+
+// --- Escapes
+
+bool is_octal(unsigned char c) { return c >= '0' && c <= '7'; }
+
+int hex_value(unsigned char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+    return -1;
+}
+
+// Decodes a field containing backslash escapes. Backslashes are always followed by a character.
+// Besides the usual C escapes, \ followed by 1-3 octal digits or by x and 1-2 hex digits
+// represents a byte. A backslash followed by anything else represents that character.
+void unescape(std::span<const unsigned char> from, std::vector<unsigned char>& to)
+{
+    for (std::size_t i = 0u; i < from.size(); ++i)
+    {
+        const unsigned char c = from[i];
+        if (c != '\\')
+        {
+            to.push_back(c);
+            continue;
+        }
+
+        const unsigned char next = from[++i];
+        switch (next)
+        {
+            case 'b': to.push_back('\b'); break;
+            case 'f': to.push_back('\f'); break;
+            case 'n': to.push_back('\n'); break;
+            case 'r': to.push_back('\r'); break;
+            case 't': to.push_back('\t'); break;
+            case 'v': to.push_back('\v'); break;
+            case 'x':
+            {
+                int value = 0, digits = 0, digit = 0;
+                while (digits < 2 && i + 1u < from.size() && (digit = hex_value(from[i + 1u])) != -1)
+                {
+                    value = value * 16 + digit;
+                    ++digits;
+                    ++i;
+                }
+                to.push_back(digits ? static_cast<unsigned char>(value) : 'x');
+                break;
+            }
+            default:
+            {
+                if (!is_octal(next))
+                {
+                    to.push_back(next);
+                    break;
+                }
+                int value = next - '0';
+                for (int digits = 1; digits < 3 && i + 1u < from.size() && is_octal(from[i + 1u]); ++digits)
+                    value = value * 8 + (from[++i] - '0');
+                to.push_back(static_cast<unsigned char>(value));
+                break;
+            }
+        }
+    }
+}
+
+}  // namespace
+
+std::size_t nativepg::copy_text_reader::parse_row(std::span<const unsigned char> data)
+{
+    // Find field boundaries. Characters after a backslash are skipped
+    raw_fields_.clear();
+    std::size_t pos = 0u, field_start = 0u;
+    bool escaped = false;
+    while (true)
+    {
+        pos += find_special(data.data() + pos, data.size() - pos, delimiter_);
+        if (pos == data.size())
+            return 0u;
+
+        const unsigned char c = data[pos];
+        if (c == '\\')
+        {
+            if (pos + 1u == data.size())
+                return 0u;
+            escaped = true;
+            pos += 2u;
+            continue;
+        }
+
+        raw_fields_.push_back({field_start, pos - field_start, escaped, false});
+        escaped = false;
+        ++pos;
+        if (c == '\n')
+            break;
+        field_start = pos;
+    }
+
+    // Decode escaped fields. Views are built afterwards, since decoding may reallocate
+    decoded_.clear();
+    for (auto& field : raw_fields_)
+    {
+        auto raw = data.subspan(field.offset, field.size);
+        if (!field.escaped)
+            continue;
+        if (raw.size() == 2u && raw[1] == 'N')
+        {
+            field.is_null = true;
+            continue;
+        }
+        const std::size_t offset = decoded_.size();
+        unescape(raw, decoded_);
+        field.offset = offset;
+        field.size = decoded_.size() - offset;
+    }
+
+    fields_.clear();
+    for (const auto& field : raw_fields_)
+    {
+        if (field.is_null)
+            fields_.emplace_back();
+        else if (!field.escaped)
+            fields_.emplace_back(data.subspan(field.offset, field.size));
+        else
+            fields_.emplace_back(std::span<const unsigned char>(decoded_).subspan(field.offset, field.size));
+    }
+
+    return pos;
+}
@@ -55,6 +55,14 @@ static const char* error_to_string(client_errc error)
             return "request_mixes_simple_advanced_protocols";
         case client_errc::step_skipped: return "step_skipped";
         case client_errc::unknown_openssl_error: return "unknown_openssl_error";
+        case client_errc::value_out_of_range:
+            return "A value received from the server can't be represented by the C++ type it's being "
+                   "parsed into";
+        case client_errc::text_format_not_supported:
+            return "A field was received using the text format, but the C++ type it's being parsed into "
+                   "only supports the binary format";
+        case client_errc::queue_full:
+            return "Too many requests are waiting to be written to the multiplexed connection";
         default: return "<unknown nativepg client error>";
     }
 }
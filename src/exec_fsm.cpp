@@ -33,7 +33,7 @@ exec_fsm::result exec_fsm::resume(connection_state& st, std::error_code ec, std:
         NATIVEPG_CORO_INITIAL
 
         // Initial checkings
-        if (auto ec_req = setup_request(read_fsm_.get_request(), read_fsm_.get_handler()))
+        if (auto ec_req = setup_request(read_fsm_.get_request(), read_fsm_.get_handler(), st.types.get()))
             return ec_req;
 
         // Write the request
@@ -0,0 +1,289 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <array>
+#include <cstddef>
+
+#include "nativepg/types/base.hpp"
+
+// Hex encoding and decoding kernels, used by text-format bytea.
+// x86-64 always has SSE2. AVX2 is detected at runtime, and requires
+// compiler support for per-function target attributes.
+#if defined(__SSE2__) || defined(_M_X64)
+#define NATIVEPG_HEX_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(NATIVEPG_HEX_SSE2) && (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define NATIVEPG_HEX_AVX2
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// --- Scalar
+
+// Maps each character to its nibble value, or 0xff if it's not a hex digit
+constexpr std::array<unsigned char, 256> make_hex_table()
+{
+    std::array<unsigned char, 256> res{};
+    for (auto& v : res)
+        v = 0xff;
+    for (int i = 0; i < 10; ++i)
+        res['0' + i] = static_cast<unsigned char>(i);
+    for (int i = 0; i < 6; ++i)
+    {
+        res['a' + i] = static_cast<unsigned char>(10 + i);
+        res['A' + i] = static_cast<unsigned char>(10 + i);
+    }
+    return res;
+}
+
+constexpr auto hex_table = make_hex_table();
+constexpr char hex_digits[] = "0123456789abcdef";
+
+bool hex_decode_scalar(const char* input, std::size_t size, unsigned char* output)
+{
+    for (std::size_t i = 0; i < size; i += 2u)
+    {
+        const unsigned char hi = hex_table[static_cast<unsigned char>(input[i])];
+        const unsigned char lo = hex_table[static_cast<unsigned char>(input[i + 1])];
+        if ((hi | lo) == 0xff)
+            return false;
+        *output++ = static_cast<unsigned char>((hi << 4) | lo);
+    }
+    return true;
+}
+
+void hex_encode_scalar(const unsigned char* input, std::size_t size, char* output)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        *output++ = hex_digits[input[i] >> 4];
+        *output++ = hex_digits[input[i] & 0x0f];
+    }
+}
+
+// --- SSE2
+
+#ifdef NATIVEPG_HEX_SSE2
+
+// Converts 16 hex characters to their nibble values. Sets ok to false if any of them is invalid.
+// Characters >= 0x80 are negative when compared as signed, so they are never in range.
+inline __m128i nibbles_sse2(__m128i chars, bool& ok)
+{
+    const __m128i lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));  // 'A'-'F' => 'a'-'f'
+    const __m128i is_digit = _mm_and_si128(
+        _mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)),
+        _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1))
+    );
+    const __m128i is_alpha = _mm_and_si128(
+        _mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+        _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1))
+    );
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xffff)
+        ok = false;
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i alpha = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit), _mm_and_si128(is_alpha, alpha));
+}
+
+// Combines pairs of nibbles (high first) into 16-bit lanes holding a byte each
+inline __m128i combine_sse2(__m128i nibbles)
+{
+    const __m128i hi = _mm_and_si128(nibbles, _mm_set1_epi16(0x00ff));
+    const __m128i lo = _mm_srli_epi16(nibbles, 8);
+    return _mm_or_si128(_mm_slli_epi16(hi, 4), lo);
+}
+
+// Converts 16 nibble values to hex characters
+inline __m128i hex_chars_sse2(__m128i nibbles)
+{
+    const __m128i is_alpha = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+    const __m128i offset = _mm_and_si128(is_alpha, _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), offset);
+}
+
+bool hex_decode_sse2(const char* input, std::size_t size, unsigned char* output)
+{
+    // 32 characters => 16 bytes per iteration
+    bool ok = true;
+    std::size_t i = 0u;
+    for (; i + 32u <= size; i += 32u)
+    {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i + 16u));
+        const __m128i res = _mm_packus_epi16(
+            combine_sse2(nibbles_sse2(a, ok)),
+            combine_sse2(nibbles_sse2(b, ok))
+        );
+        if (!ok)
+            return false;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i / 2u), res);
+    }
+    return hex_decode_scalar(input + i, size - i, output + i / 2u);
+}
+
+void hex_encode_sse2(const unsigned char* input, std::size_t size, char* output)
+{
+    // 16 bytes => 32 characters per iteration
+    std::size_t i = 0u;
+    for (; i + 16u <= size; i += 16u)
+    {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), _mm_set1_epi8(0x0f));
+        const __m128i lo = _mm_and_si128(bytes, _mm_set1_epi8(0x0f));
+        const __m128i hi_chars = hex_chars_sse2(hi);
+        const __m128i lo_chars = hex_chars_sse2(lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 2u * i), _mm_unpacklo_epi8(hi_chars, lo_chars));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(output + 2u * i + 16u),
+            _mm_unpackhi_epi8(hi_chars, lo_chars)
+        );
+    }
+    hex_encode_scalar(input + i, size - i, output + 2u * i);
+}
+
+#endif
+
+// --- AVX2
+
+#ifdef NATIVEPG_HEX_AVX2
+
+__attribute__((target("avx2"))) inline __m256i nibbles_avx2(__m256i chars, bool& ok)
+{
+    const __m256i lower = _mm256_or_si256(chars, _mm256_set1_epi8(0x20));
+    const __m256i is_digit = _mm256_andnot_si256(
+        _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('9')),
+        _mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1))
+    );
+    const __m256i is_alpha = _mm256_andnot_si256(
+        _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('f')),
+        _mm256_cmpgt_epi8(lower, _mm256_set1_epi8('a' - 1))
+    );
+    if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != -1)
+        ok = false;
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i alpha = _mm256_sub_epi8(lower, _mm256_set1_epi8('a' - 10));
+    return _mm256_or_si256(_mm256_and_si256(is_digit, digit), _mm256_and_si256(is_alpha, alpha));
+}
+
+__attribute__((target("avx2"))) inline __m256i combine_avx2(__m256i nibbles)
+{
+    const __m256i hi = _mm256_and_si256(nibbles, _mm256_set1_epi16(0x00ff));
+    const __m256i lo = _mm256_srli_epi16(nibbles, 8);
+    return _mm256_or_si256(_mm256_slli_epi16(hi, 4), lo);
+}
+
+__attribute__((target("avx2"))) inline __m256i hex_chars_avx2(__m256i nibbles)
+{
+    const __m256i is_alpha = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+    const __m256i offset = _mm256_and_si256(is_alpha, _mm256_set1_epi8('a' - '0' - 10));
+    return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), offset);
+}
+
+__attribute__((target("avx2"))) bool hex_decode_avx2(
+    const char* input,
+    std::size_t size,
+    unsigned char* output
+)
+{
+    // 64 characters => 32 bytes per iteration
+    bool ok = true;
+    std::size_t i = 0u;
+    for (; i + 64u <= size; i += 64u)
+    {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i + 32u));
+        const __m256i packed = _mm256_packus_epi16(
+            combine_avx2(nibbles_avx2(a, ok)),
+            combine_avx2(nibbles_avx2(b, ok))
+        );
+        if (!ok)
+            return false;
+
+        // packus works within 128-bit lanes, so the 64-bit blocks end up as a0 b0 a1 b1
+        const __m256i res = _mm256_permute4x64_epi64(packed, 0xd8);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i / 2u), res);
+    }
+    return hex_decode_sse2(input + i, size - i, output + i / 2u);
+}
+
+__attribute__((target("avx2"))) void hex_encode_avx2(
+    const unsigned char* input,
+    std::size_t size,
+    char* output
+)
+{
+    // 32 bytes => 64 characters per iteration
+    std::size_t i = 0u;
+    for (; i + 32u <= size; i += 32u)
+    {
+        const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        const __m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), _mm256_set1_epi8(0x0f));
+        const __m256i lo = _mm256_and_si256(bytes, _mm256_set1_epi8(0x0f));
+        const __m256i hi_chars = hex_chars_avx2(hi);
+        const __m256i lo_chars = hex_chars_avx2(lo);
+
+        // unpack works within 128-bit lanes: first holds bytes 0-7 and 16-23, second 8-15 and 24-31
+        const __m256i first = _mm256_unpacklo_epi8(hi_chars, lo_chars);
+        const __m256i second = _mm256_unpackhi_epi8(hi_chars, lo_chars);
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(output + 2u * i),
+            _mm256_permute2x128_si256(first, second, 0x20)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i*>(output + 2u * i + 32u),
+            _mm256_permute2x128_si256(first, second, 0x31)
+        );
+    }
+    hex_encode_sse2(input + i, size - i, output + 2u * i);
+}
+
+#endif
+
+// --- Dispatch
+
+using decode_fn = bool (*)(const char*, std::size_t, unsigned char*);
+using encode_fn = void (*)(const unsigned char*, std::size_t, char*);
+
+struct hex_kernels
+{
+    decode_fn decode;
+    encode_fn encode;
+};
+
+hex_kernels select_kernels()
+{
+#ifdef NATIVEPG_HEX_AVX2
+    if (__builtin_cpu_supports("avx2"))
+        return {&hex_decode_avx2, &hex_encode_avx2};
+#endif
+#ifdef NATIVEPG_HEX_SSE2
+    return {&hex_decode_sse2, &hex_encode_sse2};
+#else
+    return {&hex_decode_scalar, &hex_encode_scalar};
+#endif
+}
+
+const hex_kernels& get_kernels()
+{
+    static const hex_kernels res = select_kernels();
+    return res;
+}
+
+}  // namespace
+
+bool nativepg::types::detail::hex_decode(const char* input, std::size_t size, unsigned char* output) noexcept
+{
+    return get_kernels().decode(input, size, output);
+}
+
+void nativepg::types::detail::hex_encode(const unsigned char* input, std::size_t size, char* output) noexcept
+{
+    get_kernels().encode(input, size, output);
+}
@@ -725,6 +725,7 @@ void nativepg::protocol::format_codes::throw_invalid_argument()
 struct nativepg::protocol::detail::bind_context_access
 {
     static std::size_t num_params(const bind_context& ctx) { return ctx.num_params_; }
+    static std::size_t borrowed_size(const bind_context& ctx) { return ctx.borrowed_size_; }
     static void maybe_finish_parameter(bind_context& ctx) { ctx.maybe_finish_parameter(); }
 };
 
@@ -760,7 +761,8 @@ void serialize_fmt_codes(const format_codes& fmt_codes, detail::serialization_co
 
 void serialize_params(
     boost::compat::function_ref<void(bind_context&)> parameters_fn,
-    detail::serialization_context& ctx
+    detail::serialization_context& ctx,
+    std::vector<borrowed_chunk>* borrowed
 )
 {
     // Allocate space for the number of parameters (not yet known)
@@ -769,13 +771,16 @@ void serialize_params(
     buffer.resize(buffer.size() + 2u);
 
     // Call the user function, which will serialize all the parameters
-    bind_context bind_ctx(buffer);
+    bind_context bind_ctx = borrowed ? bind_context(buffer, *borrowed) : bind_context(buffer);
     parameters_fn(bind_ctx);
     detail::bind_context_access::maybe_finish_parameter(bind_ctx);
 
     // Check for errors
     ctx.add_error(bind_ctx.error());
 
+    // Borrowed data is part of the message, even if it's not in the buffer
+    ctx.add_external_size(detail::bind_context_access::borrowed_size(bind_ctx));
+
     // Serialize the number of parameters
     std::size_t num_params = detail::bind_context_access::num_params(bind_ctx);
     if (num_params > (std::numeric_limits<std::int16_t>::max)())
@@ -798,7 +803,8 @@ void nativepg::protocol::bind_context::maybe_finish_parameter()
     // TODO: Assert is wrong. Fix this for sql that has escaped values (?) buff_ seems to contain the sql
     // statement?
     // BOOST_ASSERT(buff_.size() > param_offset_ + 4u);
-    std::size_t param_size = buff_.size() - param_offset_ - 4u;
+    std::size_t param_size = buff_.size() - param_offset_ - 4u + param_borrowed_size_;
+    param_borrowed_size_ = 0u;
 
     // If the size exceeds INT32_MAX, error
     if (param_size > (std::numeric_limits<std::int32_t>::max)())
@@ -814,7 +820,13 @@ void nativepg::protocol::bind_context::maybe_finish_parameter()
     param_offset_ = no_offset;
 }
 
-std::error_code nativepg::protocol::serialize(const bind& msg, std::vector<unsigned char>& to)
+namespace {
+
+std::error_code serialize_bind_impl(
+    const bind& msg,
+    std::vector<unsigned char>& to,
+    std::vector<borrowed_chunk>* borrowed
+)
 {
     detail::serialization_context ctx(to);
 
@@ -829,7 +841,7 @@ std::error_code nativepg::protocol::serialize(const bind& msg, std::vector<unsig
     serialize_fmt_codes(msg.parameter_fmt_codes, ctx);
 
     // Serialize the parameters
-    serialize_params(msg.parameters_fn, ctx);
+    serialize_params(msg.parameters_fn, ctx, borrowed);
 
     // Result format codes
     serialize_fmt_codes(msg.result_fmt_codes, ctx);
@@ -837,6 +849,22 @@ std::error_code nativepg::protocol::serialize(const bind& msg, std::vector<unsig
     return ctx.finalize_message();
 }
 
+}  // namespace
+
+std::error_code nativepg::protocol::serialize(const bind& msg, std::vector<unsigned char>& to)
+{
+    return serialize_bind_impl(msg, to, nullptr);
+}
+
+std::error_code nativepg::protocol::serialize(
+    const bind& msg,
+    std::vector<unsigned char>& to,
+    std::vector<borrowed_chunk>& borrowed
+)
+{
+    return serialize_bind_impl(msg, to, &borrowed);
+}
+
 std::error_code nativepg::protocol::serialize(const describe& msg, std::vector<unsigned char>& to)
 {
     detail::serialization_context ctx(to);
@@ -0,0 +1,98 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_CHANNEL_TABLE_HPP
+#define NATIVEPG_CHANNEL_TABLE_HPP
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "nativepg/notification_batch.hpp"
+
+namespace nativepg::detail {
+
+struct notification_subscriber;
+
+// Interns the names of the channels subscribed to in a multiplexed connection, and keeps
+// track of the subscribers of each channel. Names are stored once and never removed,
+// so views to them remain valid while the table is alive. Channels that are only notified
+// are looked up, but not added, so the table doesn't grow with them
+class channel_table
+{
+    struct entry
+    {
+        std::string name;
+        std::vector<notification_subscriber*> subscribers;
+    };
+
+    std::deque<entry> entries_;                                        // Indexed by ID. Stable addresses
+    std::unordered_map<std::string_view, notification_channel_id> ids_;  // Keys point into entries_
+
+public:
+    channel_table() = default;
+    channel_table(const channel_table&) = delete;
+    channel_table& operator=(const channel_table&) = delete;
+
+    // Returns the ID for a channel, creating it if required
+    notification_channel_id intern(std::string_view name)
+    {
+        auto it = ids_.find(name);
+        if (it != ids_.end())
+            return it->second;
+        auto id = static_cast<notification_channel_id>(entries_.size());
+        const auto& stored = entries_.emplace_back(entry{std::string(name), {}}).name;
+        ids_.emplace(stored, id);
+        return id;
+    }
+
+    // Returns the ID for a channel, or no_channel_id if it's not in the table
+    notification_channel_id find(std::string_view name) const
+    {
+        auto it = ids_.find(name);
+        return it == ids_.end() ? no_channel_id : it->second;
+    }
+
+    std::size_t size() const { return entries_.size(); }
+
+    std::string_view name(notification_channel_id id) const
+    {
+        BOOST_ASSERT(id < entries_.size());
+        return entries_[id].name;
+    }
+
+    std::span<notification_subscriber* const> subscribers(notification_channel_id id) const
+    {
+        BOOST_ASSERT(id < entries_.size());
+        return entries_[id].subscribers;
+    }
+
+    void add_subscriber(notification_channel_id id, notification_subscriber& sub)
+    {
+        BOOST_ASSERT(id < entries_.size());
+        entries_[id].subscribers.push_back(&sub);
+    }
+
+    void remove_subscriber(notification_channel_id id, notification_subscriber& sub)
+    {
+        BOOST_ASSERT(id < entries_.size());
+        auto& subs = entries_[id].subscribers;
+        auto it = std::find(subs.begin(), subs.end(), &sub);
+        BOOST_ASSERT(it != subs.end());
+        subs.erase(it);
+    }
+};
+
+}  // namespace nativepg::detail
+
+#endif
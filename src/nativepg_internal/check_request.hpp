@@ -13,6 +13,7 @@
 #include "nativepg/client_errc.hpp"
 #include "nativepg/request.hpp"
 #include "nativepg/responses/response_handler.hpp"
+#include "nativepg/type_registry.hpp"
 
 namespace nativepg::protocol::detail {
 
@@ -61,12 +62,19 @@ inline std::error_code check_request(const request& req)
     return {};
 }
 
-inline std::error_code setup_request(const request& req, response_handler_ref res)
+inline std::error_code setup_request(
+    const request& req,
+    response_handler_ref res,
+    const type_registry* types = nullptr
+)
 {
     // Check that the request is correctly formed
     if (auto ec_req = check_request(req))
         return ec_req;
 
+    // Give the handler access to the types known by the connection
+    res.set_type_registry(types);
+
     // Perform the response setup
     auto [ec, offset] = res.setup(req, 0u);
     if (ec)
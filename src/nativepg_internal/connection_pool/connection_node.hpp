@@ -142,6 +142,8 @@ public:
     )
         : params_(params), shared_st_(&shared_st), conn_(ctx)
     {
+        conn_.set_type_registry(params->types);
+
         // There is no explicit PING command, but sending a sync will cause
         // the server to answer with ready_for_query
         ping_req_.add(protocol::sync{});
@@ -0,0 +1,221 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_SRC_NATIVEPG_INTERNAL_COPY_FILE_SENDER_HPP
+#define NATIVEPG_SRC_NATIVEPG_INTERNAL_COPY_FILE_SENDER_HPP
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/protocol/detail/copy_in_buffer.hpp"
+
+#ifdef __linux__
+#include <sys/sendfile.h>
+#define NATIVEPG_HAS_SENDFILE
+#endif
+
+#define NATIVEPG_HAS_COPY_FROM_FILE
+
+namespace nativepg::detail {
+
+// Sends the contents of a file as COPY FROM STDIN data (see co_connection::copy_from_file).
+// Performs the file system calls, and tells the caller what to write to the connection's stream.
+// On Linux, regular files are sent with sendfile: we return the CopyData header to be written,
+// then the kernel transfers the body from the file to the socket, without copying it to user space.
+// The socket is non-blocking, so when its buffer is full, a small piece of the body is returned
+// to be written through the stream instead, which waits until the socket is writable.
+// Other files are read into a buffer, and each message is written with a single call.
+class copy_file_sender
+{
+public:
+    enum class result_type
+    {
+        write,  // Write data to the stream, then call next again
+        done,   // Write data (a CopyDone or a CopyFail), then finish with ec. If data is empty,
+                // the file couldn't be read in the middle of a message: the connection is unusable
+    };
+
+    struct result
+    {
+        result_type type;
+        std::span<const unsigned char> data;
+        std::error_code ec;
+    };
+
+    // The size of the pieces written through the stream when the socket buffer is full
+    static constexpr std::size_t resume_size = 4096u;
+
+    copy_file_sender(int fd, std::size_t chunk_size, protocol::detail::copy_in_buffer& copy_in)
+        : fd_(fd),
+          chunk_size_((std::clamp)(chunk_size, std::size_t(1u), protocol::detail::copy_data_max_size)),
+          copy_in_(&copy_in)
+    {
+#ifdef POSIX_FADV_SEQUENTIAL
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+#ifdef NATIVEPG_HAS_SENDFILE
+        struct stat st;
+        zero_copy_ = ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+#endif
+    }
+
+    // sock_fd is the connection's socket, used for sendfile. Pass -1 to always read into a buffer
+    result next(int sock_fd)
+    {
+#ifdef NATIVEPG_HAS_SENDFILE
+        if (zero_copy_ && sock_fd >= 0)
+            return next_zero_copy(sock_fd);
+#else
+        static_cast<void>(sock_fd);
+#endif
+        return next_buffered();
+    }
+
+private:
+    int fd_;
+    std::size_t chunk_size_;
+    protocol::detail::copy_in_buffer* copy_in_;
+    std::vector<unsigned char> buff_;
+#ifdef NATIVEPG_HAS_SENDFILE
+    bool zero_copy_{};
+    std::array<unsigned char, 5u> header_{};
+    std::size_t body_remaining_{};  // Bytes of the current message not sent yet
+#endif
+
+    static std::error_code last_error() { return {errno, std::system_category()}; }
+
+    result finish() { return {result_type::done, copy_in_->finish(), {}}; }
+
+    // Reading failed between messages, so the COPY can be aborted
+    result fail(std::error_code ec) { return {result_type::done, copy_in_->fail(ec.message()), ec}; }
+
+    // Reading failed after a message header was written. Nothing can be sent after it
+    static result fatal(std::error_code ec) { return {result_type::done, {}, ec}; }
+
+    std::span<unsigned char> prepare_buffer(std::size_t size)
+    {
+        if (buff_.size() < size)
+            buff_.resize(size);
+        return {buff_.data(), size};
+    }
+
+    // Returns -1 on error
+    std::ptrdiff_t read_some(std::span<unsigned char> to)
+    {
+        while (true)
+        {
+            const auto n = ::read(fd_, to.data(), to.size());
+            if (n >= 0 || errno != EINTR)
+                return n;
+        }
+    }
+
+    result next_buffered()
+    {
+        // The body is read right after the header, so each message is written with a single call
+        auto buff = prepare_buffer(5u + chunk_size_);
+        const auto n = read_some(buff.subspan(5u));
+        if (n < 0)
+            return fail(last_error());
+        if (n == 0)
+            return finish();
+
+        const auto size = static_cast<std::size_t>(n);
+        const auto header = protocol::detail::copy_data_header(size);
+        std::copy(header.begin(), header.end(), buff.begin());
+        return {result_type::write, buff.first(5u + size), {}};
+    }
+
+#ifdef NATIVEPG_HAS_SENDFILE
+    // Reads size bytes of the current message's body, to be written through the stream
+    result write_body(std::size_t size)
+    {
+        auto buff = prepare_buffer(size);
+        for (auto remaining = buff; !remaining.empty();)
+        {
+            const auto n = read_some(remaining);
+            if (n < 0)
+                return fatal(last_error());
+            if (n == 0)
+                return fatal(std::make_error_code(std::errc::io_error));  // the file was truncated
+            remaining = remaining.subspan(static_cast<std::size_t>(n));
+        }
+        body_remaining_ -= size;
+        return {result_type::write, buff, {}};
+    }
+
+    result next_zero_copy(int sock_fd)
+    {
+        // Start a message. The header must contain the exact body size, so use what's left in the file
+        if (body_remaining_ == 0u)
+        {
+            struct stat st;
+            const auto pos = ::lseek(fd_, 0, SEEK_CUR);
+            if (pos < 0 || ::fstat(fd_, &st) != 0)
+                return fail(last_error());
+            if (st.st_size <= pos)
+                return finish();
+            const auto file_remaining = static_cast<std::uint64_t>(st.st_size - pos);
+            body_remaining_ = static_cast<std::size_t>(
+                (std::min)(file_remaining, static_cast<std::uint64_t>(chunk_size_))
+            );
+            header_ = protocol::detail::copy_data_header(body_remaining_);
+            return {result_type::write, header_, {}};
+        }
+
+        // Send the body. sendfile updates the file offset, like read
+        while (body_remaining_ > 0u)
+        {
+            const auto n = ::sendfile(sock_fd, fd_, nullptr, body_remaining_);
+            if (n > 0)
+            {
+                body_remaining_ -= static_cast<std::size_t>(n);
+            }
+            else if (n == 0)
+            {
+                return fatal(std::make_error_code(std::errc::io_error));  // the file was truncated
+            }
+            else if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                // The socket buffer is full. The stream will wait until it has space
+                return write_body((std::min)(body_remaining_, resume_size));
+            }
+            else if (errno == EINVAL || errno == ENOSYS)
+            {
+                // This file doesn't support sendfile. Send this message's body and the rest of the file
+                // reading them into a buffer
+                zero_copy_ = false;
+                return write_body(body_remaining_);
+            }
+            else if (errno != EINTR)
+            {
+                return fatal(last_error());
+            }
+        }
+        return next_zero_copy(sock_fd);
+    }
+#endif
+};
+
+}  // namespace nativepg::detail
+
+#endif
+
+#endif
@@ -0,0 +1,167 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_SRC_NATIVEPG_INTERNAL_COPY_OUT_QUEUE_HPP
+#define NATIVEPG_SRC_NATIVEPG_INTERNAL_COPY_OUT_QUEUE_HPP
+
+#include <boost/assert.hpp>
+#include <boost/capy/ex/async_event.hpp>
+#include <boost/capy/io_task.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace nativepg::detail {
+
+// Buffers COPY OUT data between the task reading it from the server (the producer)
+// and the one writing it to a sink (the consumer), so that both can run concurrently.
+// Data is copied into a bounded set of buffers: one is being filled while the others
+// are waiting to be written or being written.
+class copy_out_queue
+{
+    using buffer_t = std::vector<unsigned char>;
+
+    std::size_t buffer_size_;
+    std::size_t max_buffers_;
+    std::size_t num_buffers_{};  // allocated so far
+    std::vector<buffer_t> free_;
+    std::vector<buffer_t> ready_;
+    std::vector<buffer_t> writing_;
+    buffer_t current_;
+    bool has_current_{};
+    bool finished_{};
+    boost::capy::async_event space_available_;
+    boost::capy::async_event data_available_;
+    boost::capy::async_event drained_;
+
+    bool can_get_buffer() const { return !free_.empty() || num_buffers_ < max_buffers_; }
+
+    void get_buffer()
+    {
+        if (free_.empty())
+        {
+            ++num_buffers_;
+            current_ = buffer_t();
+            current_.reserve(buffer_size_);
+        }
+        else
+        {
+            current_ = std::move(free_.back());
+            free_.pop_back();
+            current_.clear();
+        }
+        has_current_ = true;
+    }
+
+    void push_current()
+    {
+        ready_.push_back(std::move(current_));
+        has_current_ = false;
+        data_available_.set();
+    }
+
+public:
+    copy_out_queue(std::size_t max_buffers, std::size_t buffer_size)
+        : buffer_size_((std::max)(buffer_size, std::size_t(1u))),
+          max_buffers_((std::max)(max_buffers, std::size_t(2u)))
+    {
+    }
+
+    // Producer side. Copies data into buffers, waiting for one to be free if required
+    boost::capy::io_task<> append(std::span<const unsigned char> data)
+    {
+        while (!data.empty())
+        {
+            if (!has_current_)
+            {
+                while (!can_get_buffer())
+                {
+                    space_available_.clear();
+                    if (auto [ec] = co_await space_available_.wait(); ec)
+                        co_return {ec};
+                }
+                get_buffer();
+            }
+
+            const std::size_t n = (std::min)(data.size(), buffer_size_ - current_.size());
+            current_.insert(current_.end(), data.begin(), data.begin() + n);
+            data = data.subspan(n);
+            if (current_.size() == buffer_size_)
+                push_current();
+        }
+        co_return {};
+    }
+
+    // If the consumer has nothing to do, hand it the buffer being filled,
+    // rather than waiting for it to be full
+    void flush_if_idle()
+    {
+        if (has_current_ && !current_.empty() && ready_.empty() && writing_.empty())
+            push_current();
+    }
+
+    // No more data will be appended
+    void finish()
+    {
+        if (has_current_ && !current_.empty())
+            push_current();
+        finished_ = true;
+        data_available_.set();
+    }
+
+    // Waits until the consumer has written everything
+    boost::capy::io_task<> wait_drained()
+    {
+        while (!drained())
+        {
+            drained_.clear();
+            if (auto [ec] = co_await drained_.wait(); ec)
+                co_return {ec};
+        }
+        co_return {};
+    }
+
+    // Consumer side. Waits until there are buffers to write, or the producer finished
+    boost::capy::io_task<> wait_data()
+    {
+        while (ready_.empty() && !finished_)
+        {
+            data_available_.clear();
+            if (auto [ec] = co_await data_available_.wait(); ec)
+                co_return {ec};
+        }
+        co_return {};
+    }
+
+    // Takes all the buffers ready to be written. They must be returned with end_write
+    std::span<const buffer_t> start_write()
+    {
+        BOOST_ASSERT(writing_.empty());
+        writing_.swap(ready_);
+        return writing_;
+    }
+
+    void end_write()
+    {
+        for (auto& buff : writing_)
+            free_.push_back(std::move(buff));
+        writing_.clear();
+        space_available_.set();
+        if (drained())
+            drained_.set();
+    }
+
+    // Has all the data been written?
+    bool drained() const { return finished_ && ready_.empty() && writing_.empty(); }
+};
+
+}  // namespace nativepg::detail
+
+#endif
@@ -0,0 +1,131 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_HEALTH_MONITOR_HPP
+#define NATIVEPG_HEALTH_MONITOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+
+#include "nativepg/protocol/sync.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/check.hpp"
+#include "nativepg_internal/multiplexed_connection/multiplexer.hpp"
+
+namespace nativepg::detail {
+
+// The health check request. Queued at most once at a time
+struct ping_op : multiplexer_elem
+{
+    request req;
+    check handler;
+    bool queued{false};
+
+    ping_op() : multiplexer_elem{&req, &handler, &on_done}
+    {
+        // There is no explicit PING command, but sending a sync will cause
+        // the server to answer with ready_for_query
+        req.add(protocol::sync{});
+    }
+
+    ping_op(const ping_op&) = delete;
+    ping_op& operator=(const ping_op&) = delete;
+
+    static void on_done(multiplexer_elem& elm, std::error_code)
+    {
+        static_cast<ping_op&>(elm).queued = false;
+    }
+};
+
+// Decides when a multiplexed connection sends pings, and when it's considered dead
+// because requests are in flight but nothing arrives (Sans-IO).
+// The connection waits until next_check(), then calls check() and acts on its result
+class health_monitor
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    enum class action
+    {
+        none,     // Nothing to do
+        ping,     // A ping was added to the multiplexer. Wake up the writer
+        stalled,  // The connection looks dead. Tear it down
+    };
+
+    health_monitor() = default;
+    health_monitor(const health_monitor&) = delete;
+    health_monitor& operator=(const health_monitor&) = delete;
+
+    // Zero disables the corresponding check
+    void set_config(clock::duration ping_interval, clock::duration stall_timeout)
+    {
+        ping_interval_ = ping_interval;
+        stall_timeout_ = stall_timeout;
+    }
+
+    // To be called when the connection is established
+    void reset(clock::time_point now) { last_ping_ = last_progress_ = now; }
+
+    // To be called when bytes are received
+    void on_read(clock::time_point now) { last_progress_ = now; }
+
+    // To be called when a batch of requests is written. If nothing was in flight,
+    // the oldest request starts waiting for a response now
+    void on_write(bool was_idle, clock::time_point now)
+    {
+        if (was_idle)
+            last_progress_ = now;
+    }
+
+    // When check() should be called next, or time_point::max() if checks are disabled
+    clock::time_point next_check(const multiplexer& mpx, clock::time_point now) const
+    {
+        auto res = (clock::time_point::max)();
+        if (ping_interval_ > zero)
+            res = (std::min)(res, last_ping_ + ping_interval_);
+        if (stall_timeout_ > zero)
+            res = (std::min)(res, (mpx.in_flight_count() ? last_progress_ : now) + stall_timeout_);
+        return res;
+    }
+
+    action check(multiplexer& mpx, clock::time_point now)
+    {
+        // Requests are in flight but nothing arrives
+        if (stall_timeout_ > zero && mpx.in_flight_count() && now - last_progress_ >= stall_timeout_)
+            return action::stalled;
+
+        // Queue a ping, unless the previous one is still outstanding.
+        // The writer interleaves it with the other requests
+        if (ping_interval_ > zero && now - last_ping_ >= ping_interval_)
+        {
+            last_ping_ = now;
+            if (!ping_.queued)
+            {
+                ping_.queued = true;
+                mpx.add(ping_);
+                return action::ping;
+            }
+        }
+        return action::none;
+    }
+
+    bool ping_queued() const { return ping_.queued; }
+
+private:
+    static constexpr clock::duration zero = clock::duration::zero();
+
+    ping_op ping_;
+    clock::duration ping_interval_{};
+    clock::duration stall_timeout_{};
+    clock::time_point last_ping_;
+    clock::time_point last_progress_;  // Last time we received bytes or started waiting for them
+};
+
+}  // namespace nativepg::detail
+
+#endif
@@ -11,17 +11,19 @@
 #ifndef NATIVEPG_MULTIPLEXER_HPP
 #define NATIVEPG_MULTIPLEXER_HPP
 
-#include <boost/compat/function_ref.hpp>
+#include <boost/assert.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <deque>
+#include <limits>
 #include <optional>
 #include <span>
 #include <system_error>
 #include <vector>
 
 #include "nativepg/client_errc.hpp"
+#include "nativepg/multiplexed_stats.hpp"
 #include "nativepg/protocol/any_backend_message.hpp"
 #include "nativepg/protocol/read_response_fsm.hpp"
 #include "nativepg/request.hpp"
@@ -38,17 +40,28 @@ enum class multiplexer_elem_status
 {
     pending,
     in_flight,
-    abandoned_pending,
     abandoned_in_flight,
 };
 
+struct multiplexer_elem;
+
+// Invoked when the response to a request has been fully read, or the request fails.
+// A plain function pointer, so that completing requests doesn't require type erasure
+using multiplexer_done_fn = void (*)(multiplexer_elem&, std::error_code);
+
+// A node in the multiplexer queue. Nodes are owned by the caller (usually living in the
+// exec() coroutine frame) and linked intrusively, so adding requests doesn't allocate.
+// Nodes must outlive their time in the queue, or be removed from it by cancel()
 struct multiplexer_elem
 {
     const request* req;
     response_handler_ref res;
-    boost::compat::function_ref<void(std::error_code)> on_done;  // TODO: do we have any alternative?
+    multiplexer_done_fn on_done;
     multiplexer_elem_status status{multiplexer_elem_status::pending};
     std::size_t num_rfq{};  // Expected number of ready-for-query messages. Populated lazily
+    std::size_t size{};     // The size of the request's payload
+    multiplexer_elem* prev{};
+    multiplexer_elem* next{};
 };
 
 inline std::size_t get_expected_rfqs(std::span<const request_message_type> msgs)
@@ -72,31 +85,26 @@ class read_response_stream_fsm
     std::size_t remaining_rfq_{};
 
 public:
+    struct result
+    {
+        std::error_code ec;
+        bool done;  // The request has been fully processed and should be removed
+    };
+
     read_response_stream_fsm() = default;
 
     void reset() { status_ = status::initial; }
 
     bool is_reading() const { return status_ == status::reading; }
 
+    // Handles a message for elm, which must be the first request in flight
     [[nodiscard]]
-    std::error_code on_message(std::deque<multiplexer_elem>& elms, const protocol::any_backend_message& msg)
+    result on_message(const multiplexer_elem& elm, const protocol::any_backend_message& msg)
     {
         using protocol::read_response_fsm;
 
         if (status_ == status::initial)
         {
-            // We're starting a new message. Ignore any abandoned
-            // requests that are not expecting any message back
-            auto it = std::ranges::find_if(elms, [](const multiplexer_elem& elm) {
-                return elm.status != multiplexer_elem_status::abandoned_pending;
-            });
-            elms.erase(elms.begin(), it);
-
-            // If we have no request, something went extremely wrong
-            if (elms.empty())
-                return std::error_code(client_errc::unmatched_request);
-            const auto& elm = elms.front();
-
             // Determine if we should care about responses or not
             if (elm.status == multiplexer_elem_status::abandoned_in_flight)
             {
@@ -118,16 +126,14 @@ public:
                 // Handle the message
                 auto res = fsm_->resume(msg);
 
-                // If the FSM terminates, it means we're done with this request
+                // If the FSM terminates, it means we're done with this request.
+                // Any errors here are protocol violations and should cause connection teardown
                 if (res.type == read_response_fsm::result_type::done)
                 {
-                    elms.front().on_done(res.ec);
-                    elms.pop_front();
                     status_ = status::initial;
+                    return {res.ec, true};
                 }
-
-                // Any errors here are protocol violations and should cause connection teardown
-                return res.ec;
+                return {{}, false};
             }
             case status::ignoring:
             {
@@ -136,12 +142,12 @@ public:
                 if (msg.type() == protocol::any_backend_message::kind::ready_for_query &&
                     --remaining_rfq_ == 0u)
                 {
-                    elms.pop_front();
                     status_ = status::initial;
+                    return {{}, true};
                 }
-                return {};
+                return {{}, false};
             }
-            default: BOOST_ASSERT(false); return std::error_code(client_errc::unmatched_request);
+            default: BOOST_ASSERT(false); return {client_errc::unmatched_request, false};
         }
     }
 
@@ -157,84 +163,130 @@ class multiplexer
 {
 public:
     multiplexer() = default;
+    multiplexer(const multiplexer&) = delete;
+    multiplexer& operator=(const multiplexer&) = delete;
 
-    // Adds a request. To be called by execute
-    multiplexer_elem* add(
-        const request* req,
-        response_handler_ref res,
-        boost::compat::function_ref<void(std::error_code)> on_done
-    )
+    // Adds a request. To be called by execute. elem is owned by the caller,
+    // and must have been initialized with the request, handler and completion function
+    void add(multiplexer_elem& elem)
     {
-        elems_.push_back({req, res, on_done});
-        ++num_pending_;
-        return &elems_.back();
+        BOOST_ASSERT(elem.req != nullptr);
+        BOOST_ASSERT(elem.on_done != nullptr);
+        elem.status = multiplexer_elem_status::pending;
+        elem.size = elem.req->payload_size();
+        push_back(elem);
+        if (first_pending_ == nullptr)
+            first_pending_ = &elem;
+        ++pending_count_;
+        pending_bytes_ += elem.size;
     }
 
-    void cancel(multiplexer_elem* elem)
+    // Removes a request from the queue. Once this returns, the multiplexer no longer references elem
+    void cancel(multiplexer_elem& elem)
     {
-        BOOST_ASSERT(elem != nullptr);
-        BOOST_ASSERT(!elems_.empty());
-
-        switch (elem->status)
+        switch (elem.status)
         {
             case multiplexer_elem_status::pending:
             {
-                // The request hasn't been written yet.
-                // Mark it as abandoned and it will be ignored and removed when possible
-                elem->status = multiplexer_elem_status::abandoned_pending;
+                // The request hasn't been written yet. Just remove it
+                if (first_pending_ == &elem)
+                    first_pending_ = elem.next;
+                unlink(elem);
+                --pending_count_;
+                pending_bytes_ -= elem.size;
                 break;
             }
             case multiplexer_elem_status::in_flight:
             {
                 // We've sent this request. We need to keep enough info to identify
-                // the responses for this request and discard them.
+                // the responses for this request and discard them. The caller's node
+                // is replaced by one we own, since the caller is about to release it.
+                // It keeps occupying the in-flight window until the responses arrive.
                 // The process differs if we've already read part of the response
-                elem->status = multiplexer_elem_status::abandoned_in_flight;
-                if (elem == &elems_.front() && fsm_.is_reading())
+                auto& tombstone = acquire_tombstone();
+                tombstone.size = elem.size;
+                if (&elem == head_ && fsm_.is_reading())
                     fsm_.abandon_current();
                 else
-                    elem->num_rfq = get_expected_rfqs(elem->req->messages());
+                    tombstone.num_rfq = get_expected_rfqs(elem.req->messages());
+                replace(elem, tombstone);
                 break;
             }
             default: BOOST_ASSERT(false); break;
         }
+    }
+
+    // The number of requests and bytes waiting to be written, excluding cancelled requests
+    bool has_pending() const { return first_pending_ != nullptr; }
+    std::size_t pending_count() const { return pending_count_; }
+    std::size_t pending_bytes() const { return pending_bytes_; }
+
+    // The number of requests and bytes written whose responses haven't been fully read yet
+    std::size_t in_flight_count() const { return in_flight_count_; }
+    std::size_t in_flight_bytes() const { return in_flight_bytes_; }
+
+    // Limits the requests prepare_write moves to in-flight. A request is always
+    // allowed when nothing is in flight, so requests bigger than the window make progress
+    void set_in_flight_limits(std::size_t max_requests, std::size_t max_bytes)
+    {
+        max_in_flight_count_ = max_requests;
+        max_in_flight_bytes_ = max_bytes;
+    }
 
-        // In any case, clean up other data members, just in case
-        elem->req = nullptr;
-        elem->res = &null_handler_;
-        elem->on_done = &ignore;
+    // Would prepare_write return a non-empty batch?
+    bool can_write() const
+    {
+        return first_pending_ != nullptr && fits_in_flight_window(first_pending_->size);
     }
 
-    std::span<const unsigned char> prepare_write()
+    // Counters describing the batches returned by prepare_write
+    const multiplexed_stats& stats() const { return stats_; }
+
+    // Composes a batch with pending requests, in order. Requests are added while the batch
+    // doesn't exceed max_size bytes and the in-flight limits allow it. A request bigger than
+    // max_size is written on its own. Requests that don't fit remain pending
+    std::span<const unsigned char> prepare_write(
+        std::size_t max_size = (std::numeric_limits<std::size_t>::max)()
+    )
     {
         write_buffer_.clear();
+        std::size_t num_written = 0u;
 
-        // Go over all pending elements, add them to the write buffer, and mark them as in-progress
+        // Go over pending elements, add them to the write buffer, and mark them as in-progress.
+        // Cancelled requests have already been removed, so all of them are healthy.
         // TODO: ideally, we shouldn't need to copy the payload, but cancellations get much trickier
-        for (auto& elm : pending_requests())
+        for (; first_pending_ != nullptr; first_pending_ = first_pending_->next)
         {
-            switch (elm.status)
-            {
-                case multiplexer_elem_status::pending:
-                {
-                    // Healthy request
-                    BOOST_ASSERT(elm.req);
-                    auto payload = elm.req->payload();
-                    write_buffer_.insert(write_buffer_.end(), payload.begin(), payload.end());
-                    elm.status = multiplexer_elem_status::in_flight;
-                    break;
-                }
-                case multiplexer_elem_status::abandoned_pending:
-                {
-                    // The request was cancelled before being written, ignore it
-                    break;
-                }
-                default: BOOST_ASSERT(false); break;
-            }
+            auto& elm = *first_pending_;
+            BOOST_ASSERT(elm.status == multiplexer_elem_status::pending);
+
+            // Leave the request for the next batch if it doesn't fit
+            if (!write_buffer_.empty() && elm.size > max_size - write_buffer_.size())
+                break;
+            if (!fits_in_flight_window(elm.size))
+                break;
+
+            // Borrowed parameters are copied here, too. The caller may release
+            // their memory as soon as the request is cancelled, even mid-write
+            elm.req->for_each_payload_segment([this](std::span<const unsigned char> seg) {
+                write_buffer_.insert(write_buffer_.end(), seg.begin(), seg.end());
+            });
+            elm.status = multiplexer_elem_status::in_flight;
+            --pending_count_;
+            pending_bytes_ -= elm.size;
+            ++in_flight_count_;
+            in_flight_bytes_ += elm.size;
+            ++num_written;
         }
 
-        // All the elements are now in-progress
-        num_pending_ = 0u;
+        if (num_written)
+        {
+            ++stats_.writes;
+            stats_.requests_written += num_written;
+            stats_.bytes_written += write_buffer_.size();
+            stats_.max_requests_per_write = (std::max)(stats_.max_requests_per_write, num_written);
+            stats_.max_bytes_per_write = (std::max)(stats_.max_bytes_per_write, write_buffer_.size());
+        }
 
         return write_buffer_;
     }
@@ -252,8 +304,26 @@ public:
             default: break;
         }
 
-        // The message is supposed to belong to a request, handle it
-        return fsm_.on_message(elems_, msg);
+        // The message is supposed to belong to the first request in flight.
+        // If we have no such request, something went extremely wrong
+        if (head_ == nullptr || head_ == first_pending_)
+            return client_errc::unmatched_request;
+        auto& elm = *head_;
+        auto res = fsm_.on_message(elm, msg);
+        if (!res.done)
+            return res.ec;
+
+        // The request is complete and leaves the in-flight window.
+        // Remove it before notifying, since this may release the node
+        BOOST_ASSERT(in_flight_count_ > 0u);
+        --in_flight_count_;
+        in_flight_bytes_ -= elm.size;
+        unlink(elm);
+        if (elm.status == multiplexer_elem_status::abandoned_in_flight)
+            release_tombstone(elm);
+        else
+            elm.on_done(elm, res.ec);
+        return res.ec;
     }
 
     // To be called when connection is lost.
@@ -261,40 +331,107 @@ public:
     // and resets state
     void cleanup()
     {
-        // Cancel all the requests
-        for (auto& elm : in_flight_requests())
-            elm.on_done(std::make_error_code(std::errc::operation_canceled));
-
-        // Remove them
-        elems_.erase(elems_.begin(), elems_.begin() + pending_offset());
+        // Remove and cancel all the requests
+        while (head_ != nullptr && head_ != first_pending_)
+        {
+            auto& elm = *head_;
+            unlink(elm);
+            if (elm.status == multiplexer_elem_status::abandoned_in_flight)
+                release_tombstone(elm);
+            else
+                elm.on_done(elm, std::make_error_code(std::errc::operation_canceled));
+        }
 
         // Clean up state
         fsm_.reset();
+        in_flight_count_ = 0u;
+        in_flight_bytes_ = 0u;
     }
 
 private:
     std::vector<unsigned char> write_buffer_;
-    std::deque<multiplexer_elem> elems_;
+    multiplexer_elem* head_{};           // In-flight requests go first...
+    multiplexer_elem* first_pending_{};  // ...followed by pending ones
+    multiplexer_elem* tail_{};
+    std::deque<multiplexer_elem> tombstones_;  // Stand-ins for cancelled in-flight requests
+    multiplexer_elem* free_tombstones_{};      // Singly linked through next
     check null_handler_;
-    std::size_t num_pending_{};
+    std::size_t pending_count_{};
+    std::size_t pending_bytes_{};
+    std::size_t in_flight_count_{};
+    std::size_t in_flight_bytes_{};
+    std::size_t max_in_flight_count_{(std::numeric_limits<std::size_t>::max)()};
+    std::size_t max_in_flight_bytes_{(std::numeric_limits<std::size_t>::max)()};
+    multiplexed_stats stats_;
     read_response_stream_fsm fsm_;
 
-    inline static void ignore(std::error_code) {}
+    bool fits_in_flight_window(std::size_t size) const
+    {
+        if (in_flight_count_ == 0u)
+            return true;
+        return in_flight_count_ < max_in_flight_count_ && in_flight_bytes_ <= max_in_flight_bytes_ &&
+               size <= max_in_flight_bytes_ - in_flight_bytes_;
+    }
+
+    void push_back(multiplexer_elem& elem)
+    {
+        elem.prev = tail_;
+        elem.next = nullptr;
+        if (tail_)
+            tail_->next = &elem;
+        else
+            head_ = &elem;
+        tail_ = &elem;
+    }
+
+    void unlink(multiplexer_elem& elem)
+    {
+        if (elem.prev)
+            elem.prev->next = elem.next;
+        else
+            head_ = elem.next;
+        if (elem.next)
+            elem.next->prev = elem.prev;
+        else
+            tail_ = elem.prev;
+        elem.prev = elem.next = nullptr;
+    }
 
-    // Gets the offset in the deque where the pending requests start
-    std::size_t pending_offset() const { return elems_.size() - num_pending_; }
+    // Puts to in the position that from occupies in the queue
+    void replace(multiplexer_elem& from, multiplexer_elem& to)
+    {
+        to.prev = from.prev;
+        to.next = from.next;
+        if (to.prev)
+            to.prev->next = &to;
+        else
+            head_ = &to;
+        if (to.next)
+            to.next->prev = &to;
+        else
+            tail_ = &to;
+        from.prev = from.next = nullptr;
+    }
 
-    // Gets a view containing all the pending requests. They are at the end
-    // of the queue.
-    std::ranges::subrange<std::deque<multiplexer_elem>::iterator> pending_requests()
+    // Tombstones are recycled, so cancellations only allocate
+    // when more in-flight requests are cancelled than ever before
+    multiplexer_elem& acquire_tombstone()
     {
-        return std::ranges::subrange(elems_.begin() + pending_offset(), elems_.end());
+        multiplexer_elem* res = free_tombstones_;
+        if (res)
+            free_tombstones_ = res->next;
+        else
+            res = &tombstones_.emplace_back(nullptr, &null_handler_, nullptr);
+        res->status = multiplexer_elem_status::abandoned_in_flight;
+        res->num_rfq = 0u;
+        res->prev = res->next = nullptr;
+        return *res;
     }
 
-    // Same, for in-flight requests
-    std::ranges::subrange<std::deque<multiplexer_elem>::iterator> in_flight_requests()
+    void release_tombstone(multiplexer_elem& elem)
     {
-        return std::ranges::subrange(elems_.begin(), elems_.begin() + pending_offset());
+        elem.next = free_tombstones_;
+        free_tombstones_ = &elem;
     }
 };
 
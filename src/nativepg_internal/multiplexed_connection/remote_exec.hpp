@@ -0,0 +1,140 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_REMOTE_EXEC_HPP
+#define NATIVEPG_REMOTE_EXEC_HPP
+
+#include <cstddef>
+#include <system_error>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/response_handler.hpp"
+#include "nativepg/type_registry.hpp"
+#include "nativepg_internal/check_request.hpp"
+#include "nativepg_internal/multiplexed_connection/multiplexer.hpp"
+#include "nativepg_internal/multiplexed_connection/submission_queue.hpp"
+
+namespace nativepg::detail {
+
+// A request executed from outside the connection's execution context. Owned by the caller.
+// The connection owns it from submission until it notifies the caller, either completing it
+// or acknowledging its cancellation. notify is called in the connection's context,
+// and should post the notification to the caller's one
+struct remote_exec_node : multiplexer_elem, submission_node
+{
+    enum class notification
+    {
+        done,         // The request completed with result_ec
+        cancel_done,  // The connection no longer references the request
+    };
+
+    using notify_fn = void (*)(remote_exec_node&, notification);
+
+    notify_fn notify;
+    std::error_code result_ec;
+    bool done_posted{false};  // Has the done notification been posted?
+
+    remote_exec_node(const request& req, response_handler_ref handler, notify_fn notify)
+        : multiplexer_elem{&req, handler, &on_done}, notify(notify)
+    {
+    }
+
+    static void on_done(multiplexer_elem& elm, std::error_code ec)
+    {
+        auto& self = static_cast<remote_exec_node&>(elm);
+        self.result_ec = ec;
+        self.done_posted = true;
+        self.notify(self, notification::done);
+    }
+};
+
+// Hands requests from other threads to a multiplexed connection, and decides what
+// happens to them in the connection's context (Sans-IO). The connection opens the queue
+// once it can be woken up, drains it when submit() asks to, and runs cancel()
+// when a caller whose request couldn't be withdrawn asks to
+class remote_exec_queue
+{
+    submission_inbox inbox_;
+
+    // Performs the checks that exec() does for local requests, which require the connection's state
+    static bool add(
+        submission_node* node,
+        multiplexer& mpx,
+        std::size_t max_queued_requests,
+        const type_registry* types
+    )
+    {
+        if (node == nullptr)
+            return false;
+
+        while (node != nullptr)
+        {
+            auto& op = static_cast<remote_exec_node&>(*node);
+            node = node->next_submission;  // op may be completed below
+
+            if (auto req_ec = protocol::detail::setup_request(*op.req, op.res, types))
+                remote_exec_node::on_done(op, req_ec);
+            else if (mpx.pending_count() >= max_queued_requests)
+                remote_exec_node::on_done(op, client_errc::queue_full);
+            else
+                mpx.add(op);
+        }
+        return true;
+    }
+
+public:
+    remote_exec_queue() = default;
+    remote_exec_queue(const remote_exec_queue&) = delete;
+    remote_exec_queue& operator=(const remote_exec_queue&) = delete;
+
+    // Caller side, any thread. Returns true if the connection should be woken up to drain the queue
+    bool submit(remote_exec_node& op)
+    {
+        return inbox_.push(op) == submission_inbox::push_result::queued_first;
+    }
+
+    // Caller side, on cancellation. Returns true if the connection hasn't taken op,
+    // which can be released right away. Otherwise, the queue is open,
+    // and the connection must be asked to cancel op
+    bool withdraw(remote_exec_node& op) { return inbox_.withdraw(op); }
+
+    bool is_open() const { return inbox_.is_open(); }
+
+    // Connection side, once. Moves the requests submitted before to the multiplexer.
+    // Returns true if there were any, in which case the writer should be woken up
+    bool open(multiplexer& mpx, std::size_t max_queued_requests, const type_registry* types)
+    {
+        return add(inbox_.open(), mpx, max_queued_requests, types);
+    }
+
+    // Connection side. Moves the submitted requests to the multiplexer. Same return value as open
+    bool drain(multiplexer& mpx, std::size_t max_queued_requests, const type_registry* types)
+    {
+        return add(inbox_.take_all(), mpx, max_queued_requests, types);
+    }
+
+    // Connection side. op may still be queued, so drain first (same return value as drain).
+    // op may have completed before we got here, in which case there's nothing to cancel
+    bool cancel(
+        remote_exec_node& op,
+        multiplexer& mpx,
+        std::size_t max_queued_requests,
+        const type_registry* types
+    )
+    {
+        bool res = drain(mpx, max_queued_requests, types);
+        if (!op.done_posted)
+            mpx.cancel(op);
+        op.notify(op, remote_exec_node::notification::cancel_done);
+        return res;
+    }
+};
+
+}  // namespace nativepg::detail
+
+#endif
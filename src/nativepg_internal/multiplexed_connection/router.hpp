@@ -0,0 +1,53 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_MULTIPLEXED_ROUTER_HPP
+#define NATIVEPG_MULTIPLEXED_ROUTER_HPP
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+
+#include "nativepg/multiplexed_routing.hpp"
+
+namespace nativepg::detail {
+
+// Chooses the connection a request is sent to, among size candidates.
+// load(i) returns the number of bytes the i-th candidate has outstanding.
+// start should change between calls (e.g. a counter), so ties and round-robin spread the work
+template <class LoadFn>
+std::size_t select_connection(multiplexed_routing routing, std::size_t size, std::size_t start, LoadFn&& load)
+{
+    BOOST_ASSERT(size > 0u);
+
+    switch (routing)
+    {
+        case multiplexed_routing::least_loaded:
+        {
+            // Ties are broken round-robin, so idle connections share the work
+            std::size_t res = start % size;
+            std::size_t res_load = load(res);
+            for (std::size_t i = 1u; i < size; ++i)
+            {
+                std::size_t candidate = (start + i) % size;
+                std::size_t candidate_load = load(candidate);
+                if (candidate_load < res_load)
+                {
+                    res = candidate;
+                    res_load = candidate_load;
+                }
+            }
+            return res;
+        }
+        case multiplexed_routing::round_robin:
+        default: return start % size;
+    }
+}
+
+}  // namespace nativepg::detail
+
+#endif
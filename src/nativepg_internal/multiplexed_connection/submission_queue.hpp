@@ -0,0 +1,158 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_SUBMISSION_QUEUE_HPP
+#define NATIVEPG_SUBMISSION_QUEUE_HPP
+
+#include <atomic>
+#include <mutex>
+
+namespace nativepg::detail {
+
+// A node in the submission queue. Owned by the producer, like multiplexer_elem
+struct submission_node
+{
+    submission_node* next_submission{};
+    bool parked{};  // Is it in submission_inbox's parked list? Guarded by its mutex
+};
+
+// Hands requests from any thread to the thread running a multiplexed connection.
+// Multiple producers, single consumer, lock-free. Producers push nodes one by one,
+// and the consumer takes all of them at once, so the atomic operations are amortized
+// over a batch. The consumer is the only one removing nodes, so there is no ABA problem.
+// Operations are sequentially consistent, so producers can reason about
+// the consumer's state (see co_multiplexed_connection)
+class submission_queue
+{
+    std::atomic<submission_node*> head_{nullptr};  // Most recently pushed node
+
+public:
+    submission_queue() = default;
+    submission_queue(const submission_queue&) = delete;
+    submission_queue& operator=(const submission_queue&) = delete;
+
+    // Any thread. Returns true if the queue was empty, in which case the consumer
+    // might not be aware of the submission, and should be woken up
+    bool push(submission_node& node) noexcept
+    {
+        auto* old = head_.load(std::memory_order_relaxed);
+        do
+        {
+            node.next_submission = old;
+        } while (!head_.compare_exchange_weak(old, &node));
+        return old == nullptr;
+    }
+
+    // Consumer only. Removes all nodes, returning them as a list in submission order
+    submission_node* take_all() noexcept
+    {
+        // Check first, so that polling an empty queue doesn't write to the cache line
+        if (head_.load() == nullptr)
+            return nullptr;
+
+        // Nodes were pushed at the front, so reverse them
+        submission_node* node = head_.exchange(nullptr);
+        submission_node* res = nullptr;
+        while (node)
+        {
+            auto* next = node->next_submission;
+            node->next_submission = res;
+            res = node;
+            node = next;
+        }
+        return res;
+    }
+};
+
+// A submission_queue whose consumer may not have started yet. Submissions made before
+// the consumer starts (calling open) can't wake it up, and may be cancelled before it
+// ever runs. They are parked in a list protected by a mutex, from which they can be withdrawn.
+// Once open, submissions go through the lock-free queue, and can only be cancelled by the consumer
+class submission_inbox
+{
+    submission_queue queue_;
+    std::atomic<bool> open_{false};
+    std::mutex mtx_;
+    submission_node* parked_first_{};
+    submission_node* parked_last_{};
+
+public:
+    enum class push_result
+    {
+        parked,        // The consumer will get the node from open()
+        queued,        // The consumer will get the node from take_all()
+        queued_first,  // Same, but the queue was empty, so the consumer should be woken up
+    };
+
+    submission_inbox() = default;
+    submission_inbox(const submission_inbox&) = delete;
+    submission_inbox& operator=(const submission_inbox&) = delete;
+
+    // Any thread. Anything the consumer publishes before calling open()
+    // is visible to producers getting a result other than parked
+    push_result push(submission_node& node)
+    {
+        if (!open_.load())
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            if (!open_.load(std::memory_order_relaxed))
+            {
+                node.next_submission = nullptr;
+                node.parked = true;
+                if (parked_last_)
+                    parked_last_->next_submission = &node;
+                else
+                    parked_first_ = &node;
+                parked_last_ = &node;
+                return push_result::parked;
+            }
+        }
+        return queue_.push(node) ? push_result::queued_first : push_result::queued;
+    }
+
+    // The producer that pushed node. Removes it if it's still parked, returning true.
+    // Otherwise, the consumer has or will take it, and false is returned
+    bool withdraw(submission_node& node)
+    {
+        if (open_.load())
+            return false;
+
+        std::lock_guard<std::mutex> lock(mtx_);
+        if (!node.parked)
+            return false;
+        submission_node* prev = nullptr;
+        for (auto* it = parked_first_; it != &node; it = it->next_submission)
+            prev = it;
+        (prev ? prev->next_submission : parked_first_) = node.next_submission;
+        if (parked_last_ == &node)
+            parked_last_ = prev;
+        node.parked = false;
+        return true;
+    }
+
+    bool is_open() const { return open_.load(); }
+
+    // Consumer only, once. Returns the parked nodes, in submission order.
+    // Further submissions go to the queue
+    submission_node* open()
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        for (auto* it = parked_first_; it != nullptr; it = it->next_submission)
+            it->parked = false;
+        auto* res = parked_first_;
+        parked_first_ = parked_last_ = nullptr;
+        open_.store(true);
+        return res;
+    }
+
+    // Consumer only. Removes all queued nodes, returning them as a list in submission order
+    submission_node* take_all() noexcept { return queue_.take_all(); }
+};
+
+}  // namespace nativepg::detail
+
+#endif
@@ -0,0 +1,195 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_NOTIFICATION_BUFFER_HPP
+#define NATIVEPG_NOTIFICATION_BUFFER_HPP
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "nativepg/notification_batch.hpp"
+#include "nativepg/notification_event.hpp"
+
+namespace nativepg::detail {
+
+// Stores the notification events that haven't been read by a consumer yet,
+// applying the overflow policy. Sans-IO: notification_queue adds the waiting.
+// Payloads are appended to a single buffer, which is handed to the consumer
+// together with the events. Channels are interned by the caller. The names of channels
+// that are not (no_channel_id) are copied to the buffer, too
+class notification_buffer
+{
+    using clock = std::chrono::steady_clock;
+    static constexpr std::size_t no_overflow = static_cast<std::size_t>(-1);
+
+    std::size_t max_pending_;
+    notification_overflow_policy policy_;
+    notification_batch pending_;
+    std::size_t overflow_begin_{no_overflow};  // Overflow events are stored after this offset
+    clock::time_point oldest_;                 // When the first event in pending_ was added
+    notification_stats stats_;
+
+    std::vector<notification_record>& records() { return pending_.records_; }
+
+    // Appends data to the batch's buffer, returning its offset
+    std::size_t store(std::string_view data)
+    {
+        auto& buff = pending_.payloads_;
+        std::size_t offset = buff.size();
+        buff.insert(buff.end(), data.begin(), data.end());
+        return offset;
+    }
+
+    notification_record make_record(
+        notification_event_type type,
+        std::int32_t backend_pid,
+        notification_channel_id channel_id,
+        std::string_view channel
+    )
+    {
+        notification_record res{type, backend_pid, channel_id, {}, 0u, 0u, 0u, 0u, 0u};
+        if (channel_id == no_channel_id)
+        {
+            res.channel_offset = store(channel);
+            res.channel_size = channel.size();
+        }
+        else
+        {
+            res.channel = channel;
+        }
+        return res;
+    }
+
+    void add_record(const notification_record& rec, clock::time_point now)
+    {
+        if (records().empty())
+            oldest_ = now;
+        records().push_back(rec);
+        stats_.max_queued = (std::max)(stats_.max_queued, records().size());
+    }
+
+    void add_event(notification_event_type type, clock::time_point now)
+    {
+        add_record({type, 0, 0u, {}, 0u, 0u, 0u, 0u, 0u}, now);
+    }
+
+    // Records that a notification to a channel was discarded. All discarded notifications
+    // to a channel are coalesced into a single event, so memory usage stays bounded
+    void add_overflow(notification_channel_id channel_id, std::string_view channel, clock::time_point now)
+    {
+        ++stats_.dropped;
+
+        // Only overflow, connect and disconnect events are added once the buffer is full,
+        // so the search is limited to a few events
+        if (overflow_begin_ == no_overflow)
+            overflow_begin_ = records().size();
+        auto first = records().begin() + static_cast<std::ptrdiff_t>(overflow_begin_);
+        auto it = std::find_if(first, records().end(), [&](const notification_record& rec) {
+            return rec.type == notification_event_type::overflow && rec.channel_id == channel_id &&
+                   (channel_id != no_channel_id || pending_.channel_name(rec) == channel);
+        });
+        if (it != records().end())
+        {
+            ++it->num_dropped;
+        }
+        else
+        {
+            auto rec = make_record(notification_event_type::overflow, 0, channel_id, channel);
+            rec.num_dropped = 1u;
+            add_record(rec, now);
+        }
+    }
+
+public:
+    notification_buffer(std::size_t max_pending, notification_overflow_policy policy)
+        : max_pending_(max_pending), policy_(policy)
+    {
+        BOOST_ASSERT(max_pending > 0u);
+    }
+
+    void set_max_pending(std::size_t value)
+    {
+        BOOST_ASSERT(value > 0u);
+        max_pending_ = value;
+    }
+    void set_policy(notification_overflow_policy policy) { policy_ = policy; }
+
+    bool empty() const { return pending_.empty(); }
+    bool has_space() const { return pending_.size() < max_pending_; }
+    const notification_stats& stats() const { return stats_; }
+
+    // Connects and disconnects are not subject to the size limit
+    void add_connect(clock::time_point now) { add_event(notification_event_type::connect, now); }
+    void add_disconnect(clock::time_point now)
+    {
+        // If the last element is a connect, instead of adding a disconnect,
+        // we can just remove the connect. For most purposes (e.g. cache invalidation),
+        // keeping track of every reconnection is not required. Doing this avoids
+        // unbound memory consumption if the user is not reading notifications.
+        // TODO: I think we could avoid losing information by storing connects/disconnects
+        // in a 'compressed' format (e.g. store the int 5 if 5 connect/disconnect cycles happen)
+        // But this would require having != formats in pending_ and the output buffer
+        if (!records().empty() && records().back().type == notification_event_type::connect)
+            records().pop_back();
+        else
+            add_event(notification_event_type::disconnect, now);
+    }
+
+    // Adds a notification, applying the overflow policy if the buffer is full.
+    // Unless channel_id is no_channel_id, channel must point to storage that outlives
+    // the consumer's batches.
+    // Returns false if the notification was not added and the caller should wait for space
+    bool add_notify(
+        std::int32_t backend_pid,
+        notification_channel_id channel_id,
+        std::string_view channel,
+        std::string_view payload,
+        clock::time_point now
+    )
+    {
+        if (!has_space())
+        {
+            if (policy_ == notification_overflow_policy::block)
+                return false;
+            ++stats_.received;
+            add_overflow(channel_id, channel, now);
+            return true;
+        }
+
+        ++stats_.received;
+        auto rec = make_record(notification_event_type::notify, backend_pid, channel_id, channel);
+        rec.payload_offset = store(payload);
+        rec.payload_size = payload.size();
+        add_record(rec, now);
+        return true;
+    }
+
+    // Moves all events to output, replacing its contents.
+    // The memory held by output is reused for the next events
+    void take(notification_batch& output, clock::time_point now)
+    {
+        if (!pending_.empty())
+        {
+            stats_.last_lag = now - oldest_;
+            stats_.max_lag = (std::max)(stats_.max_lag, stats_.last_lag);
+        }
+        std::swap(output, pending_);
+        pending_.clear();
+        overflow_begin_ = no_overflow;
+    }
+};
+
+}  // namespace nativepg::detail
+
+#endif
@@ -12,117 +12,277 @@
 #include <boost/capy/ex/async_event.hpp>
 #include <boost/capy/io_task.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "nativepg/notification_batch.hpp"
 #include "nativepg/notification_event.hpp"
 #include "nativepg/protocol/async.hpp"
+#include "nativepg_internal/channel_table.hpp"
+#include "nativepg_internal/notification_buffer.hpp"
 
 namespace nativepg::detail {
 
-// Handles notify events and backpressure in multiplexed connections
+class notification_queue;
+
+// A consumer of notifications. Each one has its own buffer and event,
+// so consumers only wake up for the channels they are interested in
+struct notification_subscriber
+{
+    notification_queue* queue;          // Null for the default subscriber
+    notification_channel_id channel{};  // Only if queue != nullptr
+    notification_buffer buffer;
+    boost::capy::async_event events_available;
+
+    notification_subscriber(
+        notification_queue* queue,
+        notification_channel_id channel,
+        std::size_t max_pending,
+        notification_overflow_policy policy
+    )
+        : queue(queue), channel(channel), buffer(max_pending, policy)
+    {
+    }
+
+    notification_subscriber(const notification_subscriber&) = delete;
+    notification_subscriber& operator=(const notification_subscriber&) = delete;
+
+    // Unregisters from the queue
+    ~notification_subscriber();
+};
+
+// Handles notify events and backpressure in multiplexed connections.
+// Notifications to channels with subscribers are delivered to them.
+// The rest are delivered to the default subscriber (read_notifications).
+// Connects and disconnects are delivered to everyone.
 class notification_queue
 {
+    channel_table channels_;
+    notification_subscriber default_;
+    notification_subscriber* default_ptr_{&default_};  // To form a span with the default subscriber
+    std::vector<notification_subscriber*> subscribers_;  // Excluding the default one
     std::size_t max_pending_;
-    std::vector<notification_event> pending_;
-    boost::capy::async_event events_available_;
-    boost::capy::async_event space_available_;
-    // TODO: we could avoid copies if the consumer task is waiting
+    notification_overflow_policy policy_;
+    boost::capy::async_event space_available_;  // Set when any consumer reads or leaves
+    std::size_t received_{};
+    notification_stats retired_stats_;  // Accumulated from destroyed subscribers
+    notification_batch scratch_;        // To implement the std::vector API
+
+    friend struct notification_subscriber;
 
-    bool has_space() const { return pending_.size() < max_pending_; }
+    static std::chrono::steady_clock::time_point now() { return std::chrono::steady_clock::now(); }
 
-    void add_event(notification_event&& evt)
+    static void accumulate(notification_stats& to, const notification_stats& from)
     {
-        pending_.push_back(std::move(evt));
-        if (!has_space())
-            space_available_.clear();
-        events_available_.set();
+        to.dropped += from.dropped;
+        to.max_queued = (std::max)(to.max_queued, from.max_queued);
+        to.last_lag = (std::max)(to.last_lag, from.last_lag);
+        to.max_lag = (std::max)(to.max_lag, from.max_lag);
     }
 
-    void do_add_notification(const protocol::notification_response& msg)
+    // The consumers that should receive a notification to the given channel
+    std::span<notification_subscriber* const> targets(notification_channel_id channel)
     {
-        add_event({
-            .type = notification_event_type::notify,
-            .backend_pid = msg.process_id,
-            .channel = std::string(msg.channel_name),
-            .payload = std::string(msg.payload),
-        });
+        if (channel == no_channel_id)
+            return {&default_ptr_, 1u};
+        auto subs = channels_.subscribers(channel);
+        if (subs.empty())
+            return {&default_ptr_, 1u};
+        return subs;
+    }
+
+    void on_unsubscribe(notification_subscriber& sub)
+    {
+        channels_.remove_subscriber(sub.channel, sub);
+        subscribers_.erase(std::find(subscribers_.begin(), subscribers_.end(), &sub));
+        accumulate(retired_stats_, sub.buffer.stats());
+
+        // The producer may be waiting for this subscriber to make space
+        space_available_.set();
+    }
+
+    template <class Fn>
+    void for_each_subscriber(Fn fn)
+    {
+        fn(default_);
+        for (auto* sub : subscribers_)
+            fn(*sub);
+    }
+
+    boost::capy::io_task<> read_batch(notification_subscriber& sub, notification_batch& output)
+    {
+        // Wait for messages, if required
+        while (sub.buffer.empty())
+        {
+            if (auto [ec] = co_await sub.events_available.wait(); ec)
+                co_return ec;
+        }
+
+        // Take the messages
+        sub.buffer.take(output, now());
+        sub.events_available.clear();
+        space_available_.set();
+
+        // Done
+        co_return {};
     }
 
 public:
-    notification_queue(std::size_t max_pending) : max_pending_(max_pending)
+    notification_queue(std::size_t max_pending, notification_overflow_policy policy)
+        : default_(nullptr, 0u, max_pending, policy), max_pending_(max_pending), policy_(policy)
     {
-        BOOST_ASSERT(max_pending > 0u);
         space_available_.set();
     }
 
+    notification_queue(const notification_queue&) = delete;
+    notification_queue& operator=(const notification_queue&) = delete;
+
+    // Subscriptions shouldn't outlive the connection. If they do, make their destruction harmless
+    ~notification_queue()
+    {
+        for (auto* sub : subscribers_)
+            sub->queue = nullptr;
+    }
+
+    // Applies to existing and future subscribers
+    void set_limits(std::size_t max_pending, notification_overflow_policy policy)
+    {
+        max_pending_ = max_pending;
+        policy_ = policy;
+        for_each_subscriber([=](notification_subscriber& sub) {
+            sub.buffer.set_max_pending(max_pending);
+            sub.buffer.set_policy(policy);
+        });
+    }
+
+    notification_stats stats() const
+    {
+        notification_stats res = retired_stats_;
+        res.received = received_;
+        accumulate(res, default_.buffer.stats());
+        for (const auto* sub : subscribers_)
+            accumulate(res, sub->buffer.stats());
+        return res;
+    }
+
+    // Creates a consumer for notifications to channel
+    std::unique_ptr<notification_subscriber> subscribe(std::string_view channel)
+    {
+        auto id = channels_.intern(channel);
+        auto res = std::make_unique<notification_subscriber>(this, id, max_pending_, policy_);
+        channels_.add_subscriber(id, *res);
+        subscribers_.push_back(res.get());
+        return res;
+    }
+
+    std::string_view channel_name(notification_channel_id id) const { return channels_.name(id); }
+
     // Producer side. Connects and disconnects are not subject to backpressure
-    void add_connect() { add_event({notification_event_type::connect}); }
+    void add_connect()
+    {
+        auto tp = now();
+        for_each_subscriber([tp](notification_subscriber& sub) {
+            sub.buffer.add_connect(tp);
+            sub.events_available.set();
+        });
+    }
+
     void add_disconnect()
     {
-        // If the last element is a connect, instead of adding a disconnect,
-        // we can just remove the connect. For most purposes (e.g. cache invalidation),
-        // keeping track of every reconnection is not required. Doing this avoids
-        // unbound memory consumption if the user is not reading notifications.
-        // TODO: I think we could avoid losing information by storing connects/disconnects
-        // in a 'compressed' format (e.g. store the int 5 if 5 connect/disconnect cycles happen)
-        // But this would require having != formats in pending_ and the output buffer
-        if (!pending_.empty() && pending_.back().type == notification_event_type::connect)
-        {
-            pending_.pop_back();
-            if (has_space())
-                space_available_.set();
-            if (pending_.empty())
-                events_available_.clear();
-        }
-        else
-        {
-            add_event({notification_event_type::disconnect});
-        }
+        // This may remove a connect event, rather than adding a disconnect
+        auto tp = now();
+        for_each_subscriber([tp](notification_subscriber& sub) {
+            sub.buffer.add_disconnect(tp);
+            if (sub.buffer.empty())
+                sub.events_available.clear();
+            else
+                sub.events_available.set();
+        });
+        space_available_.set();
     }
 
-    // Notifications are subject to backpressure
+    // Notifications are subject to the overflow policy. Returns false
+    // if a consumer's queue is full and the policy asks to wait for space
     bool try_add_notify(const protocol::notification_response& msg)
     {
-        if (!has_space())
+        // Channels that have never been subscribed to are not interned
+        auto id = channels_.find(msg.channel_name);
+        auto subs = targets(id);
+
+        // With the block policy, all consumers must have space
+        if (policy_ == notification_overflow_policy::block &&
+            !std::ranges::all_of(subs, [](const notification_subscriber* sub) {
+                return sub->buffer.has_space();
+            }))
+        {
             return false;
-        do_add_notification(msg);
+        }
+
+        // Deliver the notification. The names of interned channels are stored once, in the table.
+        // The rest are copied to the consumer's buffer
+        ++received_;
+        auto channel = id == no_channel_id ? msg.channel_name : channels_.name(id);
+        auto tp = now();
+        for (auto* sub : subs)
+        {
+            [[maybe_unused]] bool ok = sub->buffer.add_notify(msg.process_id, id, channel, msg.payload, tp);
+            BOOST_ASSERT(ok);
+            sub->events_available.set();
+        }
         return true;
     }
 
     boost::capy::io_task<> add_notify(const protocol::notification_response& msg)
     {
-        while (!has_space())
+        while (!try_add_notify(msg))
         {
+            space_available_.clear();
             if (auto [ec] = co_await space_available_.wait(); ec)
                 co_return ec;
         }
-
-        do_add_notification(msg);
         co_return {};
     }
 
-    // Consumer side
+    // Consumer side, for the default subscriber
+    boost::capy::io_task<> read_events(notification_batch& output) { return read_batch(default_, output); }
+
     boost::capy::io_task<> read_events(std::vector<notification_event>& output)
     {
-        // Wait for messages, if required
-        while (pending_.empty())
+        if (auto [ec] = co_await read_batch(default_, scratch_); ec)
+            co_return ec;
+        output.clear();
+        for (auto evt : scratch_)
         {
-            if (auto [ec] = co_await events_available_.wait(); ec)
-                co_return ec;
+            output.push_back({
+                .type = evt.type,
+                .backend_pid = evt.backend_pid,
+                .channel = std::string(evt.channel),
+                .payload = std::string(evt.payload),
+                .num_dropped = evt.num_dropped,
+            });
         }
-
-        // Take the messages
-        output.swap(pending_);
-        pending_.clear();
-        events_available_.clear();
-        space_available_.set();
-
-        // Done
         co_return {};
     }
+
+    // Consumer side, for subscriptions
+    boost::capy::io_task<> read_events(notification_subscriber& sub, notification_batch& output)
+    {
+        return read_batch(sub, output);
+    }
 };
 
+inline notification_subscriber::~notification_subscriber()
+{
+    if (queue)
+        queue->on_unsubscribe(*this);
+}
+
 }  // namespace nativepg::detail
 
 #endif
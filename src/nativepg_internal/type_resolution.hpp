@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef NATIVEPG_SRC_NATIVEPG_INTERNAL_TYPE_RESOLUTION_HPP
+#define NATIVEPG_SRC_NATIVEPG_INTERNAL_TYPE_RESOLUTION_HPP
+
+#include <boost/describe/class.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nativepg/parameter_ref.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/resultset_callback.hpp"
+#include "nativepg/type_registry.hpp"
+
+namespace nativepg::detail {
+
+// A row returned by the type lookup query
+struct type_lookup_row
+{
+    std::string name;
+    std::uint32_t oid;
+    std::uint32_t array_oid;
+};
+BOOST_DESCRIBE_STRUCT(type_lookup_row, (), (name, oid, array_oid))
+
+// Stores the looked up types into the registry
+struct type_lookup_callback
+{
+    type_registry* types;
+
+    void operator()(type_lookup_row&& row) const
+    {
+        types->add(row.name, static_cast<std::int32_t>(row.oid), static_cast<std::int32_t>(row.array_oid));
+    }
+};
+
+// Looks up the names pending in a registry, using a single query.
+// Names are resolved with to_regtype, which honors the search path and
+// returns NULL (rather than failing) for types that don't exist
+class type_resolution
+{
+    type_registry* types_;
+    std::vector<std::string> names_;
+    request req_;
+
+public:
+    explicit type_resolution(type_registry& types) : types_(&types)
+    {
+        for (std::string_view name : types.pending())
+            names_.emplace_back(name);
+        if (names_.empty())
+            return;
+
+        // SELECT ... FROM (VALUES ($1::text), ($2::text)) AS v(name) JOIN ...
+        std::string query = "SELECT v.name, t.oid, t.typarray FROM (VALUES ";
+        std::vector<parameter_ref> params;
+        params.reserve(names_.size());
+        for (std::size_t i = 0; i < names_.size(); ++i)
+        {
+            if (i != 0u)
+                query += ", ";
+            query += "($";
+            query += std::to_string(i + 1u);
+            query += "::text)";
+            params.emplace_back(names_[i]);
+        }
+        query += ") AS v(name) JOIN pg_type t ON t.oid = to_regtype(v.name)";
+
+        // The request copies the query and parameters
+        req_.add_query(query, params);
+    }
+
+    // Is there anything to look up?
+    bool empty() const { return names_.empty(); }
+
+    const request& get_request() const { return req_; }
+
+    resultset_callback_t<type_lookup_row, type_lookup_callback> handler() const
+    {
+        return resultset_callback_t<type_lookup_row, type_lookup_callback>{type_lookup_callback{types_}};
+    }
+
+    // Call after the request succeeded. Names that didn't yield a row
+    // don't exist, and shouldn't be looked up again
+    void on_success() const
+    {
+        for (const auto& name : names_)
+        {
+            if (types_->oid(name) == 0)
+                types_->add(name, 0, 0);
+        }
+    }
+};
+
+}  // namespace nativepg::detail
+
+#endif
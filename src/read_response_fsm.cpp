@@ -28,6 +28,8 @@ enum class read_response_fsm::state_t
     exec_copy_out_needs_command_complete,
     query_copy_out,
     query_copy_out_needs_command_complete,
+    query_copy_in,
+    query_copy_both,
 };
 
 read_response_fsm::result read_response_fsm::handle_error(const error_response& err)
@@ -145,6 +147,12 @@ read_response_fsm::result read_response_fsm::handle_execute(const any_backend_me
                     call_handler(row_description{});
                     state_ = state_t::exec_copy_out;
                     return result_type::read;
+                case kind::copy_in_response:
+                case kind::copy_both_response:
+                    // COPY FROM STDIN and replication are only supported in the simple protocol.
+                    // The server ignores the Sync we already sent while in COPY IN,
+                    // so we'd need to send another one after CopyDone
+                    return std::error_code(client_errc::copy_not_allowed);
                 case kind::error_response:
                     // An error finishes this message and makes the server skip everything until sync
                     return handle_error(msg.get_error_response());
@@ -241,6 +249,13 @@ read_response_fsm::result read_response_fsm::handle_query(const any_backend_mess
     //            copy_out_response
     //            any number of copy_data
     //            copy_done, followed by (command_complete or error_response), or error_response
+    //        or
+    //            copy_in_response (then the upper layers send the data)
+    //            command_complete or error_response
+    //        or
+    //            copy_both_response (replication. Both sides send data)
+    //            any number of copy_data
+    //            copy_done, followed by (command_complete or error_response), or error_response
     //    ready_for_query
     // or empty_query_response
     switch (state_)
@@ -259,6 +274,22 @@ read_response_fsm::result read_response_fsm::handle_query(const any_backend_mess
                     call_handler(row_description{});
                     state_ = state_t::query_copy_out;
                     return result_type::read;
+                case kind::copy_in_response:
+                    // Starts a COPY IN block. The upper layers send the data,
+                    // followed by CopyDone or CopyFail. The handler sees an empty resultset.
+                    if (!allow_copy_)
+                        return std::error_code(client_errc::copy_not_allowed);
+                    call_handler(row_description{});
+                    state_ = state_t::query_copy_in;
+                    return result_type::read;
+                case kind::copy_both_response:
+                    // Starts a CopyBoth block (START_REPLICATION). Data flows in both directions,
+                    // and is handled by the upper layers. The handler sees an empty resultset.
+                    if (!allow_copy_)
+                        return std::error_code(client_errc::copy_not_allowed);
+                    call_handler(row_description{});
+                    state_ = state_t::query_copy_both;
+                    return result_type::read;
                 case kind::error_response:
                     // An error should always be followed by ReadyForQuery
                     state_ = state_t::query_needs_ready;
@@ -325,6 +356,7 @@ read_response_fsm::result read_response_fsm::handle_query(const any_backend_mess
             }
             return std::error_code(client_errc::unexpected_message);
         case state_t::query_copy_out:
+        case state_t::query_copy_both:
         {
             switch (msg.type())
             {
@@ -337,7 +369,9 @@ read_response_fsm::result read_response_fsm::handle_query(const any_backend_mess
                     call_handler(msg.get_error_response());
                     return result_type::read;
                 case kind::copy_done:
-                    // Terminates copy out, but should be followed by CommandComplete
+                    // Terminates copy out, but should be followed by CommandComplete.
+                    // In CopyBoth, the server stops streaming, and the upper layers
+                    // should send a CopyDone, too, if they haven't done so yet
                     state_ = state_t::query_copy_out_needs_command_complete;
                     return result_type::read;
                 default: return std::error_code(client_errc::unexpected_message);
@@ -359,6 +393,25 @@ read_response_fsm::result read_response_fsm::handle_query(const any_backend_mess
                 default: return std::error_code(client_errc::unexpected_message);
             }
         }
+        case state_t::query_copy_in:
+        {
+            switch (msg.type())
+            {
+                case kind::error_response:
+                    // Either the data was rejected, or we sent CopyFail. The server may send this
+                    // while we're still sending data, and discards the rest of it.
+                    // An error should always be followed by ReadyForQuery
+                    state_ = state_t::query_needs_ready;
+                    call_handler(msg.get_error_response());
+                    return result_type::read;
+                case kind::command_complete:
+                    // The server received CopyDone and stored the data
+                    call_handler(msg.get_command_complete());
+                    state_ = state_t::query_first;
+                    return result_type::read;
+                default: return std::error_code(client_errc::unexpected_message);
+            }
+        }
         default: BOOST_ASSERT(false); return std::error_code(client_errc::unexpected_message);
     }
 }
@@ -0,0 +1,339 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/protocol/detail/serialization_context.hpp"
+#include "nativepg/protocol/pgoutput.hpp"
+#include "nativepg/protocol/replication.hpp"
+#include "parse_context.hpp"
+
+using namespace nativepg::protocol;
+using nativepg::client_errc;
+
+namespace {
+
+enum class replication_message_type : unsigned char
+{
+    xlog_data = 'w',
+    primary_keepalive = 'k',
+    standby_status_update = 'r',
+};
+
+enum class pgoutput_message_type : unsigned char
+{
+    begin = 'B',
+    commit = 'C',
+    origin = 'O',
+    relation = 'R',
+    type = 'Y',
+    insert = 'I',
+    update = 'U',
+    delete_ = 'D',
+    truncate = 'T',
+    logical_message = 'M',
+};
+
+// LSNs are unsigned, but the parse context only handles signed types
+std::uint64_t get_lsn(detail::parse_context& ctx)
+{
+    return static_cast<std::uint64_t>(ctx.get_integral<std::int64_t>());
+}
+
+// Checks that TupleData is valid, and returns a view over it
+pgoutput::tuple_data get_tuple_data(detail::parse_context& ctx)
+{
+    // Get the number of columns
+    auto num_columns = static_cast<std::size_t>(ctx.get_nonnegative_integral<std::int16_t>());
+
+    // The columns start here, record it
+    const auto* columns_begin = ctx.first();
+
+    // Iterate over all columns to check if there's any error
+    for (std::size_t i = 0u; i < num_columns; ++i)
+    {
+        switch (static_cast<pgoutput::tuple_column_kind>(ctx.get_byte()))
+        {
+            case pgoutput::tuple_column_kind::null:
+            case pgoutput::tuple_column_kind::unchanged_toast: break;
+            case pgoutput::tuple_column_kind::text:
+            case pgoutput::tuple_column_kind::binary:
+                ctx.check_size_and_advance(ctx.get_nonnegative_integral<std::int32_t>());
+                break;
+            default: ctx.add_error(client_errc::protocol_value_error); break;
+        }
+    }
+
+    if (ctx.error())
+        return {};
+    return {
+        num_columns,
+        {columns_begin, ctx.first()}
+    };
+}
+
+// Parses the old tuple of updates and deletes, if present
+void get_old_tuple(detail::parse_context& ctx, pgoutput::old_tuple_kind& kind, pgoutput::tuple_data& tuple)
+{
+    auto kind_byte = static_cast<pgoutput::old_tuple_kind>(ctx.get_byte());
+    if (kind_byte != pgoutput::old_tuple_kind::key && kind_byte != pgoutput::old_tuple_kind::full)
+    {
+        ctx.add_error(client_errc::protocol_value_error);
+        return;
+    }
+    kind = kind_byte;
+    tuple = get_tuple_data(ctx);
+}
+
+// Parses the new tuple of inserts and updates
+pgoutput::tuple_data get_new_tuple(detail::parse_context& ctx)
+{
+    if (ctx.get_byte() != 'N')
+        ctx.add_error(client_errc::protocol_value_error);
+    return get_tuple_data(ctx);
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::begin_message& to)
+{
+    to.final_lsn = get_lsn(ctx);
+    to.commit_time = ctx.get_integral<std::int64_t>();
+    to.xid = ctx.get_integral<std::int32_t>();
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::commit_message& to)
+{
+    to.flags = ctx.get_byte();
+    to.commit_lsn = get_lsn(ctx);
+    to.end_lsn = get_lsn(ctx);
+    to.commit_time = ctx.get_integral<std::int64_t>();
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::origin_message& to)
+{
+    to.commit_lsn = get_lsn(ctx);
+    to.name = ctx.get_string();
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::relation_message& to)
+{
+    to.oid = ctx.get_integral<std::int32_t>();
+    to.nspname = ctx.get_string();
+    to.name = ctx.get_string();
+    to.replica_identity = static_cast<char>(ctx.get_byte());
+
+    // Get the number of columns
+    auto num_columns = static_cast<std::size_t>(ctx.get_nonnegative_integral<std::int16_t>());
+
+    // Check that all columns are valid. Each one has a flags byte, a name and two Int32
+    const auto* columns_begin = ctx.first();
+    for (std::size_t i = 0u; i < num_columns; ++i)
+    {
+        ctx.get_byte();
+        ctx.get_string();
+        ctx.check_size_and_advance(8u);
+    }
+    if (auto ec = ctx.check())
+        return ec;
+
+    to.columns = {
+        num_columns,
+        {columns_begin, ctx.first()}
+    };
+    return {};
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::type_message& to)
+{
+    to.oid = ctx.get_integral<std::int32_t>();
+    to.nspname = ctx.get_string();
+    to.name = ctx.get_string();
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::insert_message& to)
+{
+    to.relation_oid = ctx.get_integral<std::int32_t>();
+    to.new_tuple = get_new_tuple(ctx);
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::update_message& to)
+{
+    to.relation_oid = ctx.get_integral<std::int32_t>();
+
+    // The old tuple is only sent if the key changed, or with REPLICA IDENTITY FULL
+    to.old_kind = pgoutput::old_tuple_kind::none;
+    to.old_tuple = {};
+    if (ctx.size() > 0u && *ctx.first() != 'N')
+        get_old_tuple(ctx, to.old_kind, to.old_tuple);
+
+    to.new_tuple = get_new_tuple(ctx);
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::delete_message& to)
+{
+    to.relation_oid = ctx.get_integral<std::int32_t>();
+    get_old_tuple(ctx, to.old_kind, to.old_tuple);
+    return ctx.check();
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::truncate_message& to)
+{
+    auto num_relations = static_cast<std::size_t>(ctx.get_nonnegative_integral<std::int32_t>());
+    to.options = ctx.get_byte();
+    const auto* oids_begin = ctx.first();
+    if (num_relations > ctx.size() / 4u)
+        ctx.add_error(client_errc::incomplete_message);
+    else
+        ctx.advance(num_relations * 4u);
+    if (auto ec = ctx.check())
+        return ec;
+    to.relation_oids = {oids_begin, num_relations};
+    return {};
+}
+
+std::error_code parse_message_body(detail::parse_context& ctx, pgoutput::logical_message& to)
+{
+    to.flags = ctx.get_byte();
+    to.lsn = get_lsn(ctx);
+    to.prefix = ctx.get_string();
+    to.content = ctx.get_bytes(ctx.get_nonnegative_integral<std::int32_t>());
+    return ctx.check();
+}
+
+template <class MessageType, class Variant>
+std::error_code parse_message_impl(detail::parse_context& ctx, Variant& to)
+{
+    MessageType msg{};
+    auto ec = parse_message_body(ctx, msg);
+    if (!ec)
+        to = msg;
+    return ec;
+}
+
+}  // namespace
+
+std::error_code nativepg::protocol::parse(std::span<const unsigned char> data, replication_message& to)
+{
+    detail::parse_context ctx(data);
+    switch (static_cast<replication_message_type>(ctx.get_byte()))
+    {
+        case replication_message_type::xlog_data:
+        {
+            xlog_data msg{};
+            msg.wal_start = get_lsn(ctx);
+            msg.wal_end = get_lsn(ctx);
+            msg.send_time = ctx.get_integral<std::int64_t>();
+            if (auto ec = ctx.error())
+                return ec;
+            msg.data = {ctx.first(), ctx.last()};
+            to = msg;
+            return {};
+        }
+        case replication_message_type::primary_keepalive:
+        {
+            primary_keepalive msg{};
+            msg.wal_end = get_lsn(ctx);
+            msg.send_time = ctx.get_integral<std::int64_t>();
+            msg.reply_requested = ctx.get_byte() != 0u;
+            if (auto ec = ctx.check())
+                return ec;
+            to = msg;
+            return {};
+        }
+        default: return ctx.error() ? ctx.error() : client_errc::protocol_value_error;
+    }
+}
+
+std::error_code nativepg::protocol::serialize(
+    const standby_status_update& msg,
+    std::vector<unsigned char>& to
+)
+{
+    detail::serialization_context ctx(to);
+    ctx.add_byte(static_cast<unsigned char>(replication_message_type::standby_status_update));
+    ctx.add_integral(static_cast<std::int64_t>(msg.written));
+    ctx.add_integral(static_cast<std::int64_t>(msg.flushed));
+    ctx.add_integral(static_cast<std::int64_t>(msg.applied));
+    ctx.add_integral(msg.send_time);
+    ctx.add_byte(msg.reply_requested ? 1u : 0u);
+    return ctx.error();
+}
+
+pgoutput::tuple_column nativepg::protocol::detail::forward_traits<pgoutput::tuple_column>::dereference(
+    const unsigned char* data
+)
+{
+    auto kind = static_cast<pgoutput::tuple_column_kind>(*data++);
+    if (kind != pgoutput::tuple_column_kind::text && kind != pgoutput::tuple_column_kind::binary)
+        return {kind, {}};
+    auto size = unchecked_get_integral<std::int32_t>(data);
+    return {
+        kind,
+        {data, static_cast<std::size_t>(size)}
+    };
+}
+
+const unsigned char* nativepg::protocol::detail::forward_traits<pgoutput::tuple_column>::advance(
+    const unsigned char* data
+)
+{
+    auto kind = static_cast<pgoutput::tuple_column_kind>(*data++);
+    if (kind != pgoutput::tuple_column_kind::text && kind != pgoutput::tuple_column_kind::binary)
+        return data;
+    auto size = unchecked_get_integral<std::int32_t>(data);
+    return data + size;
+}
+
+pgoutput::relation_column nativepg::protocol::detail::forward_traits<
+    pgoutput::relation_column>::dereference(const unsigned char* data)
+{
+    pgoutput::relation_column res{};
+    res.is_key = (*data++ & 1u) != 0u;
+    res.name = unchecked_get_string(data);
+    res.type_oid = unchecked_get_integral<std::int32_t>(data);
+    res.type_modifier = unchecked_get_integral<std::int32_t>(data);
+    return res;
+}
+
+const unsigned char* nativepg::protocol::detail::forward_traits<pgoutput::relation_column>::advance(
+    const unsigned char* data
+)
+{
+    // Skip the flags, the name and the fixed fields
+    ++data;
+    unchecked_get_string(data);
+    return data + 8u;
+}
+
+std::error_code nativepg::protocol::pgoutput::parse(std::span<const unsigned char> data, message& to)
+{
+    detail::parse_context ctx(data);
+    switch (static_cast<pgoutput_message_type>(ctx.get_byte()))
+    {
+        case pgoutput_message_type::begin: return parse_message_impl<begin_message>(ctx, to);
+        case pgoutput_message_type::commit: return parse_message_impl<commit_message>(ctx, to);
+        case pgoutput_message_type::origin: return parse_message_impl<origin_message>(ctx, to);
+        case pgoutput_message_type::relation: return parse_message_impl<relation_message>(ctx, to);
+        case pgoutput_message_type::type: return parse_message_impl<type_message>(ctx, to);
+        case pgoutput_message_type::insert: return parse_message_impl<insert_message>(ctx, to);
+        case pgoutput_message_type::update: return parse_message_impl<update_message>(ctx, to);
+        case pgoutput_message_type::delete_: return parse_message_impl<delete_message>(ctx, to);
+        case pgoutput_message_type::truncate: return parse_message_impl<truncate_message>(ctx, to);
+        case pgoutput_message_type::logical_message: return parse_message_impl<logical_message>(ctx, to);
+        default: return ctx.error() ? ctx.error() : client_errc::protocol_value_error;
+    }
+}
@@ -78,6 +78,12 @@ request& request::add_bind(
                     for (const parameter_ref& param : params)
                     {
                         ctx.start_parameter();
+                        std::span<const unsigned char> borrowed;
+                        if (param.borrow(param_format, borrowed))
+                        {
+                            ctx.add_borrowed(borrowed);
+                            continue;
+                        }
                         const auto ec = param_format == protocol::format_code::binary
                                             ? param.serialize_binary(ctx.buffer())
                                             : param.serialize_text(ctx.buffer());
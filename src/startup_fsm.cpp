@@ -6,8 +6,11 @@
 //
 
 #include <algorithm>
+#include <optional>
+#include <span>
 #include <string_view>
 #include <system_error>
+#include <utility>
 
 #include "coroutine.hpp"
 #include "nativepg/client_errc.hpp"
@@ -57,13 +60,19 @@ std::error_code handle_auth_response(const any_backend_message& msg, nativepg::d
     }
 }
 
-startup_message make_startup_message(const nativepg::connect_params& params)
+// param is storage for the replication parameter, which must outlive the message
+startup_message make_startup_message(
+    const nativepg::connect_params& params,
+    std::pair<std::string_view, std::string_view>& param
+)
 {
+    param = {"replication", params.replication};
     return {
         .user = params.username,
         .database = params.database.empty() ? std::optional<std::string_view>()
                                             : std::string_view(params.database),
-        .params = {},
+        .params = params.replication.empty() ? decltype(startup_message::params)()
+                                             : std::span(&param, 1u),
     };
 }
 
@@ -90,9 +99,12 @@ startup_fsm_impl::result startup_fsm_impl::resume(
 
         // Compose the startup message
         st.write_buffer.clear();
-        if (auto ec = serialize(make_startup_message(*params_), st.write_buffer))
         {
-            return ec;
+            std::pair<std::string_view, std::string_view> replication_param;
+            if (auto ec = serialize(make_startup_message(*params_, replication_param), st.write_buffer))
+            {
+                return ec;
+            }
         }
 
         // Write it
@@ -6,21 +6,27 @@
 //
 
 #include <boost/assert/source_location.hpp>
+#include <boost/capy/buffers.hpp>
 #include <boost/capy/ex/run_async.hpp>
 #include <boost/capy/ex/this_coro.hpp>
+#include <boost/capy/io/any_stream.hpp>
 #include <boost/capy/io_result.hpp>
+#include <boost/capy/io_task.hpp>
 #include <boost/capy/task.hpp>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/corosio/io_context.hpp>
 #include <boost/describe/class.hpp>
 #include <boost/describe/operators.hpp>
 
+#include <cstddef>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include "nativepg/co_connection.hpp"
 #include "nativepg/extended_error.hpp"
 #include "nativepg/request.hpp"
+#include "nativepg/responses/check.hpp"
 #include "nativepg/responses/into.hpp"
 #include "nativepg/responses/response.hpp"
 #include "test_utils/ci_server.hpp"
@@ -48,6 +54,28 @@ BOOST_DESCRIBE_STRUCT(row_string, (), (value))
 using boost::describe::operators::operator==;
 using boost::describe::operators::operator<<;
 
+// An in-memory stream that stores everything written to it
+struct memory_sink
+{
+    std::string data;
+
+    template <class ConstBufferSequence>
+    capy::io_task<std::size_t> write_some(ConstBufferSequence buffers)
+    {
+        const std::size_t size = capy::buffer_size(buffers);
+        const std::size_t offset = data.size();
+        data.resize(offset + size);
+        capy::buffer_copy(capy::mutable_buffer(data.data() + offset, size), buffers);
+        co_return {{}, size};
+    }
+
+    template <class MutableBufferSequence>
+    capy::io_task<std::size_t> read_some(MutableBufferSequence)
+    {
+        co_return {std::make_error_code(std::errc::operation_not_supported), 0u};
+    }
+};
+
 // Exec (potentially with pipelining) works
 capy::task<> test_exec_success()
 {
@@ -75,11 +103,48 @@ capy::task<> test_exec_success()
     BOOST_TEST_ALL_EQ(strings.begin(), strings.end(), strings_expected.begin(), strings_expected.end());
 }
 
+// copy_out_to writes all the COPY data to the sink, even if it needs many buffers
+capy::task<> test_copy_out_to()
+{
+    // Setup
+    diagnostics diag;
+    co_connection conn{co_await capy::this_coro::executor};
+    if (!check_success(co_await conn.connect(default_connect_params(), &diag), diag))
+        co_return;
+
+    // Request and sink. Small buffers make the reader wait for the writer
+    request req;
+    req.add_simple_query("COPY (SELECT * FROM generate_series(1, 1000)) TO STDOUT");
+    check check_response;
+    conn.setup_request(req, &check_response);
+    memory_sink sink;
+    capy::any_stream stream{&sink};
+
+    // Execute
+    auto [ec] = co_await conn.copy_out_to(stream, {.buffer_size = 64u, .max_buffers = 2u});
+
+    // Check
+    BOOST_TEST_EQ(ec, std::error_code());
+    std::string expected;
+    for (int i = 1; i <= 1000; ++i)
+        expected += std::to_string(i) + '\n';
+    BOOST_TEST_EQ(sink.data, expected);
+
+    // The connection is usable afterwards
+    std::vector<row_int> ints;
+    request req2;
+    req2.add_query("SELECT $1 AS value", {42});
+    if (!check_success(co_await conn.exec(req2, response{into(ints)}, &diag), diag))
+        co_return;
+    BOOST_TEST_EQ(ints.size(), 1u);
+}
+
 }  // namespace
 
 int main()
 {
     run_coroutine_test(test_exec_success());
+    run_coroutine_test(test_copy_out_to());
 
     return boost::report_errors();
 }
\ No newline at end of file
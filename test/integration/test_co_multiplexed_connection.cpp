@@ -0,0 +1,148 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/capy/ex/this_coro.hpp>
+#include <boost/capy/io_task.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/capy/when_any.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/describe/class.hpp>
+#include <boost/describe/operators.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "nativepg/co_multiplexed_connection.hpp"
+#include "nativepg/extended_error.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/check.hpp"
+#include "nativepg/responses/into.hpp"
+#include "test_utils/ci_server.hpp"
+#include "test_utils/corosio_utils.hpp"
+#include "test_utils/printing.hpp"
+
+namespace capy = boost::capy;
+using namespace nativepg;
+using namespace nativepg::test;
+
+// Count heap allocations, to check that exec() doesn't allocate in steady state.
+// Not inlined, so the compiler doesn't flag the malloc/free pairs as mismatched
+static std::size_t num_allocations = 0u;
+
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    ++num_allocations;
+    if (void* res = std::malloc(size ? size : 1u))
+        return res;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+struct row_int
+{
+    int value;
+};
+BOOST_DESCRIBE_STRUCT(row_int, (), (value))
+
+using boost::describe::operators::operator==;
+using boost::describe::operators::operator<<;
+
+// Runs body while the connection runs. run() only finishes when cancelled
+template <class Body>
+capy::task<> run_with_connection(multiplexed_config cfg, Body body)
+{
+    co_multiplexed_connection conn{co_await capy::this_coro::executor};
+    [[maybe_unused]] auto res = co_await capy::when_any(conn.run(std::move(cfg)), body(conn));
+}
+
+// When request_timeout elapses, exec() fails and the request is abandoned.
+// Its response is discarded, and the following request gets its own response
+capy::task<> test_request_timeout()
+{
+    multiplexed_config cfg;
+    cfg.transport = default_connect_params();
+    cfg.request_timeout = std::chrono::seconds(1);
+
+    co_await run_with_connection(std::move(cfg), [](co_multiplexed_connection& conn) -> capy::io_task<> {
+        // A request slower than the timeout
+        request slow_req;
+        slow_req.add_query("SELECT 1 AS value FROM pg_sleep(1.5)", {});
+        std::vector<row_int> slow_rows;
+        diagnostics diag;
+        auto [ec1] = co_await conn.exec(slow_req, into(slow_rows), &diag);
+        BOOST_TEST(ec1 != std::error_code());
+
+        // Pipelined behind the abandoned one, so it completes once pg_sleep finishes
+        request req;
+        req.add_query("SELECT 42 AS value", {});
+        std::vector<row_int> rows;
+        auto [ec2] = co_await conn.exec(req, into(rows), &diag);
+        check_success(ec2, diag);
+        const std::vector<row_int> expected{{.value = 42}};
+        BOOST_TEST_ALL_EQ(rows.begin(), rows.end(), expected.begin(), expected.end());
+        BOOST_TEST(slow_rows.empty());
+        co_return {};
+    });
+}
+
+// Once coroutine frames and buffers have been recycled, exec() doesn't allocate.
+// This covers the whole path of a request: exec's coroutines, the multiplexer,
+// the writer and the reader. With a timeout, exec() takes a different path
+capy::task<> test_exec_no_allocations()
+{
+    for (bool with_timeout : {false, true})
+    {
+        multiplexed_config cfg;
+        cfg.transport = default_connect_params();
+        cfg.ping_interval = {};  // pings would be counted
+        if (with_timeout)
+            cfg.request_timeout = std::chrono::seconds(10);
+
+        co_await run_with_connection(std::move(cfg), [](co_multiplexed_connection& conn) -> capy::io_task<> {
+            request req;
+            req.add_query("SELECT 1", {});
+            diagnostics diag;
+            auto run_request = [&]() -> capy::io_task<> {
+                check handler;
+                auto [ec] = co_await conn.exec(req, response_handler_ref(&handler), &diag);
+                check_success(ec, diag);
+                co_return {};
+            };
+
+            // Warm up
+            for (int i = 0; i < 10; ++i)
+                co_await run_request();
+            const std::size_t initial_allocations = num_allocations;
+
+            // Run many requests
+            for (int i = 0; i < 100; ++i)
+                co_await run_request();
+
+            BOOST_TEST_EQ(num_allocations, initial_allocations);
+            co_return {};
+        });
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    run_coroutine_test(test_request_timeout());
+    run_coroutine_test(test_exec_no_allocations());
+
+    return boost::report_errors();
+}
@@ -0,0 +1,361 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "nativepg/protocol/detail/copy_in_buffer.hpp"
+#include "nativepg_internal/copy_file_sender.hpp"
+
+#ifdef NATIVEPG_HAS_COPY_FROM_FILE
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+
+using namespace nativepg;
+using detail::copy_file_sender;
+using protocol::detail::copy_in_buffer;
+
+namespace {
+
+using bytes_t = std::vector<unsigned char>;
+
+// A message sent by the sender
+struct message
+{
+    char type;
+    bytes_t body;
+};
+
+// A file descriptor that is closed on destruction
+class unique_fd
+{
+    int fd_;
+
+public:
+    explicit unique_fd(int fd = -1) noexcept : fd_(fd) {}
+    unique_fd(unique_fd&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+    unique_fd& operator=(unique_fd&&) = delete;
+    ~unique_fd()
+    {
+        if (fd_ >= 0)
+            ::close(fd_);
+    }
+    int get() const { return fd_; }
+    void reset()
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+};
+
+bytes_t make_contents(std::size_t size)
+{
+    bytes_t res(size);
+    for (std::size_t i = 0; i < size; ++i)
+        res[i] = static_cast<unsigned char>(i % 251u);
+    return res;
+}
+
+// Creates a regular file with the given contents, positioned at its start
+unique_fd make_file(const bytes_t& contents)
+{
+    char name[] = "/tmp/nativepg_copy_file_XXXXXX";
+    unique_fd res{::mkstemp(name)};
+    BOOST_TEST(res.get() >= 0);
+    ::unlink(name);
+    const auto n = ::write(res.get(), contents.data(), contents.size());
+    BOOST_TEST_EQ(n, static_cast<ssize_t>(contents.size()));
+    BOOST_TEST_EQ(::lseek(res.get(), 0, SEEK_SET), 0);
+    return res;
+}
+
+// Stands for the connection's socket. Non-blocking, like the ones used by the stream.
+// A pipe is used because its buffer is small, so it gets full often
+struct fake_socket
+{
+    unique_fd server;
+    unique_fd client;
+    bytes_t received;
+
+    fake_socket() : fake_socket(make_fds()) {}
+
+    explicit fake_socket(std::array<int, 2> fds) : server(fds[0]), client(fds[1])
+    {
+        ::fcntl(client.get(), F_SETFL, ::fcntl(client.get(), F_GETFL) | O_NONBLOCK);
+        ::fcntl(server.get(), F_SETFL, ::fcntl(server.get(), F_GETFL) | O_NONBLOCK);
+    }
+
+    static std::array<int, 2> make_fds()
+    {
+        std::array<int, 2> res{-1, -1};
+        BOOST_TEST_EQ(::pipe(res.data()), 0);
+        return res;
+    }
+
+    // Reads everything the server can read
+    void drain()
+    {
+        unsigned char buff[8192];
+        while (true)
+        {
+            const auto n = ::read(server.get(), buff, sizeof(buff));
+            if (n <= 0)
+                break;
+            received.insert(received.end(), buff, buff + n);
+        }
+    }
+
+    // Writes data like the stream does, waiting for space if required
+    void write(std::span<const unsigned char> data)
+    {
+        while (!data.empty())
+        {
+            const auto n = ::write(client.get(), data.data(), data.size());
+            if (n > 0)
+                data = data.subspan(static_cast<std::size_t>(n));
+            else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+                drain();
+            else
+                BOOST_ERROR("Writing to the socket failed");
+        }
+    }
+};
+
+// Runs the sender like co_connection does, returning the final error code
+std::error_code run_sender(copy_file_sender& sender, fake_socket& socks, bool zero_copy = true)
+{
+    while (true)
+    {
+        auto res = sender.next(zero_copy ? socks.client.get() : -1);
+        socks.write(res.data);
+        if (res.type == copy_file_sender::result_type::done)
+        {
+            socks.drain();
+            return res.ec;
+        }
+    }
+}
+
+// Splits what the server received into messages
+std::vector<message> parse_messages(std::span<const unsigned char> data)
+{
+    std::vector<message> res;
+    while (data.size() >= 5u)
+    {
+        const auto length = static_cast<std::size_t>(
+            (std::uint32_t(data[1]) << 24) | (std::uint32_t(data[2]) << 16) | (std::uint32_t(data[3]) << 8) |
+            std::uint32_t(data[4])
+        );
+        if (!BOOST_TEST(length >= 4u && data.size() >= 1u + length))
+            break;
+        res.push_back({static_cast<char>(data[0]), bytes_t(data.begin() + 5, data.begin() + 1 + length)});
+        data = data.subspan(1u + length);
+    }
+    BOOST_TEST(data.empty());
+    return res;
+}
+
+// Checks that messages are CopyData messages no bigger than max_size
+// containing contents, followed by a CopyDone
+void check_copy_data(const std::vector<message>& msgs, const bytes_t& contents, std::size_t max_size)
+{
+    if (!BOOST_TEST(!msgs.empty()))
+        return;
+    bytes_t body;
+    for (std::size_t i = 0; i + 1u < msgs.size(); ++i)
+    {
+        BOOST_TEST_EQ(msgs[i].type, 'd');
+        BOOST_TEST(!msgs[i].body.empty());
+        BOOST_TEST_LE(msgs[i].body.size(), max_size);
+        body.insert(body.end(), msgs[i].body.begin(), msgs[i].body.end());
+    }
+    BOOST_TEST(body == contents);
+    BOOST_TEST_EQ(msgs.back().type, 'c');
+    BOOST_TEST(msgs.back().body.empty());
+}
+
+// Regular files are split in messages of chunk_size, followed by CopyDone.
+// The socket buffer fills up many times
+void test_regular_file()
+{
+    // Arrange
+    const auto contents = make_contents(300000u);
+    auto file = make_file(contents);
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    copy_file_sender sender{file.get(), 64u * 1024u, copy_in};
+
+    // Act
+    auto ec = run_sender(sender, socks);
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    auto msgs = parse_messages(socks.received);
+    check_copy_data(msgs, contents, 64u * 1024u);
+    BOOST_TEST_EQ(msgs.size(), 6u);  // 5 CopyData, CopyDone
+}
+
+// The file is sent from its current position
+void test_regular_file_position()
+{
+    // Arrange
+    const auto contents = make_contents(1000u);
+    auto file = make_file(contents);
+    BOOST_TEST_EQ(::lseek(file.get(), 100, SEEK_SET), 100);
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    copy_file_sender sender{file.get(), 1024u, copy_in};
+
+    // Act
+    auto ec = run_sender(sender, socks);
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    check_copy_data(parse_messages(socks.received), bytes_t(contents.begin() + 100, contents.end()), 1024u);
+}
+
+// Without a socket to use sendfile, the file is read into a buffer
+void test_regular_file_no_zero_copy()
+{
+    // Arrange
+    const auto contents = make_contents(10000u);
+    auto file = make_file(contents);
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    copy_file_sender sender{file.get(), 4096u, copy_in};
+
+    // Act
+    auto ec = run_sender(sender, socks, false);
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    auto msgs = parse_messages(socks.received);
+    check_copy_data(msgs, contents, 4096u);
+    BOOST_TEST_EQ(msgs.size(), 4u);  // 3 CopyData, CopyDone
+}
+
+// An empty file sends a CopyDone only
+void test_empty_file()
+{
+    // Arrange
+    auto file = make_file({});
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    copy_file_sender sender{file.get(), 1024u, copy_in};
+
+    // Act
+    auto ec = run_sender(sender, socks);
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    auto msgs = parse_messages(socks.received);
+    BOOST_TEST_EQ(msgs.size(), 1u);
+    check_copy_data(msgs, {}, 1024u);
+}
+
+// Pipes can't use sendfile, and are read into a buffer
+void test_pipe()
+{
+    // Arrange
+    const auto contents = make_contents(5000u);
+    int fds[2]{};
+    BOOST_TEST_EQ(::pipe(fds), 0);
+    unique_fd read_end{fds[0]}, write_end{fds[1]};
+    BOOST_TEST_EQ(::write(write_end.get(), contents.data(), contents.size()), 5000);
+    write_end.reset();
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    copy_file_sender sender{read_end.get(), 1024u, copy_in};
+
+    // Act
+    auto ec = run_sender(sender, socks);
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    check_copy_data(parse_messages(socks.received), contents, 1024u);
+}
+
+// If reading fails, the COPY is aborted with a CopyFail containing the error message
+void test_read_error()
+{
+    // Arrange: reading a directory fails with EISDIR
+    unique_fd dir{::open("/tmp", O_RDONLY)};
+    BOOST_TEST(dir.get() >= 0);
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    copy_file_sender sender{dir.get(), 1024u, copy_in};
+    const std::error_code expected_ec(EISDIR, std::system_category());
+
+    // Act
+    auto ec = run_sender(sender, socks);
+
+    // Assert
+    BOOST_TEST_EQ(ec, expected_ec);
+    auto msgs = parse_messages(socks.received);
+    if (BOOST_TEST_EQ(msgs.size(), 1u))
+    {
+        BOOST_TEST_EQ(msgs[0].type, 'f');
+        auto reason = expected_ec.message();
+        bytes_t expected_body(reason.begin(), reason.end());
+        expected_body.push_back(0u);
+        BOOST_TEST(msgs[0].body == expected_body);
+    }
+}
+
+// Data pending in the copy_in buffer is discarded by the CopyFail
+void test_read_error_pending_data()
+{
+    // Arrange
+    unique_fd dir{::open("/tmp", O_RDONLY)};
+    fake_socket socks;
+    copy_in_buffer copy_in;
+    const bytes_t pending{1, 2, 3};
+    copy_in.append(pending);
+    copy_file_sender sender{dir.get(), 1024u, copy_in};
+
+    // Act
+    auto ec = run_sender(sender, socks);
+
+    // Assert
+    BOOST_TEST(ec != std::error_code());
+    auto msgs = parse_messages(socks.received);
+    if (BOOST_TEST_EQ(msgs.size(), 1u))
+        BOOST_TEST_EQ(msgs[0].type, 'f');
+}
+
+}  // namespace
+
+int main()
+{
+    test_regular_file();
+    test_regular_file_position();
+    test_regular_file_no_zero_copy();
+    test_empty_file();
+    test_pipe();
+    test_read_error();
+    test_read_error_pending_data();
+
+    return boost::report_errors();
+}
+
+#else
+
+int main() { return 0; }
+
+#endif
@@ -0,0 +1,283 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/capy/delay.hpp>
+#include <boost/capy/ex/async_event.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/ex/this_coro.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "nativepg_internal/copy_out_queue.hpp"
+#include "test_utils/corosio_utils.hpp"
+
+namespace capy = boost::capy;
+using namespace nativepg;
+using namespace nativepg::test;
+using detail::copy_out_queue;
+
+namespace {
+
+using bytes_t = std::vector<unsigned char>;
+
+// Takes the buffers that are ready to be written, as the consumer does
+std::vector<bytes_t> take_ready(copy_out_queue& queue)
+{
+    std::vector<bytes_t> res;
+    for (const auto& buff : queue.start_write())
+        res.push_back(buff);
+    queue.end_write();
+    return res;
+}
+
+// Gives tasks launched with run_async the chance to run until they block
+capy::task<> yield()
+{
+    [[maybe_unused]] auto [ec] = co_await capy::delay(std::chrono::milliseconds(10));
+}
+
+// Background tasks. Set done and signal the event when finished
+capy::task<> append_task(copy_out_queue& queue, bytes_t data, bool& done, capy::async_event& evt)
+{
+    auto [ec] = co_await queue.append(data);
+    BOOST_TEST_EQ(ec, std::error_code());
+    done = true;
+    evt.set();
+}
+
+capy::task<> wait_drained_task(copy_out_queue& queue, bool& done, capy::async_event& evt)
+{
+    auto [ec] = co_await queue.wait_drained();
+    BOOST_TEST_EQ(ec, std::error_code());
+    done = true;
+    evt.set();
+}
+
+// Data is split into buffers of the configured size, regardless of how it's appended
+capy::task<> test_append_split()
+{
+    // Arrange
+    copy_out_queue queue{4u, 4u};
+    const bytes_t data1{1, 2, 3, 4, 5, 6}, data2{7, 8, 9};
+
+    // Act
+    auto [ec1] = co_await queue.append(data1);
+    auto [ec2] = co_await queue.append(data2);
+
+    // Assert
+    BOOST_TEST_EQ(ec1, std::error_code());
+    BOOST_TEST_EQ(ec2, std::error_code());
+    auto [ec3] = co_await queue.wait_data();
+    BOOST_TEST_EQ(ec3, std::error_code());
+    const std::vector<bytes_t> expected{
+        {1, 2, 3, 4},
+        {5, 6, 7, 8}
+    };
+    BOOST_TEST(take_ready(queue) == expected);
+
+    // The last byte is only handed over when finishing
+    queue.finish();
+    const std::vector<bytes_t> expected_last{{9}};
+    BOOST_TEST(take_ready(queue) == expected_last);
+}
+
+// Data bigger than all buffers can be appended if the consumer keeps writing
+capy::task<> test_append_bigger_than_buffers()
+{
+    // Arrange
+    copy_out_queue queue{2u, 2u};
+    const bytes_t data{1, 2, 3, 4, 5, 6, 7};
+    bool done = false;
+    capy::async_event done_evt;
+    capy::run_async(co_await capy::this_coro::executor)(append_task(queue, data, done, done_evt));
+
+    // Act
+    std::vector<bytes_t> written;
+    while (!done)
+    {
+        auto [ec] = co_await queue.wait_data();
+        BOOST_TEST_EQ(ec, std::error_code());
+        for (auto& buff : take_ready(queue))
+            written.push_back(std::move(buff));
+        co_await yield();
+    }
+    queue.finish();
+    for (auto& buff : take_ready(queue))
+        written.push_back(std::move(buff));
+
+    // Assert
+    const std::vector<bytes_t> expected{
+        {1, 2},
+        {3, 4},
+        {5, 6},
+        {7}
+    };
+    BOOST_TEST(written == expected);
+}
+
+// Once max_buffers are in use, the producer waits until the consumer returns them
+capy::task<> test_append_blocks()
+{
+    // Arrange
+    copy_out_queue queue{2u, 2u};
+    const bytes_t data1{1, 2, 3, 4}, data2{5, 6};
+    auto [ec] = co_await queue.append(data1);
+    BOOST_TEST_EQ(ec, std::error_code());
+    bool done = false;
+    capy::async_event done_evt;
+
+    // Act: the producer blocks, since both buffers are full
+    capy::run_async(co_await capy::this_coro::executor)(append_task(queue, data2, done, done_evt));
+    co_await yield();
+    BOOST_TEST(!done);
+
+    // Taking the buffers doesn't free them
+    auto buffs = queue.start_write();
+    BOOST_TEST_EQ(buffs.size(), 2u);
+    co_await yield();
+    BOOST_TEST(!done);
+
+    // Returning them does
+    queue.end_write();
+    auto [ec2] = co_await done_evt.wait();
+    BOOST_TEST_EQ(ec2, std::error_code());
+
+    // Assert
+    BOOST_TEST(done);
+    const std::vector<bytes_t> expected{
+        {5, 6}
+    };
+    BOOST_TEST(take_ready(queue) == expected);
+}
+
+// flush_if_idle hands over a partially filled buffer only if the consumer has nothing to write
+capy::task<> test_flush_if_idle()
+{
+    // Arrange
+    copy_out_queue queue{4u, 8u};
+    const bytes_t data1{1, 2, 3}, data2{4, 5};
+    auto [ec] = co_await queue.append(data1);
+    BOOST_TEST_EQ(ec, std::error_code());
+
+    // Act: the consumer is idle, so the buffer is handed over
+    queue.flush_if_idle();
+    auto [ec2] = co_await queue.wait_data();
+    BOOST_TEST_EQ(ec2, std::error_code());
+    auto buffs = queue.start_write();
+
+    // Assert
+    BOOST_TEST_EQ(buffs.size(), 1u);
+    BOOST_TEST(buffs[0] == data1);
+
+    // Act: the consumer is writing, so the new data is kept
+    auto [ec3] = co_await queue.append(data2);
+    BOOST_TEST_EQ(ec3, std::error_code());
+    queue.flush_if_idle();
+    queue.end_write();
+
+    // Assert
+    BOOST_TEST(queue.start_write().empty());
+    queue.end_write();
+
+    // Act: once the consumer is idle again, it's handed over
+    queue.flush_if_idle();
+
+    // Assert
+    const std::vector<bytes_t> expected{
+        {4, 5}
+    };
+    BOOST_TEST(take_ready(queue) == expected);
+}
+
+// flush_if_idle doesn't hand over empty buffers
+capy::task<> test_flush_if_idle_empty()
+{
+    // Arrange
+    copy_out_queue queue{4u, 2u};
+    const bytes_t data{1, 2};
+    auto [ec] = co_await queue.append(data);
+    BOOST_TEST_EQ(ec, std::error_code());
+    BOOST_TEST_EQ(take_ready(queue).size(), 1u);
+
+    // Act
+    queue.flush_if_idle();
+
+    // Assert
+    BOOST_TEST(take_ready(queue).empty());
+}
+
+// After finish, the queue is drained once the consumer has written everything
+capy::task<> test_finish_drained()
+{
+    // Arrange
+    copy_out_queue queue{4u, 4u};
+    const bytes_t data{1, 2};
+    auto [ec] = co_await queue.append(data);
+    BOOST_TEST_EQ(ec, std::error_code());
+    bool done = false;
+    capy::async_event done_evt;
+
+    // Act
+    queue.finish();
+    capy::run_async(co_await capy::this_coro::executor)(wait_drained_task(queue, done, done_evt));
+    co_await yield();
+
+    // Assert: the pending data is handed over, but not written yet
+    BOOST_TEST(!queue.drained());
+    BOOST_TEST(!done);
+    auto [ec2] = co_await queue.wait_data();
+    BOOST_TEST_EQ(ec2, std::error_code());
+    auto buffs = queue.start_write();
+    BOOST_TEST_EQ(buffs.size(), 1u);
+    BOOST_TEST(!queue.drained());
+
+    // Returning the buffers drains the queue and wakes up the waiter
+    queue.end_write();
+    BOOST_TEST(queue.drained());
+    auto [ec3] = co_await done_evt.wait();
+    BOOST_TEST_EQ(ec3, std::error_code());
+    BOOST_TEST(done);
+}
+
+// Finishing without data doesn't block anybody
+capy::task<> test_finish_empty()
+{
+    // Arrange
+    copy_out_queue queue{4u, 4u};
+
+    // Act
+    queue.finish();
+
+    // Assert
+    BOOST_TEST(queue.drained());
+    auto [ec1] = co_await queue.wait_data();
+    BOOST_TEST_EQ(ec1, std::error_code());
+    BOOST_TEST(queue.start_write().empty());
+    queue.end_write();
+    auto [ec2] = co_await queue.wait_drained();
+    BOOST_TEST_EQ(ec2, std::error_code());
+}
+
+}  // namespace
+
+int main()
+{
+    run_coroutine_test(test_append_split());
+    run_coroutine_test(test_append_bigger_than_buffers());
+    run_coroutine_test(test_append_blocks());
+    run_coroutine_test(test_flush_if_idle());
+    run_coroutine_test(test_flush_if_idle_empty());
+    run_coroutine_test(test_finish_drained());
+    run_coroutine_test(test_finish_empty());
+
+    return boost::report_errors();
+}
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <array>
+#include <cstddef>
+
+#include "nativepg/multiplexed_routing.hpp"
+#include "nativepg_internal/multiplexed_connection/router.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+template <std::size_t N>
+std::size_t select_connection(
+    multiplexed_routing routing,
+    const std::array<std::size_t, N>& loads,
+    std::size_t start
+)
+{
+    return detail::select_connection(routing, N, start, [&loads](std::size_t i) { return loads[i]; });
+}
+
+// least_loaded picks the connection with the fewest outstanding bytes
+void test_least_loaded()
+{
+    // Arrange
+    const std::array<std::size_t, 4> loads{300u, 100u, 200u, 400u};
+
+    // Act
+    auto res = select_connection(multiplexed_routing::least_loaded, loads, 0u);
+
+    // Assert
+    BOOST_TEST_EQ(res, 1u);
+}
+
+// Ties are broken round-robin, so idle connections share the work
+void test_least_loaded_ties()
+{
+    // Arrange
+    const std::array<std::size_t, 3> loads{0u, 0u, 0u};
+
+    // Act
+    auto res1 = select_connection(multiplexed_routing::least_loaded, loads, 0u);
+    auto res2 = select_connection(multiplexed_routing::least_loaded, loads, 1u);
+    auto res3 = select_connection(multiplexed_routing::least_loaded, loads, 2u);
+    auto res4 = select_connection(multiplexed_routing::least_loaded, loads, 3u);
+
+    // Assert
+    BOOST_TEST_EQ(res1, 0u);
+    BOOST_TEST_EQ(res2, 1u);
+    BOOST_TEST_EQ(res3, 2u);
+    BOOST_TEST_EQ(res4, 0u);
+}
+
+// Among several minimums, the first one at or after start wins
+void test_least_loaded_ties_partial()
+{
+    // Arrange
+    const std::array<std::size_t, 4> loads{10u, 50u, 10u, 10u};
+
+    // Act
+    auto res = select_connection(multiplexed_routing::least_loaded, loads, 1u);
+
+    // Assert
+    BOOST_TEST_EQ(res, 2u);
+}
+
+// round_robin ignores the loads
+void test_round_robin()
+{
+    // Arrange
+    const std::array<std::size_t, 2> loads{1000u, 0u};
+
+    // Act
+    auto res1 = select_connection(multiplexed_routing::round_robin, loads, 0u);
+    auto res2 = select_connection(multiplexed_routing::round_robin, loads, 1u);
+    auto res3 = select_connection(multiplexed_routing::round_robin, loads, 2u);
+
+    // Assert
+    BOOST_TEST_EQ(res1, 0u);
+    BOOST_TEST_EQ(res2, 1u);
+    BOOST_TEST_EQ(res3, 0u);
+}
+
+// A single connection is always chosen
+void test_single_connection()
+{
+    // Arrange
+    const std::array<std::size_t, 1> loads{42u};
+
+    // Act
+    auto res1 = select_connection(multiplexed_routing::least_loaded, loads, 5u);
+    auto res2 = select_connection(multiplexed_routing::round_robin, loads, 6u);
+
+    // Assert
+    BOOST_TEST_EQ(res1, 0u);
+    BOOST_TEST_EQ(res2, 0u);
+}
+
+}  // namespace
+
+int main()
+{
+    test_least_loaded();
+    test_least_loaded_ties();
+    test_least_loaded_ties_partial();
+    test_round_robin();
+    test_single_connection();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,517 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+#include <system_error>
+
+#include "nativepg/protocol/command_complete.hpp"
+#include "nativepg/protocol/ready_for_query.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/check.hpp"
+#include "nativepg_internal/multiplexed_connection/health_monitor.hpp"
+#include "nativepg_internal/multiplexed_connection/multiplexer.hpp"
+
+using namespace nativepg;
+using detail::health_monitor;
+using detail::multiplexer;
+using std::chrono::seconds;
+
+// Count heap allocations, to check that the multiplexer doesn't allocate in steady state.
+// Not inlined, so the compiler doesn't flag the malloc/free pairs as mismatched
+static std::size_t num_allocations = 0u;
+
+[[gnu::noinline]] void* operator new(std::size_t size)
+{
+    ++num_allocations;
+    if (void* res = std::malloc(size ? size : 1u))
+        return res;
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept { std::free(ptr); }
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+// A queue node that records its completions
+struct test_elem : detail::multiplexer_elem
+{
+    std::size_t num_done{};
+    std::error_code ec;
+
+    test_elem(const request& req, check& handler) : detail::multiplexer_elem{&req, &handler, &on_done} {}
+
+    static void on_done(detail::multiplexer_elem& elm, std::error_code ec)
+    {
+        auto& self = static_cast<test_elem&>(elm);
+        ++self.num_done;
+        self.ec = ec;
+    }
+};
+
+struct fixture
+{
+    multiplexer mpx;
+    check handler;
+    request req1, req2, req3;
+    test_elem elm1{req1, handler}, elm2{req2, handler}, elm3{req3, handler};
+
+    fixture()
+    {
+        req1.add_simple_query("SELECT 1");
+        req2.add_simple_query("SELECT 2");
+        req3.add_simple_query("SELECT 'a bigger query'");
+    }
+
+    std::size_t num_done() const { return elm1.num_done + elm2.num_done + elm3.num_done; }
+
+    // Simulates the server response to one of the simple queries
+    void complete_one()
+    {
+        BOOST_TEST_EQ(mpx.on_message(protocol::command_complete{}), std::error_code());
+        BOOST_TEST_EQ(mpx.on_message(protocol::ready_for_query{}), std::error_code());
+    }
+};
+
+// Without a limit, all pending requests are written together
+void test_prepare_write_all()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.add(fix.elm3);
+    const std::size_t total = fix.req1.payload_size() + fix.req2.payload_size() + fix.req3.payload_size();
+    BOOST_TEST(fix.mpx.has_pending());
+    BOOST_TEST_EQ(fix.mpx.pending_bytes(), total);
+
+    // Act
+    auto buff = fix.mpx.prepare_write();
+
+    // Assert
+    BOOST_TEST_EQ(buff.size(), total);
+    BOOST_TEST(!fix.mpx.has_pending());
+    BOOST_TEST_EQ(fix.mpx.pending_bytes(), 0u);
+    BOOST_TEST_EQ(fix.mpx.stats().writes, 1u);
+    BOOST_TEST_EQ(fix.mpx.stats().requests_written, 3u);
+    BOOST_TEST_EQ(fix.mpx.stats().bytes_written, total);
+    BOOST_TEST_EQ(fix.mpx.stats().max_requests_per_write, 3u);
+    BOOST_TEST_EQ(fix.mpx.stats().max_bytes_per_write, total);
+}
+
+// Batches are limited in size. Requests that don't fit remain pending, in order
+void test_prepare_write_max_size()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.add(fix.elm3);
+    const std::size_t size1 = fix.req1.payload_size(), size2 = fix.req2.payload_size();
+    const std::size_t size3 = fix.req3.payload_size();
+
+    // The first two requests fit
+    auto buff = fix.mpx.prepare_write(size1 + size2 + 1u);
+    BOOST_TEST_EQ(buff.size(), size1 + size2);
+    BOOST_TEST(fix.mpx.has_pending());
+    BOOST_TEST_EQ(fix.mpx.pending_bytes(), size3);
+
+    // A request bigger than the limit is written on its own
+    buff = fix.mpx.prepare_write(1u);
+    BOOST_TEST_EQ(buff.size(), size3);
+    BOOST_TEST(!fix.mpx.has_pending());
+
+    // Nothing else to write
+    buff = fix.mpx.prepare_write(1u);
+    BOOST_TEST(buff.empty());
+
+    // Stats
+    BOOST_TEST_EQ(fix.mpx.stats().writes, 2u);
+    BOOST_TEST_EQ(fix.mpx.stats().requests_written, 3u);
+    BOOST_TEST_EQ(fix.mpx.stats().bytes_written, size1 + size2 + size3);
+    BOOST_TEST_EQ(fix.mpx.stats().max_requests_per_write, 2u);
+    BOOST_TEST_EQ(fix.mpx.stats().max_bytes_per_write, (std::max)(size1 + size2, size3));
+}
+
+// Cancelled requests are not written, and don't count as pending
+void test_prepare_write_cancelled()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.cancel(fix.elm1);
+    BOOST_TEST_EQ(fix.mpx.pending_bytes(), fix.req2.payload_size());
+
+    // Act
+    auto buff = fix.mpx.prepare_write(fix.req2.payload_size());
+
+    // Assert
+    BOOST_TEST_EQ(buff.size(), fix.req2.payload_size());
+    BOOST_TEST(!fix.mpx.has_pending());
+    BOOST_TEST_EQ(fix.mpx.stats().requests_written, 1u);
+}
+
+// If all pending requests were cancelled, there is nothing to write
+void test_prepare_write_all_cancelled()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.cancel(fix.elm1);
+    BOOST_TEST(!fix.mpx.has_pending());
+    BOOST_TEST_EQ(fix.mpx.pending_bytes(), 0u);
+
+    // Act
+    auto buff = fix.mpx.prepare_write();
+
+    // Assert
+    BOOST_TEST(buff.empty());
+    BOOST_TEST(!fix.mpx.has_pending());
+    BOOST_TEST_EQ(fix.mpx.stats().writes, 0u);
+}
+
+// The number of requests in flight can be limited
+void test_in_flight_requests_limit()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.set_in_flight_limits(2u, (std::numeric_limits<std::size_t>::max)());
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.add(fix.elm3);
+
+    // Only two requests can be in flight
+    auto buff = fix.mpx.prepare_write();
+    BOOST_TEST_EQ(buff.size(), fix.req1.payload_size() + fix.req2.payload_size());
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 2u);
+    BOOST_TEST_EQ(fix.mpx.pending_count(), 1u);
+    BOOST_TEST(!fix.mpx.can_write());
+    BOOST_TEST(fix.mpx.prepare_write().empty());
+
+    // A response arrives, freeing space for the remaining one
+    fix.complete_one();
+    BOOST_TEST_EQ(fix.num_done(), 1u);
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 1u);
+    BOOST_TEST(fix.mpx.can_write());
+    buff = fix.mpx.prepare_write();
+    BOOST_TEST_EQ(buff.size(), fix.req3.payload_size());
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 2u);
+    BOOST_TEST(!fix.mpx.has_pending());
+    BOOST_TEST(!fix.mpx.can_write());
+}
+
+// The number of bytes in flight can be limited.
+// Requests bigger than the limit are written once nothing else is in flight
+void test_in_flight_bytes_limit()
+{
+    // Arrange
+    fixture fix;
+    const std::size_t size1 = fix.req1.payload_size(), size2 = fix.req2.payload_size();
+    BOOST_TEST_GT(fix.req3.payload_size(), size1 + size2);
+    fix.mpx.set_in_flight_limits((std::numeric_limits<std::size_t>::max)(), size1 + size2);
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.add(fix.elm3);
+
+    // The first two requests fill the window
+    auto buff = fix.mpx.prepare_write();
+    BOOST_TEST_EQ(buff.size(), size1 + size2);
+    BOOST_TEST_EQ(fix.mpx.in_flight_bytes(), size1 + size2);
+    BOOST_TEST(!fix.mpx.can_write());
+
+    // Freeing part of the window is not enough
+    fix.complete_one();
+    BOOST_TEST_EQ(fix.mpx.in_flight_bytes(), size2);
+    BOOST_TEST(!fix.mpx.can_write());
+
+    // Once nothing is in flight, the big request is written
+    fix.complete_one();
+    BOOST_TEST_EQ(fix.mpx.in_flight_bytes(), 0u);
+    BOOST_TEST(fix.mpx.can_write());
+    buff = fix.mpx.prepare_write();
+    BOOST_TEST_EQ(buff.size(), fix.req3.payload_size());
+    BOOST_TEST_EQ(fix.mpx.in_flight_bytes(), fix.req3.payload_size());
+}
+
+// Cancelled requests keep occupying the window until their response is received,
+// since the server is still processing them
+void test_in_flight_cancelled()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.set_in_flight_limits(1u, (std::numeric_limits<std::size_t>::max)());
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    BOOST_TEST_EQ(fix.mpx.prepare_write().size(), fix.req1.payload_size());
+
+    // Cancelling doesn't free the window
+    fix.mpx.cancel(fix.elm1);
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 1u);
+    BOOST_TEST(!fix.mpx.can_write());
+
+    // Receiving the response does
+    fix.complete_one();
+    BOOST_TEST_EQ(fix.num_done(), 0u);
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 0u);
+    BOOST_TEST(fix.mpx.can_write());
+    BOOST_TEST_EQ(fix.mpx.prepare_write().size(), fix.req2.payload_size());
+}
+
+// The pending count excludes cancelled requests
+void test_pending_count()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    BOOST_TEST_EQ(fix.mpx.pending_count(), 2u);
+
+    // Act
+    fix.mpx.cancel(fix.elm1);
+
+    // Assert
+    BOOST_TEST_EQ(fix.mpx.pending_count(), 1u);
+    fix.mpx.prepare_write();
+    BOOST_TEST_EQ(fix.mpx.pending_count(), 0u);
+}
+
+// Losing the connection empties the window
+void test_cleanup_in_flight()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.prepare_write();
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 2u);
+
+    // Act
+    fix.mpx.cleanup();
+
+    // Assert
+    BOOST_TEST_EQ(fix.num_done(), 2u);
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 0u);
+    BOOST_TEST_EQ(fix.mpx.in_flight_bytes(), 0u);
+}
+
+// Once buffers have grown, running requests doesn't allocate, even if they are cancelled
+void test_steady_state_no_allocations()
+{
+    // Arrange
+    fixture fix;
+    auto run_requests = [&fix] {
+        fix.mpx.add(fix.elm1);
+        fix.mpx.add(fix.elm2);
+        fix.mpx.add(fix.elm3);
+        fix.mpx.cancel(fix.elm3);  // cancelled while pending
+        BOOST_TEST(!fix.mpx.prepare_write().empty());
+        fix.mpx.cancel(fix.elm2);  // cancelled while in flight
+        fix.complete_one();
+        fix.complete_one();
+    };
+    run_requests();  // warm up
+    const std::size_t initial_allocations = num_allocations;
+
+    // Act
+    for (int i = 0; i < 100; ++i)
+        run_requests();
+
+    // Assert
+    BOOST_TEST_EQ(num_allocations, initial_allocations);
+    BOOST_TEST_EQ(fix.elm1.num_done, 101u);
+    BOOST_TEST_EQ(fix.elm2.num_done, 0u);
+    BOOST_TEST_EQ(fix.elm3.num_done, 0u);
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 0u);
+}
+
+// Cancelling a request in flight (e.g. because its timeout elapsed) abandons it.
+// The response that was already on its way is discarded
+void test_cancel_in_flight_response_discarded()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.prepare_write();
+
+    // Act
+    fix.mpx.cancel(fix.elm1);
+    fix.complete_one();
+
+    // Assert
+    BOOST_TEST_EQ(fix.elm1.num_done, 0u);
+    BOOST_TEST_EQ(fix.elm2.num_done, 0u);
+    BOOST_TEST_EQ(fix.mpx.in_flight_count(), 1u);
+
+    // The next response is matched to the next request
+    fix.complete_one();
+    BOOST_TEST_EQ(fix.elm1.num_done, 0u);
+    BOOST_TEST_EQ(fix.elm2.num_done, 1u);
+    BOOST_TEST_EQ(fix.elm2.ec, std::error_code());
+}
+
+// Same, if part of the response had been read when the request was cancelled
+void test_cancel_in_flight_partial_response()
+{
+    // Arrange
+    fixture fix;
+    fix.mpx.add(fix.elm1);
+    fix.mpx.add(fix.elm2);
+    fix.mpx.prepare_write();
+    BOOST_TEST_EQ(fix.mpx.on_message(protocol::command_complete{}), std::error_code());
+
+    // Act
+    fix.mpx.cancel(fix.elm1);
+    BOOST_TEST_EQ(fix.mpx.on_message(protocol::ready_for_query{}), std::error_code());
+
+    // Assert
+    BOOST_TEST_EQ(fix.num_done(), 0u);
+    fix.complete_one();
+    BOOST_TEST_EQ(fix.elm1.num_done, 0u);
+    BOOST_TEST_EQ(fix.elm2.num_done, 1u);
+}
+
+const auto t0 = health_monitor::clock::time_point{} + std::chrono::hours(1);
+
+// Pings are queued periodically, but not while the previous one is outstanding
+void test_health_ping_not_requeued()
+{
+    // Arrange
+    multiplexer mpx;
+    health_monitor health;
+    health.set_config(seconds(10), {});
+    health.reset(t0);
+    BOOST_TEST(health.next_check(mpx, t0) == t0 + seconds(10));
+
+    // Not due yet
+    BOOST_TEST(health.check(mpx, t0 + seconds(9)) == health_monitor::action::none);
+    BOOST_TEST_EQ(mpx.pending_count(), 0u);
+
+    // Due
+    BOOST_TEST(health.check(mpx, t0 + seconds(10)) == health_monitor::action::ping);
+    BOOST_TEST(health.ping_queued());
+    BOOST_TEST_EQ(mpx.pending_count(), 1u);
+    BOOST_TEST(health.next_check(mpx, t0 + seconds(10)) == t0 + seconds(20));
+
+    // Due again, but the previous ping is outstanding, so it's not queued twice
+    BOOST_TEST(health.check(mpx, t0 + seconds(20)) == health_monitor::action::none);
+    BOOST_TEST_EQ(mpx.pending_count(), 1u);
+    BOOST_TEST(!mpx.prepare_write().empty());
+    BOOST_TEST(health.check(mpx, t0 + seconds(30)) == health_monitor::action::none);
+    BOOST_TEST_EQ(mpx.in_flight_count(), 1u);
+
+    // Once the server answers, pings are queued again
+    BOOST_TEST_EQ(mpx.on_message(protocol::ready_for_query{}), std::error_code());
+    BOOST_TEST(!health.ping_queued());
+    BOOST_TEST(health.check(mpx, t0 + seconds(40)) == health_monitor::action::ping);
+    BOOST_TEST_EQ(mpx.pending_count(), 1u);
+}
+
+// Disabled checks never become due
+void test_health_disabled()
+{
+    // Arrange
+    multiplexer mpx;
+    health_monitor health;
+    health.set_config({}, {});
+    health.reset(t0);
+
+    // Act/Assert
+    BOOST_TEST(health.next_check(mpx, t0) == (health_monitor::clock::time_point::max)());
+    BOOST_TEST(health.check(mpx, t0 + std::chrono::hours(10)) == health_monitor::action::none);
+    BOOST_TEST_EQ(mpx.pending_count(), 0u);
+}
+
+// Stalls are only detected while requests are in flight
+void test_health_stall_only_in_flight()
+{
+    // Arrange
+    fixture fix;
+    health_monitor health;
+    health.set_config({}, seconds(5));
+    health.reset(t0);
+
+    // Nothing is received for a long time, but we're not waiting for anything
+    const auto t1 = t0 + seconds(100);
+    BOOST_TEST(health.check(fix.mpx, t1) == health_monitor::action::none);
+    BOOST_TEST(health.next_check(fix.mpx, t1) == t1 + seconds(5));
+
+    // Pending requests don't count, since the server doesn't know about them
+    fix.mpx.add(fix.elm1);
+    BOOST_TEST(health.check(fix.mpx, t1) == health_monitor::action::none);
+
+    // Once written, the request waits for a response since then
+    fix.mpx.prepare_write();
+    health.on_write(true, t1);
+    BOOST_TEST(health.next_check(fix.mpx, t1) == t1 + seconds(5));
+    BOOST_TEST(health.check(fix.mpx, t1 + seconds(4)) == health_monitor::action::none);
+
+    // Receiving bytes is progress
+    health.on_read(t1 + seconds(4));
+    BOOST_TEST(health.check(fix.mpx, t1 + seconds(5)) == health_monitor::action::none);
+    BOOST_TEST(health.next_check(fix.mpx, t1 + seconds(5)) == t1 + seconds(9));
+
+    // Nothing arrives for too long
+    BOOST_TEST(health.check(fix.mpx, t1 + seconds(9)) == health_monitor::action::stalled);
+
+    // Once the response arrives, there's nothing to wait for
+    fix.complete_one();
+    BOOST_TEST(health.check(fix.mpx, t1 + seconds(100)) == health_monitor::action::none);
+}
+
+// Writing while other requests are in flight doesn't hide a stall
+void test_health_stall_write_not_idle()
+{
+    // Arrange
+    fixture fix;
+    health_monitor health;
+    health.set_config({}, seconds(5));
+    health.reset(t0);
+    fix.mpx.add(fix.elm1);
+    fix.mpx.prepare_write();
+    health.on_write(true, t0);
+
+    // Act
+    fix.mpx.add(fix.elm2);
+    fix.mpx.prepare_write();
+    health.on_write(false, t0 + seconds(4));
+
+    // Assert
+    BOOST_TEST(health.check(fix.mpx, t0 + seconds(5)) == health_monitor::action::stalled);
+}
+
+}  // namespace
+
+int main()
+{
+    test_prepare_write_all();
+    test_prepare_write_max_size();
+    test_prepare_write_cancelled();
+    test_prepare_write_all_cancelled();
+    test_in_flight_requests_limit();
+    test_in_flight_bytes_limit();
+    test_in_flight_cancelled();
+    test_pending_count();
+    test_cleanup_in_flight();
+    test_steady_state_no_allocations();
+    test_cancel_in_flight_response_discarded();
+    test_cancel_in_flight_partial_response();
+    test_health_ping_not_requeued();
+    test_health_disabled();
+    test_health_stall_only_in_flight();
+    test_health_stall_write_not_idle();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,336 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "nativepg/notification_batch.hpp"
+#include "nativepg/notification_event.hpp"
+#include "nativepg_internal/channel_table.hpp"
+#include "nativepg_internal/notification_buffer.hpp"
+
+using namespace nativepg;
+using detail::notification_buffer;
+using std::chrono::steady_clock;
+
+namespace {
+
+const auto t0 = steady_clock::time_point{} + std::chrono::hours(1);
+
+// Interns channels, like the notification queue does
+detail::channel_table channels;
+
+bool add_notify(
+    notification_buffer& buff,
+    std::string_view channel,
+    steady_clock::time_point now,
+    std::string_view payload = "abc"
+)
+{
+    auto id = channels.intern(channel);
+    return buff.add_notify(42, id, channels.name(id), payload, now);
+}
+
+// Notifications are stored until they're taken
+void test_notify()
+{
+    // Arrange
+    notification_buffer buff{4u, notification_overflow_policy::drop};
+    notification_batch events;
+
+    // Act
+    BOOST_TEST(add_notify(buff, "ch1", t0, "p1"));
+    BOOST_TEST(add_notify(buff, "ch2", t0, "p2"));
+    buff.take(events, t0);
+
+    // Assert
+    BOOST_TEST(buff.empty());
+    BOOST_TEST_EQ(events.size(), 2u);
+    BOOST_TEST(events[0].type == notification_event_type::notify);
+    BOOST_TEST_EQ(events[0].backend_pid, 42);
+    BOOST_TEST_EQ(events[0].channel, "ch1");
+    BOOST_TEST_EQ(events[0].payload, "p1");
+    BOOST_TEST_EQ(events[1].channel, "ch2");
+    BOOST_TEST_EQ(events[1].payload, "p2");
+    BOOST_TEST_EQ(buff.stats().received, 2u);
+    BOOST_TEST_EQ(buff.stats().dropped, 0u);
+    BOOST_TEST_EQ(buff.stats().max_queued, 2u);
+}
+
+// With the drop policy, notifications that don't fit are discarded.
+// Discarded notifications are coalesced into an overflow event per channel
+void test_overflow_drop()
+{
+    // Arrange
+    notification_buffer buff{2u, notification_overflow_policy::drop};
+    notification_batch events;
+    add_notify(buff, "ch1", t0);
+    add_notify(buff, "ch1", t0);
+    BOOST_TEST(!buff.has_space());
+
+    // Act
+    BOOST_TEST(add_notify(buff, "ch1", t0));
+    BOOST_TEST(add_notify(buff, "ch2", t0));
+    BOOST_TEST(add_notify(buff, "ch1", t0));
+    buff.take(events, t0);
+
+    // Assert
+    BOOST_TEST_EQ(events.size(), 4u);
+    BOOST_TEST(events[2].type == notification_event_type::overflow);
+    BOOST_TEST_EQ(events[2].channel, "ch1");
+    BOOST_TEST_EQ(events[2].num_dropped, 2u);
+    BOOST_TEST(events[3].type == notification_event_type::overflow);
+    BOOST_TEST_EQ(events[3].channel, "ch2");
+    BOOST_TEST_EQ(events[3].num_dropped, 1u);
+    BOOST_TEST_EQ(buff.stats().received, 5u);
+    BOOST_TEST_EQ(buff.stats().dropped, 3u);
+
+    // Once taken, there is space again
+    BOOST_TEST(buff.has_space());
+    BOOST_TEST(add_notify(buff, "ch1", t0));
+    buff.take(events, t0);
+    BOOST_TEST_EQ(events.size(), 1u);
+    BOOST_TEST(events[0].type == notification_event_type::notify);
+}
+
+// Overflow events coalesce even if connection events are interleaved
+void test_overflow_drop_disconnect()
+{
+    // Arrange
+    notification_buffer buff{1u, notification_overflow_policy::drop};
+    notification_batch events;
+    add_notify(buff, "ch1", t0);
+
+    // Act
+    add_notify(buff, "ch1", t0);
+    buff.add_disconnect(t0);
+    add_notify(buff, "ch1", t0);
+    buff.take(events, t0);
+
+    // Assert
+    BOOST_TEST_EQ(events.size(), 3u);
+    BOOST_TEST(events[1].type == notification_event_type::overflow);
+    BOOST_TEST_EQ(events[1].num_dropped, 2u);
+    BOOST_TEST(events[2].type == notification_event_type::disconnect);
+}
+
+// With the block policy, the caller is told to wait for space
+void test_overflow_block()
+{
+    // Arrange
+    notification_buffer buff{1u, notification_overflow_policy::block};
+    notification_batch events;
+    BOOST_TEST(add_notify(buff, "ch1", t0));
+
+    // Act
+    BOOST_TEST(!add_notify(buff, "ch2", t0));
+
+    // Assert
+    BOOST_TEST_EQ(buff.stats().received, 1u);
+    BOOST_TEST_EQ(buff.stats().dropped, 0u);
+    buff.take(events, t0);
+    BOOST_TEST(add_notify(buff, "ch2", t0));
+}
+
+// A disconnect right after a connect removes it
+void test_connect_disconnect()
+{
+    // Arrange
+    notification_buffer buff{4u, notification_overflow_policy::drop};
+    notification_batch events;
+
+    // Act
+    buff.add_connect(t0);
+    buff.add_disconnect(t0);
+
+    // Assert
+    BOOST_TEST(buff.empty());
+    buff.add_disconnect(t0);
+    buff.take(events, t0);
+    BOOST_TEST_EQ(events.size(), 1u);
+    BOOST_TEST(events[0].type == notification_event_type::disconnect);
+}
+
+// The lag is the time the oldest event in a batch spent queued
+void test_lag()
+{
+    // Arrange
+    notification_buffer buff{4u, notification_overflow_policy::drop};
+    notification_batch events;
+
+    // First batch
+    add_notify(buff, "ch1", t0);
+    add_notify(buff, "ch1", t0 + std::chrono::seconds(1));
+    buff.take(events, t0 + std::chrono::seconds(3));
+    BOOST_TEST(buff.stats().last_lag == std::chrono::seconds(3));
+    BOOST_TEST(buff.stats().max_lag == std::chrono::seconds(3));
+
+    // Second batch
+    add_notify(buff, "ch1", t0 + std::chrono::seconds(10));
+    buff.take(events, t0 + std::chrono::seconds(11));
+    BOOST_TEST(buff.stats().last_lag == std::chrono::seconds(1));
+    BOOST_TEST(buff.stats().max_lag == std::chrono::seconds(3));
+}
+
+// Batches can be iterated, and expose the interned channel IDs
+void test_batch_iteration()
+{
+    // Arrange
+    notification_buffer buff{8u, notification_overflow_policy::drop};
+    notification_batch events;
+    add_notify(buff, "ch1", t0, "first");
+    add_notify(buff, "ch2", t0, "");
+    add_notify(buff, "ch1", t0, "third");
+
+    // Act
+    buff.take(events, t0);
+
+    // Assert
+    std::vector<std::string_view> payloads;
+    for (auto evt : events)
+        payloads.push_back(evt.payload);
+    const std::vector<std::string_view> expected{"first", "", "third"};
+    BOOST_TEST_ALL_EQ(payloads.begin(), payloads.end(), expected.begin(), expected.end());
+    BOOST_TEST_EQ(events[0].channel_id, channels.intern("ch1"));
+    BOOST_TEST_EQ(events[1].channel_id, channels.intern("ch2"));
+    BOOST_TEST_EQ(events[2].channel_id, events[0].channel_id);
+}
+
+// Reading into the same batch again replaces its contents
+void test_batch_reuse()
+{
+    // Arrange
+    notification_buffer buff{8u, notification_overflow_policy::drop};
+    notification_batch events;
+    add_notify(buff, "ch1", t0, "first");
+    add_notify(buff, "ch1", t0, "second");
+    buff.take(events, t0);
+
+    // Act
+    add_notify(buff, "ch2", t0, "third");
+    buff.take(events, t0);
+
+    // Assert
+    BOOST_TEST_EQ(events.size(), 1u);
+    BOOST_TEST_EQ(events[0].channel, "ch2");
+    BOOST_TEST_EQ(events[0].payload, "third");
+    BOOST_TEST(buff.empty());
+}
+
+// Channel names are stored once, and get stable IDs
+void test_channel_table()
+{
+    // Arrange
+    detail::channel_table table;
+
+    // Act
+    auto id1 = table.intern("ch1");
+    auto id2 = table.intern("ch2");
+    std::string name = "ch1";
+
+    // Assert
+    BOOST_TEST_NE(id1, id2);
+    BOOST_TEST_EQ(table.intern(name), id1);
+    BOOST_TEST_EQ(table.name(id1), "ch1");
+    BOOST_TEST_EQ(table.name(id2), "ch2");
+    BOOST_TEST_EQ(table.size(), 2u);
+    BOOST_TEST(table.subscribers(id1).empty());
+}
+
+// Looking up a channel doesn't add it
+void test_channel_table_find()
+{
+    // Arrange
+    detail::channel_table table;
+    auto id = table.intern("ch1");
+
+    // Act
+    auto res1 = table.find("ch1");
+    auto res2 = table.find("ch2");
+
+    // Assert
+    BOOST_TEST_EQ(res1, id);
+    BOOST_TEST_EQ(res2, no_channel_id);
+    BOOST_TEST_EQ(table.size(), 1u);
+}
+
+// Channels without an ID have their names copied to the batch,
+// so they don't need to outlive it
+void test_notify_no_channel_id()
+{
+    // Arrange
+    notification_buffer buff{4u, notification_overflow_policy::drop};
+    notification_batch events;
+    std::string channel1 = "dynamic_1", channel2 = "dynamic_2";
+
+    // Act
+    BOOST_TEST(buff.add_notify(42, no_channel_id, channel1, "p1", t0));
+    BOOST_TEST(buff.add_notify(42, no_channel_id, channel2, "p2", t0));
+    channel1.assign(channel1.size(), 'x');
+    channel2.assign(channel2.size(), 'x');
+    buff.take(events, t0);
+
+    // Assert
+    if (BOOST_TEST_EQ(events.size(), 2u))
+    {
+        BOOST_TEST_EQ(events[0].channel_id, no_channel_id);
+        BOOST_TEST_EQ(events[0].channel, "dynamic_1");
+        BOOST_TEST_EQ(events[0].payload, "p1");
+        BOOST_TEST_EQ(events[1].channel, "dynamic_2");
+        BOOST_TEST_EQ(events[1].payload, "p2");
+    }
+}
+
+// Overflow events for channels without an ID are coalesced by name
+void test_overflow_no_channel_id()
+{
+    // Arrange
+    notification_buffer buff{1u, notification_overflow_policy::drop};
+    notification_batch events;
+    BOOST_TEST(buff.add_notify(42, no_channel_id, "dynamic_1", "p", t0));
+
+    // Act
+    BOOST_TEST(buff.add_notify(42, no_channel_id, "dynamic_1", "p", t0));
+    BOOST_TEST(buff.add_notify(42, no_channel_id, "dynamic_2", "p", t0));
+    BOOST_TEST(buff.add_notify(42, no_channel_id, "dynamic_1", "p", t0));
+    buff.take(events, t0);
+
+    // Assert
+    if (BOOST_TEST_EQ(events.size(), 3u))
+    {
+        BOOST_TEST(events[1].type == notification_event_type::overflow);
+        BOOST_TEST_EQ(events[1].channel, "dynamic_1");
+        BOOST_TEST_EQ(events[1].num_dropped, 2u);
+        BOOST_TEST(events[2].type == notification_event_type::overflow);
+        BOOST_TEST_EQ(events[2].channel, "dynamic_2");
+        BOOST_TEST_EQ(events[2].num_dropped, 1u);
+    }
+}
+
+}  // namespace
+
+int main()
+{
+    test_notify();
+    test_overflow_drop();
+    test_overflow_drop_disconnect();
+    test_overflow_block();
+    test_connect_disconnect();
+    test_lag();
+    test_batch_iteration();
+    test_batch_reuse();
+    test_channel_table();
+    test_channel_table_find();
+    test_notify_no_channel_id();
+    test_overflow_no_channel_id();
+
+    return boost::report_errors();
+}
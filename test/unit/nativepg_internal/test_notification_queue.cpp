@@ -0,0 +1,254 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/capy/delay.hpp>
+#include <boost/capy/ex/async_event.hpp>
+#include <boost/capy/ex/run_async.hpp>
+#include <boost/capy/ex/this_coro.hpp>
+#include <boost/capy/task.hpp>
+#include <boost/core/lightweight_test.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "nativepg/notification_batch.hpp"
+#include "nativepg/notification_event.hpp"
+#include "nativepg/protocol/async.hpp"
+#include "nativepg_internal/notification_queue.hpp"
+#include "test_utils/corosio_utils.hpp"
+
+namespace capy = boost::capy;
+using namespace nativepg;
+using namespace nativepg::test;
+using detail::notification_queue;
+
+namespace {
+
+protocol::notification_response make_notify(std::string_view channel, std::string_view payload = "abc")
+{
+    return {.process_id = 42, .channel_name = channel, .payload = payload};
+}
+
+// Gives tasks launched with run_async the chance to run until they block
+capy::task<> yield()
+{
+    [[maybe_unused]] auto [ec] = co_await capy::delay(std::chrono::milliseconds(10));
+}
+
+// Background producer. Sets done and signals the event when finished
+capy::task<> add_notify_task(
+    notification_queue& queue,
+    const protocol::notification_response& msg,
+    bool& done,
+    capy::async_event& evt
+)
+{
+    auto [ec] = co_await queue.add_notify(msg);
+    BOOST_TEST_EQ(ec, std::error_code());
+    done = true;
+    evt.set();
+}
+
+// Notifications to channels with subscribers are delivered only to them.
+// The rest go to the default consumer
+capy::task<> test_subscribers_bypass_default()
+{
+    // Arrange
+    notification_queue queue{16u, notification_overflow_policy::drop};
+    auto sub = queue.subscribe("ch1");
+    notification_batch default_events, sub_events;
+
+    // Act
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1", "p1")));
+    BOOST_TEST(queue.try_add_notify(make_notify("ch2", "p2")));
+    auto [ec1] = co_await queue.read_events(default_events);
+    auto [ec2] = co_await queue.read_events(*sub, sub_events);
+
+    // Assert
+    BOOST_TEST_EQ(ec1, std::error_code());
+    BOOST_TEST_EQ(ec2, std::error_code());
+    if (BOOST_TEST_EQ(default_events.size(), 1u))
+    {
+        BOOST_TEST_EQ(default_events[0].channel, "ch2");
+        BOOST_TEST_EQ(default_events[0].payload, "p2");
+    }
+    if (BOOST_TEST_EQ(sub_events.size(), 1u))
+    {
+        BOOST_TEST_EQ(sub_events[0].channel, "ch1");
+        BOOST_TEST_EQ(sub_events[0].payload, "p1");
+    }
+    BOOST_TEST_EQ(queue.stats().received, 2u);
+}
+
+// Notifications to channels that were never subscribed to don't intern the channel.
+// The default consumer's batch holds the name
+capy::task<> test_unsubscribed_channel_not_interned()
+{
+    // Arrange
+    notification_queue queue{16u, notification_overflow_policy::drop};
+    auto sub = queue.subscribe("ch1");
+    std::string channel = "dynamic_1";
+    notification_batch events;
+
+    // Act
+    BOOST_TEST(queue.try_add_notify(make_notify(channel, "p1")));
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1", "p2")));
+    channel.assign(channel.size(), 'x');
+    auto [ec] = co_await queue.read_events(events);
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    if (BOOST_TEST_EQ(events.size(), 1u))
+    {
+        BOOST_TEST_EQ(events[0].channel_id, no_channel_id);
+        BOOST_TEST_EQ(events[0].channel, "dynamic_1");
+        BOOST_TEST_EQ(events[0].payload, "p1");
+    }
+    BOOST_TEST_NE(sub->channel, no_channel_id);
+    BOOST_TEST_EQ(queue.channel_name(sub->channel), "ch1");
+}
+
+// All the subscribers to a channel get its notifications
+capy::task<> test_fan_out()
+{
+    // Arrange
+    notification_queue queue{16u, notification_overflow_policy::drop};
+    auto sub1 = queue.subscribe("ch1");
+    auto sub2 = queue.subscribe("ch1");
+    auto sub3 = queue.subscribe("ch2");
+    notification_batch events1, events2, events3;
+
+    // Act
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1", "p1")));
+    BOOST_TEST(queue.try_add_notify(make_notify("ch2", "p2")));
+    auto [ec1] = co_await queue.read_events(*sub1, events1);
+    auto [ec2] = co_await queue.read_events(*sub2, events2);
+    auto [ec3] = co_await queue.read_events(*sub3, events3);
+
+    // Assert
+    BOOST_TEST_EQ(ec1, std::error_code());
+    BOOST_TEST_EQ(ec2, std::error_code());
+    BOOST_TEST_EQ(ec3, std::error_code());
+    if (BOOST_TEST_EQ(events1.size(), 1u))
+        BOOST_TEST_EQ(events1[0].payload, "p1");
+    if (BOOST_TEST_EQ(events2.size(), 1u))
+        BOOST_TEST_EQ(events2[0].payload, "p1");
+    if (BOOST_TEST_EQ(events3.size(), 1u))
+        BOOST_TEST_EQ(events3[0].payload, "p2");
+    BOOST_TEST_EQ(queue.stats().received, 2u);  // Each notification counts once
+}
+
+// With the block policy, a notification is only delivered if all its targets have space
+capy::task<> test_block_requires_space_in_all_targets()
+{
+    // Arrange
+    notification_queue queue{1u, notification_overflow_policy::block};
+    auto sub1 = queue.subscribe("ch1");
+    auto sub2 = queue.subscribe("ch1");
+    notification_batch events;
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1", "p1")));
+    auto [ec1] = co_await queue.read_events(*sub2, events);
+    BOOST_TEST_EQ(ec1, std::error_code());
+
+    // Act: sub2 has space but sub1 doesn't
+    BOOST_TEST(!queue.try_add_notify(make_notify("ch1", "p2")));
+
+    // Assert: nothing was delivered to sub2, either
+    BOOST_TEST(sub2->buffer.empty());
+    BOOST_TEST_EQ(queue.stats().received, 1u);
+
+    // Other channels are not affected
+    BOOST_TEST(queue.try_add_notify(make_notify("ch2", "p3")));
+
+    // Once sub1 reads, the notification is delivered to both
+    auto [ec2] = co_await queue.read_events(*sub1, events);
+    BOOST_TEST_EQ(ec2, std::error_code());
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1", "p2")));
+    auto [ec3] = co_await queue.read_events(*sub1, events);
+    BOOST_TEST_EQ(ec3, std::error_code());
+    if (BOOST_TEST_EQ(events.size(), 1u))
+        BOOST_TEST_EQ(events[0].payload, "p2");
+    auto [ec4] = co_await queue.read_events(*sub2, events);
+    BOOST_TEST_EQ(ec4, std::error_code());
+    if (BOOST_TEST_EQ(events.size(), 1u))
+        BOOST_TEST_EQ(events[0].payload, "p2");
+}
+
+// A producer waiting for a subscriber to make space is woken up if it unsubscribes.
+// The notification then goes to the default consumer
+capy::task<> test_unsubscribe_wakes_producer()
+{
+    // Arrange
+    notification_queue queue{1u, notification_overflow_policy::block};
+    auto sub = queue.subscribe("ch1");
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1", "p1")));
+    const auto msg = make_notify("ch1", "p2");
+    bool done = false;
+    capy::async_event done_evt;
+    capy::run_async(co_await capy::this_coro::executor)(add_notify_task(queue, msg, done, done_evt));
+    co_await yield();
+    BOOST_TEST(!done);
+
+    // Act
+    sub.reset();
+    auto [ec1] = co_await done_evt.wait();
+
+    // Assert
+    BOOST_TEST_EQ(ec1, std::error_code());
+    BOOST_TEST(done);
+    notification_batch events;
+    auto [ec2] = co_await queue.read_events(events);
+    BOOST_TEST_EQ(ec2, std::error_code());
+    if (BOOST_TEST_EQ(events.size(), 1u))
+    {
+        BOOST_TEST_EQ(events[0].channel, "ch1");
+        BOOST_TEST_EQ(events[0].payload, "p2");
+    }
+}
+
+// Destroying a subscriber doesn't lose its statistics
+capy::task<> test_stats_after_unsubscribe()
+{
+    // Arrange
+    notification_queue queue{1u, notification_overflow_policy::drop};
+    auto sub = queue.subscribe("ch1");
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1")));
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1")));
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1")));
+
+    // Act
+    sub.reset();
+
+    // Assert
+    auto stats = queue.stats();
+    BOOST_TEST_EQ(stats.received, 3u);
+    BOOST_TEST_EQ(stats.dropped, 2u);
+    BOOST_TEST_EQ(stats.max_queued, 1u);
+
+    // Further notifications go to the default consumer, and add to the same stats
+    BOOST_TEST(queue.try_add_notify(make_notify("ch1")));
+    BOOST_TEST_EQ(queue.stats().received, 4u);
+    BOOST_TEST_EQ(queue.stats().dropped, 2u);
+    co_return;
+}
+
+}  // namespace
+
+int main()
+{
+    run_coroutine_test(test_subscribers_bypass_default());
+    run_coroutine_test(test_unsubscribed_channel_not_interned());
+    run_coroutine_test(test_fan_out());
+    run_coroutine_test(test_block_requires_space_in_all_targets());
+    run_coroutine_test(test_unsubscribe_wakes_producer());
+    run_coroutine_test(test_stats_after_unsubscribe());
+
+    return boost::report_errors();
+}
@@ -0,0 +1,379 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/protocol/command_complete.hpp"
+#include "nativepg/protocol/ready_for_query.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/check.hpp"
+#include "nativepg_internal/multiplexed_connection/multiplexer.hpp"
+#include "nativepg_internal/multiplexed_connection/remote_exec.hpp"
+#include "nativepg_internal/multiplexed_connection/submission_queue.hpp"
+
+using namespace nativepg;
+using detail::multiplexer;
+using detail::remote_exec_node;
+using detail::remote_exec_queue;
+using detail::submission_node;
+using detail::submission_queue;
+
+namespace {
+
+constexpr std::size_t no_limit = (std::numeric_limits<std::size_t>::max)();
+
+const std::error_code cancelled_ec = std::make_error_code(std::errc::operation_canceled);
+
+// A remote exec. Notifications are recorded in atomics, which the caller's thread polls
+struct test_op : remote_exec_node
+{
+    request req;
+    check handler;
+    std::atomic<bool> done{false};
+    std::atomic<bool> cancel_done{false};
+    std::atomic<int> num_done{0};
+
+    explicit test_op(bool valid = true) : remote_exec_node{req, &handler, &notify_caller}
+    {
+        if (valid)
+            req.add_simple_query("SELECT 1");
+    }
+
+    static void notify_caller(remote_exec_node& node, notification n)
+    {
+        auto& self = static_cast<test_op&>(node);
+        if (n == notification::done)
+        {
+            ++self.num_done;
+            self.done.store(true);
+        }
+        else
+        {
+            self.cancel_done.store(true);
+        }
+    }
+};
+
+// Asks the connection to cancel a request, like posting cancel_task does
+struct cancel_node : submission_node
+{
+    test_op* op;
+    explicit cancel_node(test_op& o) : op(&o) {}
+};
+
+// The connection. The multiplexer is driven like the writer and the reader do
+struct fake_connection
+{
+    remote_exec_queue remote;
+    submission_queue cancellations;
+    multiplexer mpx;
+    std::size_t max_queued_requests{no_limit};
+
+    bool open() { return remote.open(mpx, max_queued_requests, nullptr); }
+    bool drain() { return remote.drain(mpx, max_queued_requests, nullptr); }
+
+    void process_cancellations()
+    {
+        for (auto* n = cancellations.take_all(); n != nullptr;)
+        {
+            auto* next = n->next_submission;
+            remote.cancel(*static_cast<cancel_node&>(*n).op, mpx, max_queued_requests, nullptr);
+            n = next;
+        }
+    }
+
+    // Simulates the server response to the oldest request in flight
+    void complete_one()
+    {
+        BOOST_TEST_EQ(mpx.on_message(protocol::command_complete{}), std::error_code());
+        BOOST_TEST_EQ(mpx.on_message(protocol::ready_for_query{}), std::error_code());
+    }
+
+    // Writes what's pending, and responds to a request
+    void step()
+    {
+        drain();
+        process_cancellations();
+        mpx.prepare_write();
+        if (mpx.in_flight_count())
+            complete_one();
+    }
+};
+
+// The caller's side, as do_remote_exec implements it. Returns the operation's result
+std::error_code remote_exec(fake_connection& conn, test_op& op, bool cancel)
+{
+    conn.remote.submit(op);
+    if (cancel && !op.done.load())
+    {
+        // The connection never saw it
+        if (conn.remote.withdraw(op))
+            return cancelled_ec;
+
+        // Otherwise, ask the connection to cancel it, and wait for it to acknowledge
+        cancel_node cn{op};
+        conn.cancellations.push(cn);
+        while (!op.cancel_done.load())
+            std::this_thread::yield();
+        return op.done.load() ? op.result_ec : cancelled_ec;
+    }
+    while (!op.done.load())
+        std::this_thread::yield();
+    return op.result_ec;
+}
+
+// Only the first submission after draining asks to wake up the connection
+void test_submit_wake_up()
+{
+    // Arrange
+    fake_connection conn;
+    test_op op1, op2, op3;
+
+    // Act
+    bool res1 = conn.remote.submit(op1);  // parked
+    BOOST_TEST(conn.open());
+    bool res2 = conn.remote.submit(op2);
+    bool res3 = conn.remote.submit(op3);
+
+    // Assert
+    BOOST_TEST(!res1);
+    BOOST_TEST(res2);
+    BOOST_TEST(!res3);
+    BOOST_TEST(conn.drain());
+    BOOST_TEST(!conn.drain());
+    BOOST_TEST_EQ(conn.mpx.pending_count(), 3u);
+}
+
+// Submitted requests complete with their own responses
+void test_complete()
+{
+    // Arrange
+    fake_connection conn;
+    conn.open();
+    test_op op1, op2;
+    conn.remote.submit(op1);
+    conn.remote.submit(op2);
+
+    // Act
+    conn.step();
+    conn.step();
+
+    // Assert
+    BOOST_TEST_EQ(op1.num_done.load(), 1);
+    BOOST_TEST_EQ(op1.result_ec, std::error_code());
+    BOOST_TEST_EQ(op2.num_done.load(), 1);
+    BOOST_TEST_EQ(op2.result_ec, std::error_code());
+}
+
+// Invalid requests are completed with an error when taken, and never reach the multiplexer
+void test_invalid_request()
+{
+    // Arrange
+    fake_connection conn;
+    conn.open();
+    test_op op{false};
+    conn.remote.submit(op);
+
+    // Act
+    conn.drain();
+
+    // Assert
+    BOOST_TEST_EQ(op.num_done.load(), 1);
+    BOOST_TEST_EQ(op.result_ec, std::error_code(client_errc::empty_request));
+    BOOST_TEST(!conn.mpx.has_pending());
+}
+
+// Requests past max_queued_requests are rejected, like local ones
+void test_queue_full()
+{
+    // Arrange
+    fake_connection conn;
+    conn.max_queued_requests = 1u;
+    test_op op1, op2;
+    conn.remote.submit(op1);
+    conn.remote.submit(op2);
+
+    // Act
+    conn.open();
+
+    // Assert
+    BOOST_TEST_EQ(op1.num_done.load(), 0);
+    BOOST_TEST_EQ(op2.num_done.load(), 1);
+    BOOST_TEST_EQ(op2.result_ec, std::error_code(client_errc::queue_full));
+    BOOST_TEST_EQ(conn.mpx.pending_count(), 1u);
+}
+
+// A request cancelled before the connection runs is withdrawn, and the connection never sees it
+void test_cancel_before_open()
+{
+    // Arrange
+    fake_connection conn;
+    test_op op1, op2;
+    conn.remote.submit(op1);
+    conn.remote.submit(op2);
+
+    // Act
+    bool withdrawn = conn.remote.withdraw(op1);
+    conn.open();
+
+    // Assert
+    BOOST_TEST(withdrawn);
+    BOOST_TEST_EQ(conn.mpx.pending_count(), 1u);
+    conn.step();
+    BOOST_TEST_EQ(op1.num_done.load(), 0);
+    BOOST_TEST_EQ(op2.num_done.load(), 1);
+}
+
+// A request that is still in the queue is drained before being cancelled
+void test_cancel_queued()
+{
+    // Arrange
+    fake_connection conn;
+    conn.open();
+    test_op op1, op2;
+    conn.remote.submit(op1);
+    conn.remote.submit(op2);
+
+    // Act
+    bool withdrawn = conn.remote.withdraw(op1);
+    bool drained = conn.remote.cancel(op1, conn.mpx, no_limit, nullptr);
+
+    // Assert: op2 was drained, too
+    BOOST_TEST(!withdrawn);
+    BOOST_TEST(drained);
+    BOOST_TEST(op1.cancel_done.load());
+    BOOST_TEST_EQ(op1.num_done.load(), 0);
+    BOOST_TEST_EQ(conn.mpx.pending_count(), 1u);
+}
+
+// A request cancelled while in flight has its response discarded,
+// and the following request gets its own response
+void test_cancel_in_flight()
+{
+    // Arrange
+    fake_connection conn;
+    conn.open();
+    test_op op1, op2;
+    conn.remote.submit(op1);
+    conn.remote.submit(op2);
+    conn.drain();
+    conn.mpx.prepare_write();
+
+    // Act
+    conn.remote.cancel(op1, conn.mpx, no_limit, nullptr);
+    conn.complete_one();  // discarded
+    conn.complete_one();
+
+    // Assert
+    BOOST_TEST(op1.cancel_done.load());
+    BOOST_TEST_EQ(op1.num_done.load(), 0);
+    BOOST_TEST_EQ(op2.num_done.load(), 1);
+    BOOST_TEST_EQ(op2.result_ec, std::error_code());
+    BOOST_TEST_EQ(conn.mpx.in_flight_count(), 0u);
+}
+
+// A request that completed before the cancellation reached the connection is left alone.
+// The cancellation is acknowledged anyway
+void test_cancel_after_done()
+{
+    // Arrange
+    fake_connection conn;
+    conn.open();
+    test_op op1, op2;
+    conn.remote.submit(op1);
+    conn.remote.submit(op2);
+    conn.step();
+    BOOST_TEST(op1.done_posted);
+
+    // Act
+    conn.remote.cancel(op1, conn.mpx, no_limit, nullptr);
+
+    // Assert
+    BOOST_TEST(op1.cancel_done.load());
+    BOOST_TEST_EQ(op1.num_done.load(), 1);
+    BOOST_TEST_EQ(conn.mpx.in_flight_count(), 1u);  // op2 is unaffected
+    conn.complete_one();
+    BOOST_TEST_EQ(op2.num_done.load(), 1);
+}
+
+// Callers in many threads execute and cancel requests while the connection runs in another one.
+// Some of them submit before the connection starts. Every request completes exactly once,
+// or is cancelled without completing
+void test_exec_cancel_threads()
+{
+    // Arrange
+    constexpr int num_callers = 4, ops_per_caller = 200;
+    fake_connection conn;
+    std::atomic<int> num_finished{0};
+    std::vector<std::vector<std::error_code>> results(num_callers);
+    std::vector<std::vector<std::unique_ptr<test_op>>> ops(num_callers);
+    for (auto& v : ops)
+    {
+        for (int i = 0; i < ops_per_caller; ++i)
+            v.push_back(std::make_unique<test_op>());
+    }
+
+    // Act
+    std::vector<std::thread> callers;
+    for (int c = 0; c < num_callers; ++c)
+    {
+        callers.emplace_back([&, c] {
+            for (int i = 0; i < ops_per_caller; ++i)
+                results[c].push_back(remote_exec(conn, *ops[c][static_cast<std::size_t>(i)], i % 2 == 0));
+            ++num_finished;
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));  // let some requests be parked
+    conn.open();
+    while (num_finished.load() < num_callers || conn.mpx.in_flight_count())
+        conn.step();
+    for (auto& t : callers)
+        t.join();
+
+    // Assert
+    for (int c = 0; c < num_callers; ++c)
+    {
+        for (int i = 0; i < ops_per_caller; ++i)
+        {
+            const auto& op = *ops[c][static_cast<std::size_t>(i)];
+            const auto ec = results[c][static_cast<std::size_t>(i)];
+            if (i % 2 == 0)
+                BOOST_TEST(ec == (op.num_done.load() ? std::error_code() : cancelled_ec));
+            else
+                BOOST_TEST_EQ(ec, std::error_code());
+            BOOST_TEST_LE(op.num_done.load(), 1);
+        }
+    }
+    BOOST_TEST(!conn.mpx.has_pending());
+}
+
+}  // namespace
+
+int main()
+{
+    test_submit_wake_up();
+    test_complete();
+    test_invalid_request();
+    test_queue_full();
+    test_cancel_before_open();
+    test_cancel_queued();
+    test_cancel_in_flight();
+    test_cancel_after_done();
+    test_exec_cancel_threads();
+
+    return boost::report_errors();
+}
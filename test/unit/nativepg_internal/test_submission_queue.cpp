@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "nativepg_internal/multiplexed_connection/submission_queue.hpp"
+
+using namespace nativepg;
+using detail::submission_inbox;
+using detail::submission_node;
+using detail::submission_queue;
+
+namespace {
+
+struct node : submission_node
+{
+    int value;
+    int producer{};
+    explicit node(int v) : value(v) {}
+};
+
+std::vector<int> to_values(submission_node* n)
+{
+    std::vector<int> res;
+    for (; n != nullptr; n = n->next_submission)
+        res.push_back(static_cast<node*>(n)->value);
+    return res;
+}
+
+std::vector<int> take_values(submission_queue& q)
+{
+    std::vector<int> res;
+    for (auto* n = q.take_all(); n != nullptr; n = n->next_submission)
+        res.push_back(static_cast<node*>(n)->value);
+    return res;
+}
+
+// Nodes are taken in submission order
+void test_fifo()
+{
+    // Arrange
+    submission_queue q;
+    node n1{1}, n2{2}, n3{3};
+
+    // Act
+    q.push(n1);
+    q.push(n2);
+    q.push(n3);
+    auto values = take_values(q);
+
+    // Assert
+    const std::vector<int> expected{1, 2, 3};
+    BOOST_TEST_ALL_EQ(values.begin(), values.end(), expected.begin(), expected.end());
+}
+
+// Only the push that finds the queue empty asks to wake up the consumer
+void test_push_was_empty()
+{
+    // Arrange
+    submission_queue q;
+    node n1{1}, n2{2}, n3{3};
+
+    // Act
+    bool res1 = q.push(n1);
+    bool res2 = q.push(n2);
+    auto values = take_values(q);
+    bool res3 = q.push(n3);
+
+    // Assert
+    BOOST_TEST(res1);
+    BOOST_TEST(!res2);
+    BOOST_TEST_EQ(values.size(), 2u);
+    BOOST_TEST(res3);
+}
+
+// Taking from an empty queue is harmless
+void test_take_empty()
+{
+    // Arrange
+    submission_queue q;
+    node n1{1};
+
+    // Act
+    auto* res1 = q.take_all();
+    q.push(n1);
+    auto values = take_values(q);
+    auto* res2 = q.take_all();
+
+    // Assert
+    BOOST_TEST(res1 == nullptr);
+    BOOST_TEST_EQ(values.size(), 1u);
+    BOOST_TEST(res2 == nullptr);
+}
+
+
+// Many producers pushing concurrently, some before the consumer starts.
+// Every node is taken exactly once, and the nodes of each producer are taken in order
+void test_inbox_multiple_producers()
+{
+    // Arrange
+    constexpr int num_producers = 8, nodes_per_producer = 10000;
+    submission_inbox inbox;
+    std::vector<std::unique_ptr<node>> nodes;
+    for (int p = 0; p < num_producers; ++p)
+    {
+        for (int i = 0; i < nodes_per_producer; ++i)
+        {
+            nodes.push_back(std::make_unique<node>(i));
+            nodes.back()->producer = p;
+        }
+    }
+    std::atomic<bool> go{false};
+
+    // Act
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p)
+    {
+        producers.emplace_back([&, p] {
+            while (!go.load())
+                std::this_thread::yield();
+            for (int i = 0; i < nodes_per_producer; ++i)
+                inbox.push(*nodes[static_cast<std::size_t>(p * nodes_per_producer + i)]);
+        });
+    }
+    go.store(true);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));  // let some nodes be parked
+    std::vector<int> next_value(num_producers, 0);
+    int num_taken = 0;
+    auto consume = [&](submission_node* n) {
+        for (; n != nullptr; n = n->next_submission)
+        {
+            auto& nd = static_cast<node&>(*n);
+            BOOST_TEST_EQ(nd.value, next_value[static_cast<std::size_t>(nd.producer)]++);
+            ++num_taken;
+        }
+    };
+    consume(inbox.open());
+    while (num_taken < num_producers * nodes_per_producer)
+        consume(inbox.take_all());
+    for (auto& t : producers)
+        t.join();
+
+    // Assert
+    for (int value : next_value)
+        BOOST_TEST_EQ(value, nodes_per_producer);
+    BOOST_TEST(inbox.take_all() == nullptr);
+}
+
+// Before opening, nodes are parked and handed to the consumer by open(), in order
+void test_inbox_parked()
+{
+    // Arrange
+    submission_inbox inbox;
+    node n1{1}, n2{2}, n3{3};
+
+    // Act
+    auto res1 = inbox.push(n1);
+    auto res2 = inbox.push(n2);
+    auto values = to_values(inbox.open());
+    auto res3 = inbox.push(n3);
+
+    // Assert
+    BOOST_TEST(res1 == submission_inbox::push_result::parked);
+    BOOST_TEST(res2 == submission_inbox::push_result::parked);
+    const std::vector<int> expected{1, 2};
+    BOOST_TEST_ALL_EQ(values.begin(), values.end(), expected.begin(), expected.end());
+    BOOST_TEST(res3 == submission_inbox::push_result::queued_first);
+    BOOST_TEST_EQ(to_values(inbox.take_all()).size(), 1u);
+}
+
+// Parked nodes can be withdrawn from any position
+void test_inbox_withdraw()
+{
+    // Arrange
+    submission_inbox inbox;
+    node n1{1}, n2{2}, n3{3}, n4{4};
+    inbox.push(n1);
+    inbox.push(n2);
+    inbox.push(n3);
+    inbox.push(n4);
+
+    // Act
+    bool res1 = inbox.withdraw(n2);  // middle
+    bool res2 = inbox.withdraw(n4);  // last
+    bool res3 = inbox.withdraw(n1);  // first
+    inbox.push(n4);                  // the tail was updated correctly
+    auto values = to_values(inbox.open());
+
+    // Assert
+    BOOST_TEST(res1);
+    BOOST_TEST(res2);
+    BOOST_TEST(res3);
+    const std::vector<int> expected{3, 4};
+    BOOST_TEST_ALL_EQ(values.begin(), values.end(), expected.begin(), expected.end());
+}
+
+// Once the consumer has the nodes, they can't be withdrawn
+void test_inbox_withdraw_after_open()
+{
+    // Arrange
+    submission_inbox inbox;
+    node n1{1}, n2{2};
+    inbox.push(n1);
+    auto* parked = inbox.open();
+    inbox.push(n2);
+
+    // Act
+    bool res1 = inbox.withdraw(n1);
+    bool res2 = inbox.withdraw(n2);
+
+    // Assert
+    BOOST_TEST(!res1);
+    BOOST_TEST(!res2);
+    BOOST_TEST_EQ(to_values(parked).size(), 1u);
+    BOOST_TEST_EQ(to_values(inbox.take_all()).size(), 1u);
+}
+
+}  // namespace
+
+int main()
+{
+    test_fifo();
+    test_push_was_empty();
+    test_take_empty();
+    test_inbox_multiple_producers();
+    test_inbox_parked();
+    test_inbox_withdraw();
+    test_inbox_withdraw_after_open();
+
+    return boost::report_errors();
+}
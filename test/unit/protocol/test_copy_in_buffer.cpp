@@ -0,0 +1,123 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "nativepg/protocol/detail/copy_in_buffer.hpp"
+#include "test_utils/test_range_eq.hpp"
+
+using namespace nativepg;
+using namespace nativepg::test;
+using protocol::detail::copy_in_buffer;
+
+namespace {
+
+std::span<const unsigned char> to_span(std::string_view s)
+{
+    return {reinterpret_cast<const unsigned char*>(s.data()), s.size()};
+}
+
+void test_header()
+{
+    constexpr unsigned char expected[] = {'d', 0, 0, 0, 7};
+    test_range_eq(protocol::detail::copy_data_header(3u), expected);
+}
+
+void test_coalesce()
+{
+    // Arrange
+    copy_in_buffer buff{8u};
+    BOOST_TEST(buff.empty());
+
+    // Small chunks are appended until the flush size is reached
+    BOOST_TEST(!buff.is_big(3u));
+    BOOST_TEST(!buff.append(to_span("abc")));
+    BOOST_TEST(!buff.empty());
+    BOOST_TEST(buff.append(to_span("defgh")));
+
+    // The pending data is sent as a single message
+    constexpr unsigned char expected[] = {'d', 0, 0, 0, 12, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h'};
+    test_range_eq(buff.flush(), expected);
+
+    // Clearing leaves the buffer ready for more data
+    buff.clear();
+    BOOST_TEST(buff.empty());
+    BOOST_TEST(buff.is_big(8u));
+}
+
+void test_finish()
+{
+    // Arrange
+    copy_in_buffer buff;
+    buff.append(to_span("ab"));
+
+    // Pending data is sent before the CopyDone
+    constexpr unsigned char expected[] = {'d', 0, 0, 0, 6, 'a', 'b', 'c', 0, 0, 0, 4};
+    test_range_eq(buff.finish(), expected);
+}
+
+void test_finish_empty()
+{
+    copy_in_buffer buff;
+    constexpr unsigned char expected[] = {'c', 0, 0, 0, 4};
+    test_range_eq(buff.finish(), expected);
+}
+
+void test_fail()
+{
+    // Arrange
+    copy_in_buffer buff;
+    buff.append(to_span("ab"));
+
+    // Pending data is discarded. The reason is cut at the first NULL
+    using namespace std::string_view_literals;
+    constexpr unsigned char expected[] = {'f', 0, 0, 0, 8, 'b', 'a', 'd', 0};
+    test_range_eq(buff.fail("bad\0other"sv), expected);
+}
+
+void test_flush_size_limits()
+{
+    copy_in_buffer buff{0u};
+    BOOST_TEST_EQ(buff.flush_size(), 1u);
+    buff.set_flush_size(static_cast<std::size_t>(-1));
+    BOOST_TEST_EQ(buff.flush_size(), copy_in_buffer::max_flush_size);
+    copy_in_buffer buff2{static_cast<std::size_t>(-1)};
+    BOOST_TEST_EQ(buff2.flush_size(), copy_in_buffer::max_flush_size);
+}
+
+// With the biggest flush size, the biggest chunk that is appended to the biggest
+// pending message doesn't exceed the CopyData limit
+void test_flush_size_max_message()
+{
+    const std::size_t max_pending = copy_in_buffer::max_flush_size - 1u;
+    const std::size_t max_appended = copy_in_buffer::max_flush_size - 1u;
+    BOOST_TEST_LE(max_pending + max_appended, protocol::detail::copy_data_max_size);
+
+    // A chunk as big as the flush size is sent directly
+    copy_in_buffer buff{copy_in_buffer::max_flush_size};
+    BOOST_TEST(buff.is_big(copy_in_buffer::max_flush_size));
+    BOOST_TEST(!buff.is_big(max_appended));
+}
+
+}  // namespace
+
+int main()
+{
+    test_header();
+    test_coalesce();
+    test_finish();
+    test_finish_empty();
+    test_fail();
+    test_flush_size_limits();
+    test_flush_size_max_message();
+
+    return boost::report_errors();
+}
@@ -16,11 +16,13 @@
 #include <ostream>
 #include <vector>
 
+#include "nativepg/client_errc.hpp"
 #include "nativepg/extended_error.hpp"
 #include "nativepg/protocol/async.hpp"
 #include "nativepg/protocol/bind.hpp"
 #include "nativepg/protocol/close.hpp"
 #include "nativepg/protocol/command_complete.hpp"
+#include "nativepg/protocol/copy.hpp"
 #include "nativepg/protocol/data_row.hpp"
 #include "nativepg/protocol/describe.hpp"
 #include "nativepg/protocol/empty_query_response.hpp"
@@ -239,6 +241,120 @@ void test_simple_query_error_skipping()
     });
 }
 
+// COPY FROM STDIN. The data is sent by the upper layers, and the handler
+// sees an empty resultset
+void test_simple_query_copy_in()
+{
+    fixture fix;
+    fix.req.add_simple_query("COPY t FROM STDIN");
+    read_response_fsm fsm{&fix.req, &fix.handler, true};
+
+    // Run the FSM
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_in_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::command_complete{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::ready_for_query{}), error_code());
+
+    // Check handler messages
+    fix.check({
+        {response_msg_type::row_description,  0u},
+        {response_msg_type::command_complete, 0u},
+    });
+}
+
+// The server rejected the data, or we sent CopyFail
+void test_simple_query_copy_in_error()
+{
+    fixture fix;
+    fix.req.add_simple_query("COPY t FROM STDIN").add_simple_query("SELECT 1");
+    read_response_fsm fsm{&fix.req, &fix.handler, true};
+
+    // Run the FSM
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_in_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::error_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::ready_for_query{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::command_complete{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::ready_for_query{}), error_code());
+
+    // Check handler messages
+    fix.check({
+        {response_msg_type::row_description,  0u},
+        {response_msg_type::error_response,   0u},
+        {response_msg_type::row_description,  1u},
+        {response_msg_type::command_complete, 1u},
+    });
+}
+
+// Only data is allowed after CopyInResponse
+void test_simple_query_copy_in_unexpected_message()
+{
+    fixture fix;
+    fix.req.add_simple_query("COPY t FROM STDIN");
+    read_response_fsm fsm{&fix.req, &fix.handler, true};
+
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_in_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::data_row{}), error_code(client_errc::unexpected_message));
+}
+
+// COPY requires an API that supports it
+void test_simple_query_copy_in_not_allowed()
+{
+    fixture fix;
+    fix.req.add_simple_query("COPY t FROM STDIN");
+
+    BOOST_TEST_EQ(fix.fsm.resume(protocol::copy_in_response{}), error_code(client_errc::copy_not_allowed));
+}
+
+// CopyBoth (replication). The data is handled by the upper layers, and the handler
+// sees an empty resultset
+void test_simple_query_copy_both()
+{
+    fixture fix;
+    fix.req.add_simple_query("START_REPLICATION SLOT s LOGICAL 0/0");
+    read_response_fsm fsm{&fix.req, &fix.handler, true};
+
+    // Run the FSM
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_both_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_data{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_data{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_done{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::command_complete{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::ready_for_query{}), error_code());
+
+    // Check handler messages
+    fix.check({
+        {response_msg_type::row_description,  0u},
+        {response_msg_type::command_complete, 0u},
+    });
+}
+
+// The server may terminate replication with an error
+void test_simple_query_copy_both_error()
+{
+    fixture fix;
+    fix.req.add_simple_query("START_REPLICATION SLOT s LOGICAL 0/0");
+    read_response_fsm fsm{&fix.req, &fix.handler, true};
+
+    // Run the FSM
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_both_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_data{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::error_response{}), result_type::read);
+    BOOST_TEST_EQ(fsm.resume(protocol::ready_for_query{}), error_code());
+
+    // Check handler messages
+    fix.check({
+        {response_msg_type::row_description, 0u},
+        {response_msg_type::error_response,  0u},
+    });
+}
+
+void test_simple_query_copy_both_not_allowed()
+{
+    fixture fix;
+    fix.req.add_simple_query("START_REPLICATION SLOT s LOGICAL 0/0");
+
+    BOOST_TEST_EQ(fix.fsm.resume(protocol::copy_both_response{}), error_code(client_errc::copy_not_allowed));
+}
+
 // TODO: test more combinations here
 
 // --- Responses to parse ---
@@ -329,6 +445,16 @@ void test_execute()
     });
 }
 
+// COPY FROM STDIN is not supported with the extended protocol
+void test_execute_copy_in()
+{
+    fixture fix;
+    fix.req.add(protocol::execute{}).add(protocol::sync{});
+    read_response_fsm fsm{&fix.req, &fix.handler, true};
+
+    BOOST_TEST_EQ(fsm.resume(protocol::copy_in_response{}), error_code(client_errc::copy_not_allowed));
+}
+
 // Execute might return no rows
 void test_execute_no_rows()
 {
@@ -601,6 +727,13 @@ int main()
     test_simple_query_empty();
     test_simple_query_error();
     test_simple_query_error_skipping();
+    test_simple_query_copy_in();
+    test_simple_query_copy_in_error();
+    test_simple_query_copy_in_unexpected_message();
+    test_simple_query_copy_in_not_allowed();
+    test_simple_query_copy_both();
+    test_simple_query_copy_both_error();
+    test_simple_query_copy_both_not_allowed();
 
     test_parse();
     test_parse_error();
@@ -613,6 +746,7 @@ int main()
     test_execute_empty();
     test_execute_portal_suspended();
     test_execute_error();
+    test_execute_copy_in();
 
     test_describe_portal();
     test_describe_portal_no_data();
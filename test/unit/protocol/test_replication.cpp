@@ -0,0 +1,465 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/variant2/variant.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/protocol/pgoutput.hpp"
+#include "nativepg/protocol/replication.hpp"
+#include "nativepg/replication.hpp"
+#include "test_utils/test_range_eq.hpp"
+
+using namespace nativepg;
+using namespace nativepg::test;
+using namespace std::chrono_literals;
+using boost::variant2::get_if;
+using std::error_code;
+namespace pgoutput = protocol::pgoutput;
+
+namespace {
+
+std::span<const unsigned char> to_span(std::string_view s)
+{
+    return {reinterpret_cast<const unsigned char*>(s.data()), s.size()};
+}
+
+std::string_view to_string(std::span<const unsigned char> s)
+{
+    return {reinterpret_cast<const char*>(s.data()), s.size()};
+}
+
+// --- Replication messages
+
+void test_xlog_data()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {
+        'w', 0, 0, 0, 1, 0, 0, 0, 0x10, 0, 0, 0, 1, 0, 0, 0, 0x20, 0, 0, 0, 0, 0, 0, 0, 42, 'a', 'b',
+    };
+    protocol::replication_message res;
+
+    // Act
+    auto ec = protocol::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* xlog = get_if<protocol::xlog_data>(&res);
+    BOOST_TEST_NE(xlog, nullptr);
+    BOOST_TEST_EQ(xlog->wal_start, 0x100000010u);
+    BOOST_TEST_EQ(xlog->wal_end, 0x100000020u);
+    BOOST_TEST_EQ(xlog->send_time, 42);
+    BOOST_TEST_EQ(to_string(xlog->data), "ab");
+}
+
+void test_primary_keepalive()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {
+        'k', 0, 0, 0, 0, 0, 0, 0, 0x30, 0, 0, 0, 0, 0, 0, 0, 7, 1,
+    };
+    protocol::replication_message res;
+
+    // Act
+    auto ec = protocol::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* keepalive = get_if<protocol::primary_keepalive>(&res);
+    BOOST_TEST_NE(keepalive, nullptr);
+    BOOST_TEST_EQ(keepalive->wal_end, 0x30u);
+    BOOST_TEST_EQ(keepalive->send_time, 7);
+    BOOST_TEST(keepalive->reply_requested);
+}
+
+void test_replication_message_errors()
+{
+    protocol::replication_message res;
+
+    // Unknown type
+    constexpr unsigned char unknown[] = {'x', 0};
+    BOOST_TEST_EQ(protocol::parse(unknown, res), error_code(client_errc::protocol_value_error));
+
+    // Truncated messages
+    constexpr unsigned char xlog[] = {'w', 0, 0, 0};
+    BOOST_TEST_EQ(protocol::parse(xlog, res), error_code(client_errc::incomplete_message));
+    BOOST_TEST_EQ(protocol::parse({}, res), error_code(client_errc::incomplete_message));
+
+    // Extra bytes
+    constexpr unsigned char keepalive[] = {
+        'k', 0, 0, 0, 0, 0, 0, 0, 0x30, 0, 0, 0, 0, 0, 0, 0, 7, 1, 0,
+    };
+    BOOST_TEST_EQ(protocol::parse(keepalive, res), error_code(client_errc::extra_bytes));
+}
+
+void test_standby_status_update()
+{
+    // Arrange
+    protocol::standby_status_update msg{
+        .written = 0x100000003u,
+        .flushed = 2u,
+        .applied = 1u,
+        .send_time = 0x0102,
+        .reply_requested = true,
+    };
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto ec = protocol::serialize(msg, buff);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    constexpr unsigned char expected[] = {
+        'r', 0, 0, 0, 1, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 2, 0, 0, 0, 0,
+        0,   0, 0, 1, 0, 0, 0, 0, 0, 0, 1, 2, 1,
+    };
+    test_range_eq(buff, expected);
+}
+
+// --- pgoutput
+
+void test_begin()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {
+        'B', 0, 0, 0, 0, 0, 0, 0, 0x50, 0, 0, 0, 0, 0, 0, 0, 9, 0, 0, 2, 0,
+    };
+    pgoutput::message res;
+
+    // Act
+    auto ec = pgoutput::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* begin = get_if<pgoutput::begin_message>(&res);
+    BOOST_TEST_NE(begin, nullptr);
+    BOOST_TEST_EQ(begin->final_lsn, 0x50u);
+    BOOST_TEST_EQ(begin->commit_time, 9);
+    BOOST_TEST_EQ(begin->xid, 512);
+}
+
+void test_commit()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {
+        'C', 0, 0, 0, 0, 0, 0, 0, 0, 0x50, 0, 0, 0, 0, 0, 0, 0, 0x58, 0, 0, 0, 0, 0, 0, 0, 9,
+    };
+    pgoutput::message res;
+
+    // Act
+    auto ec = pgoutput::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* commit = get_if<pgoutput::commit_message>(&res);
+    BOOST_TEST_NE(commit, nullptr);
+    BOOST_TEST_EQ(commit->flags, 0u);
+    BOOST_TEST_EQ(commit->commit_lsn, 0x50u);
+    BOOST_TEST_EQ(commit->end_lsn, 0x58u);
+    BOOST_TEST_EQ(commit->commit_time, 9);
+}
+
+void test_relation()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {
+        'R', 0,   0,   0x40, 0,   'p', 'u', 'b', 'l', 'i', 'c', 0, 't', 0, 'd', 0, 2,  //
+        1,   'i', 'd', 0,    0,   0,   0,   23,  0xff, 0xff, 0xff, 0xff,               // id int4, key
+        0,   'v', 0,   0,    0,   0,   25,  0xff, 0xff, 0xff, 0xff,                    // v text
+    };
+    pgoutput::message res;
+
+    // Act
+    auto ec = pgoutput::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* rel = get_if<pgoutput::relation_message>(&res);
+    BOOST_TEST_NE(rel, nullptr);
+    BOOST_TEST_EQ(rel->oid, 0x4000);
+    BOOST_TEST_EQ(rel->nspname, "public");
+    BOOST_TEST_EQ(rel->name, "t");
+    BOOST_TEST_EQ(rel->replica_identity, 'd');
+    BOOST_TEST_EQ(rel->columns.size(), 2u);
+    auto it = rel->columns.begin();
+    auto col = *it++;
+    BOOST_TEST(col.is_key);
+    BOOST_TEST_EQ(col.name, "id");
+    BOOST_TEST_EQ(col.type_oid, 23);
+    BOOST_TEST_EQ(col.type_modifier, -1);
+    col = *it++;
+    BOOST_TEST(!col.is_key);
+    BOOST_TEST_EQ(col.name, "v");
+    BOOST_TEST_EQ(col.type_oid, 25);
+    BOOST_TEST(it == rel->columns.end());
+}
+
+void test_insert()
+{
+    // Arrange. Columns: text, NULL, binary
+    constexpr unsigned char msg[] = {
+        'I', 0, 0, 0x40, 0, 'N', 0, 3, 't', 0, 0, 0, 2, '4', '2', 'n', 'b', 0, 0, 0, 1, 0xab,
+    };
+    pgoutput::message res;
+
+    // Act
+    auto ec = pgoutput::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* ins = get_if<pgoutput::insert_message>(&res);
+    BOOST_TEST_NE(ins, nullptr);
+    BOOST_TEST_EQ(ins->relation_oid, 0x4000);
+    BOOST_TEST_EQ(ins->new_tuple.size(), 3u);
+    auto it = ins->new_tuple.begin();
+    auto col = *it++;
+    BOOST_TEST(col.kind == pgoutput::tuple_column_kind::text);
+    BOOST_TEST_EQ(to_string(col.value), "42");
+    col = *it++;
+    BOOST_TEST(col.kind == pgoutput::tuple_column_kind::null);
+    BOOST_TEST(col.value.empty());
+    col = *it++;
+    BOOST_TEST(col.kind == pgoutput::tuple_column_kind::binary);
+    BOOST_TEST_EQ(col.value.size(), 1u);
+    BOOST_TEST(it == ins->new_tuple.end());
+
+    // Values point into the message
+    BOOST_TEST_EQ((*ins->new_tuple.begin()).value.data(), msg + 13);
+}
+
+void test_update()
+{
+    // Without the old row
+    {
+        constexpr unsigned char msg[] = {'U', 0, 0, 0x40, 0, 'N', 0, 2, 'u', 't', 0, 0, 0, 1, 'x'};
+        pgoutput::message res;
+        BOOST_TEST_EQ(pgoutput::parse(msg, res), error_code());
+        const auto* upd = get_if<pgoutput::update_message>(&res);
+        BOOST_TEST_NE(upd, nullptr);
+        BOOST_TEST(upd->old_kind == pgoutput::old_tuple_kind::none);
+        BOOST_TEST(upd->old_tuple.empty());
+        BOOST_TEST_EQ(upd->new_tuple.size(), 2u);
+        BOOST_TEST((*upd->new_tuple.begin()).kind == pgoutput::tuple_column_kind::unchanged_toast);
+    }
+
+    // With the old key
+    {
+        constexpr unsigned char msg[] = {
+            'U', 0, 0, 0x40, 0, 'K', 0, 1, 't', 0, 0, 0, 1, '1', 'N', 0, 1, 't', 0, 0, 0, 1, '2',
+        };
+        pgoutput::message res;
+        BOOST_TEST_EQ(pgoutput::parse(msg, res), error_code());
+        const auto* upd = get_if<pgoutput::update_message>(&res);
+        BOOST_TEST_NE(upd, nullptr);
+        BOOST_TEST(upd->old_kind == pgoutput::old_tuple_kind::key);
+        BOOST_TEST_EQ(upd->old_tuple.size(), 1u);
+        BOOST_TEST_EQ(to_string((*upd->old_tuple.begin()).value), "1");
+        BOOST_TEST_EQ(upd->new_tuple.size(), 1u);
+        BOOST_TEST_EQ(to_string((*upd->new_tuple.begin()).value), "2");
+    }
+}
+
+void test_delete()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {'D', 0, 0, 0x40, 0, 'O', 0, 1, 't', 0, 0, 0, 1, '1'};
+    pgoutput::message res;
+
+    // Act
+    auto ec = pgoutput::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* del = get_if<pgoutput::delete_message>(&res);
+    BOOST_TEST_NE(del, nullptr);
+    BOOST_TEST_EQ(del->relation_oid, 0x4000);
+    BOOST_TEST(del->old_kind == pgoutput::old_tuple_kind::full);
+    BOOST_TEST_EQ(del->old_tuple.size(), 1u);
+}
+
+void test_truncate()
+{
+    // Arrange
+    constexpr unsigned char msg[] = {'T', 0, 0, 0, 2, 1, 0, 0, 0x40, 0, 0, 0, 0x40, 1};
+    pgoutput::message res;
+
+    // Act
+    auto ec = pgoutput::parse(msg, res);
+
+    // Assert
+    BOOST_TEST_EQ(ec, error_code());
+    const auto* trunc = get_if<pgoutput::truncate_message>(&res);
+    BOOST_TEST_NE(trunc, nullptr);
+    BOOST_TEST_EQ(trunc->options, 1u);
+    BOOST_TEST_EQ(trunc->relation_oids.size(), 2u);
+    BOOST_TEST_EQ(trunc->relation_oids[0], 0x4000);
+    BOOST_TEST_EQ(trunc->relation_oids[1], 0x4001);
+}
+
+void test_pgoutput_errors()
+{
+    pgoutput::message res;
+
+    // Streaming messages are not supported
+    constexpr unsigned char stream_start[] = {'S', 0, 0, 0, 1, 1};
+    BOOST_TEST_EQ(pgoutput::parse(stream_start, res), error_code(client_errc::protocol_value_error));
+
+    // Bad tuple column kinds
+    constexpr unsigned char bad_kind[] = {'I', 0, 0, 0x40, 0, 'N', 0, 1, 'z'};
+    BOOST_TEST_EQ(pgoutput::parse(bad_kind, res), error_code(client_errc::protocol_value_error));
+
+    // Inserts need a new tuple
+    constexpr unsigned char no_new[] = {'I', 0, 0, 0x40, 0, 'K', 0, 0};
+    BOOST_TEST_EQ(pgoutput::parse(no_new, res), error_code(client_errc::protocol_value_error));
+
+    // Deletes need an old tuple
+    constexpr unsigned char no_old[] = {'D', 0, 0, 0x40, 0, 'N', 0, 0};
+    BOOST_TEST_EQ(pgoutput::parse(no_old, res), error_code(client_errc::protocol_value_error));
+
+    // Truncated values
+    constexpr unsigned char truncated[] = {'I', 0, 0, 0x40, 0, 'N', 0, 1, 't', 0, 0, 0, 5, 'a'};
+    BOOST_TEST_EQ(pgoutput::parse(truncated, res), error_code(client_errc::incomplete_message));
+
+    // Truncated relation lists
+    constexpr unsigned char truncate_msg[] = {'T', 0x7f, 0xff, 0xff, 0xff, 0, 0, 0};
+    BOOST_TEST_EQ(pgoutput::parse(truncate_msg, res), error_code(client_errc::incomplete_message));
+}
+
+// --- LSNs
+
+void test_lsn()
+{
+    BOOST_TEST_EQ(format_lsn(0u), "0/0");
+    BOOST_TEST_EQ(format_lsn(0x16B374D848u), "16/B374D848");
+    BOOST_TEST(parse_lsn("16/B374D848") == 0x16B374D848u);
+    BOOST_TEST(parse_lsn("0/0") == 0u);
+    BOOST_TEST(parse_lsn("ffffffff/ffffffff") == 0xffffffffffffffffu);
+    BOOST_TEST(!parse_lsn(""));
+    BOOST_TEST(!parse_lsn("16"));
+    BOOST_TEST(!parse_lsn("/1"));
+    BOOST_TEST(!parse_lsn("1/"));
+    BOOST_TEST(!parse_lsn("1/2x"));
+    BOOST_TEST(!parse_lsn("100000000/0"));
+}
+
+void test_replication_time()
+{
+    // The Postgres epoch is 2000-01-01
+    std::chrono::system_clock::time_point tp{std::chrono::seconds(946684800)};
+    BOOST_TEST_EQ(to_replication_time(tp), 0);
+    BOOST_TEST_EQ(to_replication_time(tp + 1500ms), 1500000);
+}
+
+// --- Feedback
+
+constexpr std::chrono::steady_clock::time_point t0{std::chrono::hours(1)};
+constexpr std::chrono::system_clock::time_point wall{};
+
+protocol::xlog_data make_xlog(std::uint64_t start, std::string_view data)
+{
+    return {.wal_start = start, .wal_end = start, .send_time = 0, .data = to_span(data)};
+}
+
+void test_feedback_batching()
+{
+    // Arrange
+    replication_feedback fb{100u, 10s, 1000u};
+    fb.make_update(t0, wall);
+    BOOST_TEST(!fb.needs_update(t0));
+
+    // Confirming small amounts of data doesn't trigger updates
+    fb.on_message(protocol::replication_message(make_xlog(100u, "abcd")));
+    BOOST_TEST_EQ(fb.received_lsn(), 104u);
+    fb.confirm(104u);
+    fb.confirm(600u);
+    BOOST_TEST(!fb.needs_update(t0 + 1s));
+
+    // Crossing the byte threshold does
+    fb.confirm(1100u);
+    BOOST_TEST(fb.needs_update(t0 + 1s));
+    auto msg = fb.make_update(t0 + 1s, wall);
+    BOOST_TEST_EQ(msg.written, 1100u);
+    BOOST_TEST_EQ(msg.flushed, 1100u);
+    BOOST_TEST_EQ(msg.applied, 1100u);
+    BOOST_TEST(!msg.reply_requested);
+    BOOST_TEST_EQ(fb.reported_lsn(), 1100u);
+    BOOST_TEST(!fb.needs_update(t0 + 1s));
+
+    // Positions never go back
+    fb.confirm(50u);
+    BOOST_TEST_EQ(fb.confirmed_lsn(), 1100u);
+}
+
+void test_feedback_interval()
+{
+    // Arrange
+    replication_feedback fb{100u, 10s, 1000u};
+    fb.make_update(t0, wall);
+
+    // Updates are sent periodically, even if nothing changed
+    BOOST_TEST(!fb.needs_update(t0 + 9s));
+    BOOST_TEST(fb.needs_update(t0 + 10s));
+
+    // Received data is reported as written before being confirmed
+    fb.on_message(protocol::replication_message(make_xlog(200u, "ab")));
+    auto msg = fb.make_update(t0 + 10s, wall);
+    BOOST_TEST_EQ(msg.written, 202u);
+    BOOST_TEST_EQ(msg.flushed, 100u);
+    BOOST_TEST(!fb.needs_update(t0 + 11s));
+}
+
+void test_feedback_reply_requested()
+{
+    // Arrange
+    replication_feedback fb;
+    fb.make_update(t0, wall);
+
+    // Keepalives not requesting a reply are ignored
+    fb.on_message(protocol::primary_keepalive{.wal_end = 10u, .send_time = 0, .reply_requested = false});
+    BOOST_TEST(!fb.needs_update(t0));
+
+    // Otherwise, we reply immediately
+    fb.on_message(protocol::primary_keepalive{.wal_end = 10u, .send_time = 0, .reply_requested = true});
+    BOOST_TEST(fb.needs_update(t0));
+    fb.make_update(t0, wall);
+    BOOST_TEST(!fb.needs_update(t0));
+}
+
+}  // namespace
+
+int main()
+{
+    test_xlog_data();
+    test_primary_keepalive();
+    test_replication_message_errors();
+    test_standby_status_update();
+
+    test_begin();
+    test_commit();
+    test_relation();
+    test_insert();
+    test_update();
+    test_delete();
+    test_truncate();
+    test_pgoutput_errors();
+
+    test_lsn();
+    test_replication_time();
+
+    test_feedback_batching();
+    test_feedback_interval();
+    test_feedback_reply_requested();
+
+    return boost::report_errors();
+}
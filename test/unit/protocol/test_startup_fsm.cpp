@@ -92,6 +92,31 @@ void test_success()
     BOOST_TEST_EQ(res.ec, error_code());
 }
 
+// The replication parameter is sent when set
+void test_replication()
+{
+    connect_params params{.username = "postgres", .database = "db", .replication = "database"};
+    protocol::connection_state st;
+    startup_fsm_impl fsm{params};
+    diagnostics diag;
+
+    // Initiate. The FSM asks us to write the initial message
+    auto res = fsm.resume(st, diag);
+    BOOST_TEST_EQ(res.type, startup_fsm_impl::result_type::write);
+    const unsigned char expected_msg[] = {
+        0x00, 0x00, 0x00, 0x38, 0x00, 0x03, 0x00, 0x00, 'u', 's', 'e', 'r', 0x00, 'p', 'o', 's', 't',
+        'g',  'r',  'e',  's',  0x00, 'd',  'a',  't',  'a', 'b', 'a', 's', 'e', 0x00, 'd', 'b', 0x00,
+        'r',  'e',  'p',  'l',  'i',  'c',  'a',  't',  'i', 'o', 'n', 0x00, 'd', 'a', 't', 'a', 'b',
+        'a',  's',  'e',  0x00, 0x00,
+    };
+    BOOST_TEST_ALL_EQ(
+        st.write_buffer.begin(),
+        st.write_buffer.end(),
+        std::begin(expected_msg),
+        std::end(expected_msg)
+    );
+}
+
 void test_auth_error()
 {
     connect_params params{.username = "postgres", .password = "", .database = "postgres"};
@@ -129,6 +154,7 @@ void test_auth_error()
 int main()
 {
     test_success();
+    test_replication();
     test_auth_error();
 
     return boost::report_errors();
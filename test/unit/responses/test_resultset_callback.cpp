@@ -570,6 +570,40 @@ void test_callback_info()
     BOOST_TEST_EQ(info, expected_info);
 }
 
+// The row initializer runs on each row before its fields are parsed
+void test_row_init()
+{
+    // Test setup
+    std::vector<user> users;
+    std::size_t num_inits = 0u;
+    auto cb = into(users, [&num_inits](user& u) {
+        BOOST_TEST(u.name.empty());  // value-initialized
+        ++num_inits;
+    });
+    owning_row_description descrs({
+        make_field_descr("id", 23, format_code::text),
+        make_field_descr("name", 25, format_code::text),
+    });
+    request req;
+    req.add_simple_query("SELECT 1");
+    BOOST_TEST_EQ(cb.setup(req, 0u), handler_setup_result(1u));
+
+    // Messages
+    cb.on_message(descrs, 0u);
+    cb.on_message(owning_data_row({"42", "perico"}), 0u);
+    cb.on_message(owning_data_row({"50", "pepe"}), 0u);
+    cb.on_message(protocol::command_complete{}, 0u);
+
+    // Check result
+    BOOST_TEST_EQ(cb.result(), extended_error{});
+    BOOST_TEST_EQ(num_inits, 2u);
+    std::vector<user> expected_rows{
+        {42, "perico"},
+        {50, "pepe"  },
+    };
+    BOOST_TEST_ALL_EQ(users.begin(), users.end(), expected_rows.begin(), expected_rows.end());
+}
+
 // If a field is not present, that's an error.
 // Since it's a user error, other messages for this resultset are accepted.
 void test_error_field_not_present()
@@ -634,6 +668,7 @@ int main()
     test_type_conversions();
     test_callback();
     test_callback_info();
+    test_row_init();
 
     test_error_field_not_present();
     test_error_incompatible_field_type();
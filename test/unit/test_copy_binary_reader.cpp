@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/describe/class.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/copy_binary_reader.hpp"
+#include "nativepg/copy_binary_writer.hpp"
+#include "nativepg/field_traits.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+struct employee
+{
+    std::int32_t id;
+    std::string name;
+    std::optional<std::int16_t> age;
+};
+BOOST_DESCRIBE_STRUCT(employee, (), (id, name, age))
+
+bool operator==(const employee& lhs, const employee& rhs)
+{
+    return lhs.id == rhs.id && lhs.name == rhs.name && lhs.age == rhs.age;
+}
+
+struct wide_row
+{
+    std::int64_t id;
+};
+BOOST_DESCRIBE_STRUCT(wide_row, (), (id))
+
+const std::vector<employee> sample_rows{
+    {1,   "John",                30          },
+    {2,   "",                    std::nullopt},
+    {300, std::string(100, 'a'), 45          },
+};
+
+// A full COPY stream, as the server would send it
+std::vector<unsigned char> sample_stream()
+{
+    copy_binary_writer<employee> writer;
+    for (const auto& row : sample_rows)
+        writer.write(row);
+    writer.finish();
+    return {writer.data().begin(), writer.data().end()};
+}
+
+// Feeds the stream in chunks of the given size, so that rows are split
+void test_split_chunks()
+{
+    const auto stream = sample_stream();
+
+    for (std::size_t chunk_size : {1u, 2u, 3u, 7u, 19u, 20u, 64u, 4096u})
+    {
+        // Arrange
+        copy_binary_reader<employee> reader;
+        std::vector<employee> rows;
+        std::span<const unsigned char> remaining(stream);
+
+        // Act
+        while (!remaining.empty())
+        {
+            auto chunk = remaining.first((std::min)(chunk_size, remaining.size()));
+            auto ec = reader.feed(chunk, [&rows](employee&& row) { rows.push_back(std::move(row)); });
+            BOOST_TEST_EQ(ec, std::error_code());
+            remaining = remaining.subspan(chunk.size());
+        }
+
+        // Assert
+        BOOST_TEST(reader.done());
+        BOOST_TEST(rows == sample_rows);
+    }
+}
+
+// A sequence of buffers, like the ones exec_some returns
+struct buffer
+{
+    const void* ptr;
+    std::size_t len;
+    const void* data() const { return ptr; }
+    std::size_t size() const { return len; }
+};
+
+void test_buffer_sequence()
+{
+    // Arrange
+    const auto stream = sample_stream();
+    const std::vector<buffer> buffers{
+        {stream.data(),       25u                },
+        {stream.data() + 25u, stream.size() - 25u},
+    };
+    copy_binary_reader<employee> reader;
+    std::vector<employee> rows;
+
+    // Act
+    auto ec = reader.feed(buffers, [&rows](employee&& row) { rows.push_back(std::move(row)); });
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    BOOST_TEST(reader.done());
+    BOOST_TEST(rows == sample_rows);
+}
+
+void test_column_oids()
+{
+    // Arrange. An int4 column parsed into an int64 member
+    copy_binary_writer<wide_row> writer;
+    std::vector<unsigned char> stream(writer.data().begin(), writer.data().end());
+    constexpr unsigned char row[] = {0, 1, 0, 0, 0, 4, 0, 0, 1, 0, 0xff, 0xff};
+    stream.insert(stream.end(), std::begin(row), std::end(row));
+
+    const std::int32_t oids[] = {detail::int4_oid};
+    copy_binary_reader<wide_row> reader{oids};
+    std::vector<wide_row> rows;
+
+    // Act
+    auto ec = reader.feed(stream, [&rows](wide_row&& r) { rows.push_back(r); });
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    BOOST_TEST_EQ(rows.size(), 1u);
+    BOOST_TEST_EQ(rows.at(0).id, 256);
+}
+
+void test_incompatible_column_oids()
+{
+    const auto stream = sample_stream();
+    const std::int32_t oids[] = {detail::int4_oid, detail::int4_oid, detail::int2_oid};
+    copy_binary_reader<employee> reader{oids};
+
+    auto ec = reader.feed(stream, [](employee&&) { BOOST_TEST(false); });
+
+    BOOST_TEST_EQ(ec, std::error_code(client_errc::incompatible_field_type));
+}
+
+void test_bad_signature()
+{
+    auto stream = sample_stream();
+    stream[0] = 'X';
+    copy_binary_reader<employee> reader;
+
+    auto ec = reader.feed(stream, [](employee&&) {});
+
+    BOOST_TEST_EQ(ec, std::error_code(client_errc::protocol_value_error));
+}
+
+void test_field_count_mismatch()
+{
+    // The stream contains rows with 3 fields
+    const auto stream = sample_stream();
+    copy_binary_reader<wide_row> reader;
+
+    auto ec = reader.feed(stream, [](wide_row&&) {});
+
+    BOOST_TEST_EQ(ec, std::error_code(client_errc::incompatible_field_type));
+}
+
+void test_data_after_trailer()
+{
+    auto stream = sample_stream();
+    stream.push_back(0);
+    copy_binary_reader<employee> reader;
+
+    auto ec = reader.feed(stream, [](employee&&) {});
+
+    BOOST_TEST_EQ(ec, std::error_code(client_errc::extra_bytes));
+}
+
+}  // namespace
+
+int main()
+{
+    test_split_chunks();
+    test_buffer_sequence();
+    test_column_oids();
+    test_incompatible_column_oids();
+    test_bad_signature();
+    test_field_count_mismatch();
+    test_data_after_trailer();
+
+    return boost::report_errors();
+}
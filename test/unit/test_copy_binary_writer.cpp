@@ -0,0 +1,109 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/describe/class.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/copy_binary_writer.hpp"
+#include "test_utils/test_range_eq.hpp"
+
+using namespace nativepg;
+using namespace nativepg::test;
+
+namespace {
+
+struct employee
+{
+    std::int32_t id;
+    std::string name;
+    std::optional<std::int16_t> age;
+};
+BOOST_DESCRIBE_STRUCT(employee, (), (id, name, age))
+
+struct small_row
+{
+    std::int16_t value;
+};
+BOOST_DESCRIBE_STRUCT(small_row, (), (value))
+
+constexpr unsigned char header[] = {
+    'P', 'G', 'C', 'O', 'P', 'Y', '\n', 0xff, '\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+
+void test_header_rows_trailer()
+{
+    // Arrange
+    copy_binary_writer<employee> writer;
+    test_range_eq(writer.data(), header);
+    writer.clear();
+
+    // Act
+    BOOST_TEST_EQ(writer.write({42, "ab", 30}), std::error_code());
+    BOOST_TEST_EQ(writer.write({1, "", std::nullopt}), std::error_code());
+    writer.finish();
+
+    // Assert
+    constexpr unsigned char expected[] = {
+        // Row 1: field count, then length-prefixed fields
+        0, 3, 0, 0, 0, 4, 0, 0, 0, 42, 0, 0, 0, 2, 'a', 'b', 0, 0, 0, 2, 0, 30,
+        // Row 2. Empty optionals are NULL
+        0, 3, 0, 0, 0, 4, 0, 0, 0, 1, 0, 0, 0, 0, 0xff, 0xff, 0xff, 0xff,
+        // Trailer
+        0xff, 0xff,
+    };
+    test_range_eq(writer.data(), expected);
+}
+
+void test_full()
+{
+    // Arrange. Each row takes 8 bytes
+    copy_binary_writer<small_row> writer{40u};
+    writer.clear();
+
+    // Act/assert
+    for (int i = 0; i < 4; ++i)
+    {
+        writer.write({static_cast<std::int16_t>(i)});
+        BOOST_TEST(!writer.full());
+    }
+    writer.write({4});
+    BOOST_TEST(writer.full());
+    BOOST_TEST_EQ(writer.data().size(), 40u);
+
+    // Clearing keeps memory
+    const auto* ptr = writer.data().data();
+    writer.clear();
+    BOOST_TEST(!writer.full());
+    writer.write({5});
+    BOOST_TEST_EQ(writer.data().data(), ptr);
+}
+
+void test_reset()
+{
+    copy_binary_writer<small_row> writer;
+    writer.write({1});
+    writer.reset();
+    test_range_eq(writer.data(), header);
+}
+
+}  // namespace
+
+int main()
+{
+    test_header_rows_trailer();
+    test_full();
+    test_reset();
+
+    return boost::report_errors();
+}
@@ -0,0 +1,173 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/describe/class.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/copy_text_reader.hpp"
+#include "nativepg/field_view.hpp"
+
+using namespace nativepg;
+
+namespace {
+
+// A NULL is represented as an empty optional
+using row_t = std::vector<std::optional<std::string>>;
+
+std::span<const unsigned char> to_span(std::string_view s)
+{
+    return {reinterpret_cast<const unsigned char*>(s.data()), s.size()};
+}
+
+// Collects rows as strings
+struct row_collector
+{
+    std::vector<row_t>* rows;
+
+    void operator()(std::span<const field_view> fields) const
+    {
+        row_t row;
+        for (auto f : fields)
+            row.push_back(f.is_null() ? std::nullopt : std::optional<std::string>(f.data_str()));
+        rows->push_back(std::move(row));
+    }
+};
+
+// Feeds the input in chunks of the given size
+std::vector<row_t> parse(std::string_view input, std::size_t chunk_size, char delimiter = '\t')
+{
+    copy_text_reader reader{delimiter};
+    std::vector<row_t> rows;
+    auto remaining = to_span(input);
+    while (!remaining.empty())
+    {
+        auto chunk = remaining.first((std::min)(chunk_size, remaining.size()));
+        BOOST_TEST_EQ(reader.feed(chunk, row_collector{&rows}), std::error_code());
+        remaining = remaining.subspan(chunk.size());
+    }
+    BOOST_TEST(!reader.has_partial_row());
+    return rows;
+}
+
+void test_rows()
+{
+    // Long fields exercise the vectorized paths
+    const std::string long_field(100, 'a');
+    const std::string input = "1\tabc\t\\N\n"
+                              "2\t\t" +
+                              long_field + "\n" + long_field + "\tx\\ty\\\\z\\nw\t\\101\\x41\\q\n";
+    const std::vector<row_t> expected{
+        {"1",        "abc",        std::nullopt},
+        {"2",        "",           long_field  },
+        {long_field, "x\ty\\z\nw", "AAq"       },
+    };
+
+    for (std::size_t chunk_size : {1u, 2u, 3u, 5u, 16u, 31u, 33u, 4096u})
+        BOOST_TEST(parse(input, chunk_size) == expected);
+}
+
+// An escaped newline doesn't end the row, even if the backslash ends a chunk
+void test_escaped_newline()
+{
+    const std::string_view input = "a\\\nb\tc\n";
+    const std::vector<row_t> expected{
+        {"a\nb", "c"},
+    };
+
+    for (std::size_t chunk_size : {1u, 2u, 3u, 100u})
+        BOOST_TEST(parse(input, chunk_size) == expected);
+}
+
+void test_custom_delimiter()
+{
+    const std::vector<row_t> expected{
+        {"a", "b\tc", std::nullopt},
+    };
+    BOOST_TEST(parse("a|b\tc|\\N\n", 4096u, '|') == expected);
+}
+
+void test_partial_row()
+{
+    copy_text_reader reader;
+    std::vector<row_t> rows;
+
+    BOOST_TEST_EQ(reader.feed(to_span("a\tb\nc\t"), row_collector{&rows}), std::error_code());
+
+    BOOST_TEST_EQ(rows.size(), 1u);
+    BOOST_TEST(reader.has_partial_row());
+}
+
+struct employee
+{
+    std::int32_t id;
+    std::string name;
+    std::optional<double> salary;
+};
+BOOST_DESCRIBE_STRUCT(employee, (), (id, name, salary))
+
+void test_typed_rows()
+{
+    // Arrange
+    copy_text_reader reader;
+    std::vector<employee> rows;
+
+    // Act
+    auto ec = reader.feed(
+        to_span("10\tJohn\t1500.5\n20\tJane\\tDoe\t\\N\n"),
+        copy_text_rows<employee>([&rows](employee&& e) { rows.push_back(std::move(e)); })
+    );
+
+    // Assert
+    BOOST_TEST_EQ(ec, std::error_code());
+    BOOST_TEST_EQ(rows.size(), 2u);
+    BOOST_TEST_EQ(rows.at(0).id, 10);
+    BOOST_TEST_EQ(rows.at(0).name, "John");
+    BOOST_TEST(rows.at(0).salary == 1500.5);
+    BOOST_TEST_EQ(rows.at(1).id, 20);
+    BOOST_TEST_EQ(rows.at(1).name, "Jane\tDoe");
+    BOOST_TEST(!rows.at(1).salary.has_value());
+}
+
+void test_typed_rows_error()
+{
+    copy_text_reader reader;
+    auto callback = copy_text_rows<employee>([](employee&&) { BOOST_TEST(false); });
+
+    // Wrong number of fields
+    BOOST_TEST_EQ(
+        reader.feed(to_span("10\tJohn\n"), callback),
+        std::error_code(client_errc::incompatible_field_type)
+    );
+
+    // Parse error
+    BOOST_TEST_NE(reader.feed(to_span("abc\tJohn\t1\n"), callback), std::error_code());
+}
+
+}  // namespace
+
+int main()
+{
+    test_rows();
+    test_escaped_newline();
+    test_custom_delimiter();
+    test_partial_row();
+    test_typed_rows();
+    test_typed_rows_error();
+
+    return boost::report_errors();
+}
@@ -8,11 +8,14 @@
 #include <boost/assert/source_location.hpp>
 #include <boost/core/lightweight_test.hpp>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <ostream>
 #include <source_location>
 #include <string_view>
+#include <vector>
 
 #include "nativepg/protocol/common.hpp"
 #include "nativepg/protocol/sync.hpp"
@@ -62,6 +65,16 @@ void check_messages(
     test_range_eq(req.messages(), expected, loc);
 }
 
+// Concatenates all the segments in the payload
+std::vector<unsigned char> full_payload(const request& req)
+{
+    std::vector<unsigned char> res;
+    req.for_each_payload_segment([&res](std::span<const unsigned char> seg) {
+        res.insert(res.end(), seg.begin(), seg.end());
+    });
+    return res;
+}
+
 // Simple query
 void test_simple_query()
 {
@@ -507,6 +520,77 @@ void test_execute_batch()
     );
 }
 
+// Borrowed parameters are not copied into the request buffer
+void test_query_borrowed()
+{
+    // Setup
+    const std::array<std::byte, 3> blob{std::byte{0x01}, std::byte{0x02}, std::byte{0x03}};
+    std::string_view text = "value";
+    request req, reference_req;
+
+    // Serialize
+    req.add_query("SELECT $1, $2", {borrow_bytea(blob), borrow_text(text)});
+    reference_req.add_query("SELECT $1, $2", {std::span<const std::byte>(blob), text});
+
+    // The chunks point to the caller's memory
+    BOOST_TEST(req.has_borrowed_data());
+    BOOST_TEST_EQ(req.borrowed_chunks().size(), 2u);
+    BOOST_TEST(req.borrowed_chunks()[0].data.data() == reinterpret_cast<const unsigned char*>(blob.data()));
+    BOOST_TEST(req.borrowed_chunks()[1].data.data() == reinterpret_cast<const unsigned char*>(text.data()));
+
+    // Concatenating the segments yields the same payload as copying the parameters
+    BOOST_TEST(!reference_req.has_borrowed_data());
+    BOOST_TEST_EQ(req.payload().size(), reference_req.payload().size() - 8u);
+    BOOST_TEST_EQ(req.payload_size(), reference_req.payload().size());
+    test_range_eq(full_payload(req), reference_req.payload());
+    check_messages(
+        req,
+        {
+            request_message_type::parse,
+            request_message_type::bind,
+            request_message_type::describe,
+            request_message_type::execute,
+            request_message_type::sync,
+        }
+    );
+}
+
+// BYTEA requires hex-encoding in the text format, so it's copied.
+// TEXT can be borrowed in both formats
+void test_query_borrowed_text_format()
+{
+    // Setup
+    const std::array<std::byte, 2> blob{std::byte{0xab}, std::byte{0x01}};
+    std::string_view text = "abc";
+    request req, reference_req;
+
+    // Serialize
+    req.add_query("SELECT $1, $2", {borrow_bytea(blob), borrow_text(text)}, protocol::format_code::text);
+    reference_req
+        .add_query("SELECT $1, $2", {std::span<const std::byte>(blob), text}, protocol::format_code::text);
+
+    // Only the text parameter was borrowed
+    BOOST_TEST_EQ(req.borrowed_chunks().size(), 1u);
+    BOOST_TEST(req.borrowed_chunks()[0].data.data() == reinterpret_cast<const unsigned char*>(text.data()));
+    test_range_eq(full_payload(req), reference_req.payload());
+}
+
+// Requests without borrowed data have a single segment
+void test_payload_segments_no_borrowed()
+{
+    request req;
+    req.add_query("SELECT $1", {std::int32_t(42)});
+
+    BOOST_TEST(!req.has_borrowed_data());
+    BOOST_TEST_EQ(req.payload_size(), req.payload().size());
+    std::size_t num_segments = 0u;
+    req.for_each_payload_segment([&](std::span<const unsigned char> seg) {
+        ++num_segments;
+        BOOST_TEST(seg.data() == req.payload().data());
+    });
+    BOOST_TEST_EQ(num_segments, 1u);
+}
+
 }  // namespace
 
 int main()
@@ -535,5 +619,9 @@ int main()
     test_prepare_batch();
     test_execute_batch();
 
+    test_query_borrowed();
+    test_query_borrowed_text_format();
+    test_payload_segments_no_borrowed();
+
     return boost::report_errors();
 }
\ No newline at end of file
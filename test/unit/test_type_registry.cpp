@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/extended_error.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/field_view.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/response.hpp"
+#include "nativepg/responses/response_handler.hpp"
+#include "nativepg/type_registry.hpp"
+#include "nativepg_internal/check_request.hpp"
+#include "nativepg_internal/type_resolution.hpp"
+
+using namespace nativepg;
+using std::error_code;
+
+namespace {
+
+// A type without a fixed OID (e.g. an enum)
+struct mood
+{
+    std::string value;
+};
+
+}  // namespace
+
+namespace nativepg {
+
+template <>
+struct parse_field_traits<mood>
+{
+    static constexpr std::string_view type_name = "mood";
+
+    // Only used if the name couldn't be resolved
+    static std::error_code is_compatible(std::int32_t type_oid)
+    {
+        return type_oid == detail::text_oid ? std::error_code()
+                                            : std::error_code(client_errc::incompatible_field_type);
+    }
+
+    static std::error_code parse_text(field_view from, std::int32_t, mood& to)
+    {
+        to.value.assign(reinterpret_cast<const char*>(from.data().data()), from.data().size());
+        return {};
+    }
+
+    static std::error_code parse_binary(field_view from, std::int32_t type_oid, mood& to)
+    {
+        return parse_text(from, type_oid, to);
+    }
+};
+
+}  // namespace nativepg
+
+namespace {
+
+// A handler that records the registry it got
+struct registry_handler
+{
+    const type_registry* types{};
+    bool called{};
+    extended_error err;
+
+    void set_type_registry(const type_registry* value)
+    {
+        types = value;
+        called = true;
+    }
+    handler_setup_result setup(const request&, std::size_t offset) { return offset + 1u; }
+    void on_message(const any_request_message&, std::size_t) {}
+    const extended_error& result() const { return err; }
+};
+
+// Same, but not interested in the registry
+struct plain_handler
+{
+    extended_error err;
+
+    handler_setup_result setup(const request&, std::size_t offset) { return offset + 1u; }
+    void on_message(const any_request_message&, std::size_t) {}
+    const extended_error& result() const { return err; }
+};
+
+static_assert(type_registry_aware<registry_handler>);
+static_assert(!type_registry_aware<plain_handler>);
+
+void test_registry()
+{
+    // Arrange
+    type_registry types;
+
+    // Required names are pending until they are looked up
+    types.require("mood");
+    types.require("citext");
+    types.require("mood");
+    BOOST_TEST_EQ(types.pending().size(), 2u);
+    BOOST_TEST_EQ(types.oid("mood"), 0);
+
+    // Looking up a name stores its OIDs
+    types.add("mood", 16390, 16389);
+    BOOST_TEST_EQ(types.oid("mood"), 16390);
+    BOOST_TEST_EQ(types.array_oid("mood"), 16389);
+    BOOST_TEST_EQ(types.pending().size(), 1u);
+    BOOST_TEST_EQ(types.pending().at(0), "citext");
+
+    // Types that don't exist are not looked up again
+    types.add("citext", 0, 0);
+    BOOST_TEST(types.pending().empty());
+    BOOST_TEST_EQ(types.oid("citext"), 0);
+
+    // Unknown names
+    BOOST_TEST_EQ(types.oid("hstore"), 0);
+    BOOST_TEST_EQ(types.array_oid("hstore"), 0);
+
+    // Invalidating causes names to be looked up again
+    types.invalidate();
+    BOOST_TEST_EQ(types.pending().size(), 2u);
+    BOOST_TEST_EQ(types.oid("mood"), 0);
+}
+
+void test_field_is_compatible()
+{
+    // Arrange
+    type_registry types;
+    types.add("mood", 16390, 16389);
+    type_registry empty_types;
+    constexpr auto incompatible = client_errc::incompatible_field_type;
+
+    // Resolved names are matched by OID
+    BOOST_TEST_EQ(field_is_compatible<mood>(16390, &types), error_code());
+    BOOST_TEST_EQ(field_is_compatible<mood>(16389, &types), error_code(incompatible));
+    BOOST_TEST_EQ(field_is_compatible<mood>(detail::text_oid, &types), error_code(incompatible));
+
+    // Optionals forward the name
+    BOOST_TEST_EQ(field_is_compatible<std::optional<mood>>(16390, &types), error_code());
+    BOOST_TEST_EQ(field_is_compatible<std::optional<mood>>(16389, &types), error_code(incompatible));
+
+    // If the name is unknown, is_compatible is used
+    BOOST_TEST_EQ(field_is_compatible<mood>(detail::text_oid, &empty_types), error_code());
+    BOOST_TEST_EQ(field_is_compatible<mood>(16390, &empty_types), error_code(incompatible));
+    BOOST_TEST_EQ(field_is_compatible<mood>(detail::text_oid, nullptr), error_code());
+
+    // Types without a name ignore the registry
+    BOOST_TEST_EQ(field_is_compatible<std::int32_t>(detail::int4_oid, &types), error_code());
+    BOOST_TEST_EQ(field_is_compatible<std::int32_t>(16390, &types), error_code(incompatible));
+}
+
+void test_setup_request_forwards_registry()
+{
+    // Arrange
+    type_registry types;
+    request req;
+    req.add_query("SELECT 1", {});
+    registry_handler h1, h2;
+    response<registry_handler, plain_handler> res{registry_handler{}, plain_handler{}};
+
+    // Act
+    auto ec1 = protocol::detail::setup_request(req, response_handler_ref(&h1), &types);
+    auto ec2 = protocol::detail::setup_request(req, response_handler_ref(&h2));
+    response_handler_ref(&res).set_type_registry(&types);
+
+    // Assert. Setup fails because the handlers don't match the request,
+    // but the registry has already been handed in
+    BOOST_TEST_EQ(ec1, error_code(client_errc::incompatible_response_length));
+    BOOST_TEST_EQ(ec2, error_code(client_errc::incompatible_response_length));
+    BOOST_TEST(h1.called);
+    BOOST_TEST_EQ(h1.types, &types);
+    BOOST_TEST(h2.called);
+    BOOST_TEST_EQ(h2.types, nullptr);
+    BOOST_TEST_EQ(std::get<0>(res.handlers()).types, &types);
+}
+
+void test_resolution_request()
+{
+    // Arrange
+    type_registry types;
+    types.require("mood");
+    types.require("public.citext");
+    types.add("hstore", 16400, 16405);
+
+    // Act
+    detail::type_resolution resolution{types};
+    auto handler = resolution.handler();
+
+    // Assert. Only pending names are looked up
+    BOOST_TEST(!resolution.empty());
+    const auto& payload = resolution.get_request().payload();
+    std::string_view payload_str(reinterpret_cast<const char*>(payload.data()), payload.size());
+    BOOST_TEST_NE(payload_str.find("FROM (VALUES ($1::text), ($2::text))"), std::string_view::npos);
+    BOOST_TEST_NE(payload_str.find("public.citext"), std::string_view::npos);
+    BOOST_TEST_EQ(payload_str.find("hstore"), std::string_view::npos);
+    BOOST_TEST_EQ(
+        protocol::detail::setup_request(resolution.get_request(), response_handler_ref(&handler)),
+        error_code()
+    );
+
+    // Names that don't yield a row don't exist
+    types.add("mood", 16390, 16389);
+    resolution.on_success();
+    BOOST_TEST(types.pending().empty());
+    BOOST_TEST_EQ(types.oid("mood"), 16390);
+    BOOST_TEST_EQ(types.oid("public.citext"), 0);
+    BOOST_TEST_EQ(types.oid("hstore"), 16400);
+}
+
+void test_resolution_nothing_pending()
+{
+    // Arrange
+    type_registry types;
+    types.add("mood", 16390, 16389);
+
+    // Act
+    detail::type_resolution resolution{types};
+
+    // Assert
+    BOOST_TEST(resolution.empty());
+    BOOST_TEST(resolution.get_request().messages().empty());
+}
+
+}  // namespace
+
+int main()
+{
+    test_registry();
+    test_field_is_compatible();
+    test_setup_request_forwards_registry();
+    test_resolution_request();
+    test_resolution_nothing_pending();
+
+    return boost::report_errors();
+}
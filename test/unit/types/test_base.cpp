@@ -225,6 +225,60 @@ void test_parse_text_bytea_invalid_hex_error()
     BOOST_TEST_EQ(err, error_code(client_errc::protocol_value_error));
 }
 
+// Long values are decoded in blocks. Cover all sizes around the block boundaries,
+// with all byte values and uppercase digits
+void test_parse_text_bytea_long()
+{
+    for (std::size_t size : {15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 65u, 256u, 1000u})
+    {
+        // Arrange
+        std::vector<std::byte> expected;
+        std::string str = "\\x";
+        constexpr char digits[] = "0123456789ABCDEF";
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto byte = static_cast<unsigned char>(i * 7u);
+            expected.push_back(static_cast<std::byte>(byte));
+            str.push_back(digits[byte >> 4]);
+            str.push_back(digits[byte & 0x0f]);
+        }
+        std::span<const unsigned char> data(reinterpret_cast<const unsigned char*>(str.data()), str.size());
+        std::vector<std::byte> ba;
+
+        // Act
+        auto err = types::parse_text_bytea(field_view{data}, ba);
+
+        // Assert
+        BOOST_TEST_EQ(err, std::error_code());
+        BOOST_TEST(ba == expected);
+    }
+}
+
+// Invalid characters are detected in any position
+void test_parse_text_bytea_long_invalid_hex_error()
+{
+    for (std::size_t pos : {0u, 17u, 31u, 40u, 63u, 64u, 100u, 129u})
+    {
+        for (char c : {'g', 'G', '/', ':', '@', '`', '\x80', '\xff', '\0'})
+        {
+            // Arrange
+            std::string str = "\\x" + std::string(130u, 'a');
+            str[2u + pos] = c;
+            std::span<const unsigned char> data(
+                reinterpret_cast<const unsigned char*>(str.data()),
+                str.size()
+            );
+            std::vector<std::byte> ba;
+
+            // Act
+            auto err = types::parse_text_bytea(field_view{data}, ba);
+
+            // Assert
+            BOOST_TEST_EQ(err, error_code(client_errc::protocol_value_error));
+        }
+    }
+}
+
 // "CHAR" (internal single-byte char)
 void test_parse_text_char_success()
 {
@@ -851,6 +905,146 @@ void test_field_parse_text_optional_non_null_success()
     BOOST_TEST_EQ(*out_val, 42);
 }
 
+//
+// Serialization
+//
+template <class T>
+void test_serialize_text_success(const T& value, std::string_view expected)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_text(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(std::string_view(reinterpret_cast<const char*>(buff.data()), buff.size()), expected);
+}
+
+template <class T>
+void test_serialize_binary_success(const T& value, std::span<const unsigned char> expected)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_binary(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_ALL_EQ(buff.begin(), buff.end(), expected.begin(), expected.end());
+}
+
+// Serializing in binary and parsing back yields the original value
+template <class T>
+void test_serialize_binary_roundtrip(const T& value, std::int32_t type_oid)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+    T out_val{};
+
+    // Act
+    auto err1 = field_serialize_binary(value, buff);
+    auto err2 = field_parse_binary(field_view{buff}, type_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err1, error_code());
+    BOOST_TEST_EQ(err2, error_code());
+    BOOST_TEST(out_val == value);
+}
+
+void test_serialize_oids()
+{
+    BOOST_TEST_EQ(serialize_field_traits<bool>::oid, detail::bool_oid);
+    BOOST_TEST_EQ(serialize_field_traits<char>::oid, detail::char_oid);
+    BOOST_TEST_EQ(serialize_field_traits<std::uint32_t>::oid, detail::oid_oid);
+    BOOST_TEST_EQ(serialize_field_traits<float>::oid, detail::float4_oid);
+    BOOST_TEST_EQ(serialize_field_traits<double>::oid, detail::float8_oid);
+    BOOST_TEST_EQ(serialize_field_traits<std::vector<std::byte>>::oid, detail::bytea_oid);
+    BOOST_TEST_EQ(serialize_field_traits<std::span<const std::byte>>::oid, detail::bytea_oid);
+}
+
+void test_serialize_bool()
+{
+    static constexpr unsigned char pg_true[] = {0x01};
+    static constexpr unsigned char pg_false[] = {0x00};
+    test_serialize_text_success(true, "t");
+    test_serialize_text_success(false, "f");
+    test_serialize_binary_success(true, pg_true);
+    test_serialize_binary_success(false, pg_false);
+}
+
+void test_serialize_char()
+{
+    static constexpr unsigned char pg_char[] = {'a'};
+    test_serialize_text_success('a', "a");
+    test_serialize_binary_success('a', pg_char);
+}
+
+void test_serialize_oid()
+{
+    static constexpr unsigned char pg_oid[] = {0xFF, 0xFF, 0xFF, 0xFE};
+    test_serialize_text_success(std::uint32_t(4294967294u), "4294967294");
+    test_serialize_binary_success(std::uint32_t(4294967294u), pg_oid);
+}
+
+void test_serialize_float()
+{
+    test_serialize_text_success(1.5f, "1.5");
+    test_serialize_text_success(-0.1, "-0.1");
+    test_serialize_text_success(std::numeric_limits<float>::quiet_NaN(), "NaN");
+    test_serialize_text_success(std::numeric_limits<double>::infinity(), "Infinity");
+    test_serialize_text_success(-std::numeric_limits<double>::infinity(), "-Infinity");
+
+    static constexpr unsigned char pg_float4_1_5[] = {0x3F, 0xC0, 0x00, 0x00};
+    static constexpr unsigned char pg_float8_1_5[] = {0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    test_serialize_binary_success(1.5f, pg_float4_1_5);
+    test_serialize_binary_success(1.5, pg_float8_1_5);
+    test_serialize_binary_roundtrip(std::numeric_limits<float>::max(), detail::float4_oid);
+    test_serialize_binary_roundtrip(std::numeric_limits<double>::min(), detail::float8_oid);
+}
+
+void test_serialize_bytea()
+{
+    const std::vector<std::byte> value{std::byte(0x00), std::byte(0xab), std::byte(0x1f)};
+    static constexpr unsigned char pg_bytea[] = {0x00, 0xab, 0x1f};
+    test_serialize_text_success(value, "\\x00ab1f");
+    test_serialize_text_success(std::vector<std::byte>{}, "\\x");
+    test_serialize_binary_success(value, pg_bytea);
+    test_serialize_binary_success(std::span<const std::byte>(value), pg_bytea);
+    test_serialize_binary_roundtrip(value, detail::bytea_oid);
+}
+
+// Long values are encoded in blocks
+void test_serialize_text_bytea_long()
+{
+    for (std::size_t size : {15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 65u, 1000u})
+    {
+        // Arrange
+        std::vector<std::byte> value;
+        std::string expected = "\\x";
+        constexpr char digits[] = "0123456789abcdef";
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            auto byte = static_cast<unsigned char>(i * 13u + 5u);
+            value.push_back(static_cast<std::byte>(byte));
+            expected.push_back(digits[byte >> 4]);
+            expected.push_back(digits[byte & 0x0f]);
+        }
+
+        // Act/assert
+        test_serialize_text_success(value, expected);
+
+        // Roundtrip
+        std::vector<unsigned char> buff;
+        std::vector<std::byte> out_val;
+        BOOST_TEST_EQ(field_serialize_text(value, buff), error_code());
+        BOOST_TEST_EQ(field_parse_text(field_view{buff}, detail::bytea_oid, out_val), error_code());
+        BOOST_TEST(out_val == value);
+    }
+}
+
 //
 // parsable_field / serializable_field
 //
@@ -876,17 +1070,17 @@ static_assert(serializable_field<std::int32_t>);
 static_assert(serializable_field<std::int64_t>);
 static_assert(serializable_field<std::string>);
 static_assert(serializable_field<std::string_view>);
+static_assert(serializable_field<bool>);
+static_assert(serializable_field<char>);
+static_assert(serializable_field<std::uint32_t>);
+static_assert(serializable_field<float>);
+static_assert(serializable_field<double>);
+static_assert(serializable_field<std::vector<std::byte>>);
+static_assert(serializable_field<std::span<const std::byte>>);
 
 // Serialization is not implemented for these yet
-static_assert(!serializable_field<bool>);
-static_assert(!serializable_field<char>);
-static_assert(!serializable_field<float>);
-static_assert(!serializable_field<double>);
-static_assert(!serializable_field<std::vector<std::byte>>);
 static_assert(!serializable_field<std::optional<std::int32_t>>);
 
-// TODO: serialization tests
-
 }  // namespace
 
 int main()
@@ -905,6 +1099,8 @@ int main()
     test_parse_text_bytea_missing_prefix_error();
     test_parse_text_bytea_odd_length_error();
     test_parse_text_bytea_invalid_hex_error();
+    test_parse_text_bytea_long();
+    test_parse_text_bytea_long_invalid_hex_error();
 
     // CHAR
     test_parse_text_char_success();
@@ -1018,5 +1214,14 @@ int main()
     test_field_parse_binary_optional_null_success();
     test_field_parse_text_optional_non_null_success();
 
+    // Serialization
+    test_serialize_oids();
+    test_serialize_bool();
+    test_serialize_char();
+    test_serialize_oid();
+    test_serialize_float();
+    test_serialize_bytea();
+    test_serialize_text_bytea_long();
+
     return boost::report_errors();
 }
@@ -0,0 +1,435 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/describe/class.hpp>
+#include <boost/endian/conversion.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/type_registry.hpp"
+#include "nativepg/types/composite.hpp"
+
+using namespace nativepg;
+using std::error_code;
+
+namespace {
+
+struct point
+{
+    std::int32_t x;
+    std::int32_t y;
+
+    bool operator==(const point&) const = default;
+
+    friend std::ostream& operator<<(std::ostream& os, const point& value)
+    {
+        return os << "point{" << value.x << ", " << value.y << "}";
+    }
+};
+BOOST_DESCRIBE_STRUCT(point, (), (x, y))
+
+struct labeled_point
+{
+    std::string label;
+    point pos;
+    std::optional<std::int64_t> weight;
+};
+BOOST_DESCRIBE_STRUCT(labeled_point, (), (label, pos, weight))
+
+// A struct declaring the composite type it maps to
+struct item
+{
+    std::int32_t id;
+    std::string name;
+};
+BOOST_DESCRIBE_STRUCT(item, (), (id, name))
+
+}  // namespace
+
+template <>
+inline constexpr std::string_view nativepg::types::composite_type_name<item> = "inventory_item";
+
+namespace {
+
+static_assert(parsable_field<point>);
+static_assert(parsable_field<std::vector<point>>);
+
+// A user-defined row type, as returned by a table or CREATE TYPE
+constexpr std::int32_t point_oid = 16500;
+constexpr std::int32_t point_array_oid = 16499;
+
+// Builds binary wire values by hand
+class wire_builder
+{
+    std::vector<unsigned char> buff_;
+
+public:
+    wire_builder& int32(std::int32_t value)
+    {
+        unsigned char bytes[4];
+        boost::endian::endian_store<std::int32_t, 4, boost::endian::order::big>(bytes, value);
+        buff_.insert(buff_.end(), bytes, bytes + 4);
+        return *this;
+    }
+
+    wire_builder& int64(std::int64_t value)
+    {
+        unsigned char bytes[8];
+        boost::endian::endian_store<std::int64_t, 8, boost::endian::order::big>(bytes, value);
+        buff_.insert(buff_.end(), bytes, bytes + 8);
+        return *this;
+    }
+
+    wire_builder& bytes(std::span<const unsigned char> value)
+    {
+        buff_.insert(buff_.end(), value.begin(), value.end());
+        return *this;
+    }
+
+    wire_builder& text(std::string_view value)
+    {
+        buff_.insert(buff_.end(), value.begin(), value.end());
+        return *this;
+    }
+
+    // A composite field holding an int4
+    wire_builder& int4_field(std::int32_t value) { return int32(detail::int4_oid).int32(4).int32(value); }
+
+    const std::vector<unsigned char>& get() const { return buff_; }
+};
+
+std::vector<unsigned char> point_wire(std::int32_t x, std::int32_t y)
+{
+    return wire_builder().int32(2).int4_field(x).int4_field(y).get();
+}
+
+std::vector<unsigned char> point_array_wire(std::span<const point> values)
+{
+    wire_builder res;
+    res.int32(1).int32(0).int32(point_oid).int32(static_cast<std::int32_t>(values.size())).int32(1);
+    for (const auto& p : values)
+    {
+        auto elem = point_wire(p.x, p.y);
+        res.int32(static_cast<std::int32_t>(elem.size())).bytes(elem);
+    }
+    return res.get();
+}
+
+template <class T>
+error_code parse_binary(std::int32_t type_oid, std::span<const unsigned char> wire, T& to)
+{
+    return field_parse_binary(field_view{wire}, type_oid, to);
+}
+
+void test_is_compatible()
+{
+    BOOST_TEST_EQ(field_is_compatible<point>(detail::record_oid), error_code());
+    BOOST_TEST_EQ(field_is_compatible<point>(point_oid), error_code());
+    BOOST_TEST_EQ(
+        field_is_compatible<point>(detail::int4_oid),
+        error_code(client_errc::incompatible_field_type)
+    );
+    BOOST_TEST_EQ(
+        field_is_compatible<point>(detail::record_array_oid),
+        error_code(client_errc::incompatible_field_type)
+    );
+
+    BOOST_TEST_EQ(field_is_compatible<std::vector<point>>(detail::record_array_oid), error_code());
+    BOOST_TEST_EQ(field_is_compatible<std::vector<point>>(point_array_oid), error_code());
+    BOOST_TEST_EQ(
+        field_is_compatible<std::vector<point>>(detail::record_oid),
+        error_code(client_errc::incompatible_field_type)
+    );
+}
+
+// Structs declaring their composite type name are matched by the OID resolved by the registry.
+// Other user-defined types (e.g. enums or extension types) are rejected upfront
+void test_is_compatible_type_name()
+{
+    // Arrange
+    type_registry types;
+    types.add("inventory_item", 16600, 16599);
+    constexpr std::int32_t other_oid = 16700;  // e.g. an enum
+
+    // Composite
+    BOOST_TEST_EQ(field_is_compatible<item>(16600, &types), error_code());
+    BOOST_TEST_EQ(
+        field_is_compatible<item>(other_oid, &types),
+        error_code(client_errc::incompatible_field_type)
+    );
+    BOOST_TEST_EQ(field_is_compatible<item>(16599, &types), error_code(client_errc::incompatible_field_type));
+
+    // Array
+    BOOST_TEST_EQ(field_is_compatible<std::vector<item>>(16599, &types), error_code());
+    BOOST_TEST_EQ(
+        field_is_compatible<std::vector<item>>(other_oid, &types),
+        error_code(client_errc::incompatible_field_type)
+    );
+    BOOST_TEST_EQ(
+        field_is_compatible<std::vector<item>>(16600, &types),
+        error_code(client_errc::incompatible_field_type)
+    );
+}
+
+// Without a resolved name, any user-defined OID is accepted
+void test_is_compatible_type_name_fallback()
+{
+    // Arrange
+    type_registry unresolved;
+    unresolved.add("inventory_item", 0, 0);  // the type doesn't exist
+
+    // Assert
+    BOOST_TEST_EQ(field_is_compatible<item>(16700), error_code());
+    BOOST_TEST_EQ(field_is_compatible<item>(16700, nullptr), error_code());
+    BOOST_TEST_EQ(field_is_compatible<item>(16700, &unresolved), error_code());
+    BOOST_TEST_EQ(field_is_compatible<std::vector<item>>(16701, &unresolved), error_code());
+
+    // Structs without a declared name ignore the registry
+    type_registry types;
+    types.add("inventory_item", 16600, 16599);
+    BOOST_TEST_EQ(field_is_compatible<point>(point_oid, &types), error_code());
+}
+
+void test_parse_success()
+{
+    // Arrange
+    auto wire = point_wire(10, -20);
+    point out{};
+
+    // Act
+    auto err = parse_binary(point_oid, wire, out);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(out, (point{10, -20}));
+}
+
+void test_parse_nested()
+{
+    // Arrange
+    auto inner = point_wire(1, 2);
+    auto wire = wire_builder()
+                    .int32(3)
+                    .int32(detail::text_oid)
+                    .int32(5)
+                    .text("hello")
+                    .int32(point_oid)
+                    .int32(static_cast<std::int32_t>(inner.size()))
+                    .bytes(inner)
+                    .int32(detail::int8_oid)
+                    .int32(8)
+                    .int64(42)
+                    .get();
+    labeled_point out{};
+
+    // Act
+    auto err = parse_binary(detail::record_oid, wire, out);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(out.label, "hello");
+    BOOST_TEST_EQ(out.pos, (point{1, 2}));
+    BOOST_TEST(out.weight == std::optional<std::int64_t>(42));
+}
+
+void test_parse_null_member()
+{
+    // Arrange
+    auto inner = point_wire(1, 2);
+    auto wire = wire_builder()
+                    .int32(3)
+                    .int32(detail::text_oid)
+                    .int32(0)
+                    .int32(point_oid)
+                    .int32(static_cast<std::int32_t>(inner.size()))
+                    .bytes(inner)
+                    .int32(detail::int8_oid)
+                    .int32(-1)
+                    .get();
+    labeled_point out{"abc", {}, 10};
+
+    // Act
+    auto err = parse_binary(detail::record_oid, wire, out);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(out.label, "");
+    BOOST_TEST(out.weight == std::nullopt);
+}
+
+void test_parse_null_member_not_optional()
+{
+    // Arrange
+    auto wire = wire_builder().int32(2).int4_field(1).int32(detail::int4_oid).int32(-1).get();
+    point out{};
+
+    // Act
+    auto err = parse_binary(point_oid, wire, out);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code(client_errc::unexpected_null));
+}
+
+void test_parse_errors()
+{
+    point out{};
+
+    // Field count mismatch
+    auto wire = wire_builder().int32(1).int4_field(1).get();
+    BOOST_TEST_EQ(parse_binary(point_oid, wire, out), error_code(client_errc::incompatible_field_type));
+
+    // Member type mismatch
+    wire = wire_builder().int32(2).int4_field(1).int32(detail::text_oid).int32(1).text("a").get();
+    BOOST_TEST_EQ(parse_binary(point_oid, wire, out), error_code(client_errc::incompatible_field_type));
+
+    // Truncated: missing the count, missing a field, and a length longer than the data
+    BOOST_TEST_EQ(
+        parse_binary(point_oid, std::span<const unsigned char>(), out),
+        error_code(client_errc::protocol_value_error)
+    );
+    wire = wire_builder().int32(2).int4_field(1).get();
+    BOOST_TEST_EQ(parse_binary(point_oid, wire, out), error_code(client_errc::protocol_value_error));
+    wire = wire_builder().int32(2).int4_field(1).int32(detail::int4_oid).int32(4).int32(0).get();
+    wire.pop_back();
+    BOOST_TEST_EQ(parse_binary(point_oid, wire, out), error_code(client_errc::protocol_value_error));
+
+    // Extra bytes
+    wire = point_wire(1, 2);
+    wire.push_back(0);
+    BOOST_TEST_EQ(parse_binary(point_oid, wire, out), error_code(client_errc::extra_bytes));
+
+    // NULL composite
+    BOOST_TEST_EQ(
+        field_parse_binary(field_view(), point_oid, out),
+        error_code(client_errc::unexpected_null)
+    );
+}
+
+void test_parse_text()
+{
+    // Arrange
+    constexpr unsigned char text[] = {'(', '1', ',', '2', ')'};
+    point out{};
+    std::vector<point> out_array;
+
+    // Act
+    auto err1 = field_parse_text(field_view{text}, point_oid, out);
+    auto err2 = field_parse_text(field_view{text}, point_array_oid, out_array);
+
+    // Assert
+    BOOST_TEST_EQ(err1, error_code(client_errc::text_format_not_supported));
+    BOOST_TEST_EQ(err2, error_code(client_errc::text_format_not_supported));
+}
+
+void test_parse_array()
+{
+    // Arrange
+    const point values[] = {
+        {1, 2},
+        {3, 4},
+        {5, 6}
+    };
+    auto wire = point_array_wire(values);
+    std::vector<point> out{
+        {9, 9}
+    };
+
+    // Act
+    auto err = parse_binary(point_array_oid, wire, out);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_ALL_EQ(out.begin(), out.end(), std::begin(values), std::end(values));
+}
+
+void test_parse_array_empty()
+{
+    // Arrange
+    auto wire = wire_builder().int32(0).int32(0).int32(point_oid).get();
+    std::vector<point> out{
+        {9, 9}
+    };
+
+    // Act
+    auto err = parse_binary(point_array_oid, wire, out);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST(out.empty());
+}
+
+void test_parse_array_errors()
+{
+    std::vector<point> out;
+
+    // Multi-dimensional arrays
+    auto wire = wire_builder().int32(2).int32(0).int32(point_oid).int32(1).int32(1).int32(1).int32(1).get();
+    BOOST_TEST_EQ(parse_binary(point_array_oid, wire, out), error_code(client_errc::incompatible_field_type));
+
+    // Element type is not a composite
+    wire = wire_builder().int32(1).int32(0).int32(detail::int4_oid).int32(1).int32(1).int32(4).int32(0).get();
+    BOOST_TEST_EQ(parse_binary(point_array_oid, wire, out), error_code(client_errc::incompatible_field_type));
+
+    // The size is larger than what the data can hold
+    wire = wire_builder().int32(1).int32(0).int32(point_oid).int32(1000000).int32(1).get();
+    BOOST_TEST_EQ(parse_binary(point_array_oid, wire, out), error_code(client_errc::protocol_value_error));
+
+    // NULL elements
+    wire = wire_builder().int32(1).int32(1).int32(point_oid).int32(1).int32(1).int32(-1).get();
+    BOOST_TEST_EQ(parse_binary(point_array_oid, wire, out), error_code(client_errc::unexpected_null));
+
+    // Errors in elements are propagated
+    auto elem = wire_builder().int32(1).int4_field(1).get();
+    wire = wire_builder()
+               .int32(1)
+               .int32(0)
+               .int32(point_oid)
+               .int32(1)
+               .int32(1)
+               .int32(static_cast<std::int32_t>(elem.size()))
+               .bytes(elem)
+               .get();
+    BOOST_TEST_EQ(parse_binary(point_array_oid, wire, out), error_code(client_errc::incompatible_field_type));
+
+    // Extra bytes
+    const point values[] = {
+        {1, 2}
+    };
+    wire = point_array_wire(values);
+    wire.push_back(0);
+    BOOST_TEST_EQ(parse_binary(point_array_oid, wire, out), error_code(client_errc::extra_bytes));
+}
+
+}  // namespace
+
+int main()
+{
+    test_is_compatible();
+    test_is_compatible_type_name();
+    test_is_compatible_type_name_fallback();
+    test_parse_success();
+    test_parse_nested();
+    test_parse_null_member();
+    test_parse_null_member_not_optional();
+    test_parse_errors();
+    test_parse_text();
+    test_parse_array();
+    test_parse_array_empty();
+    test_parse_array_errors();
+
+    return boost::report_errors();
+}
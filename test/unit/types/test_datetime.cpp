@@ -8,12 +8,16 @@
 #include <boost/core/lightweight_test.hpp>
 
 #include <chrono>
+#include <cstdint>
 #include <format>
 #include <span>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <vector>
 
+#include "nativepg/field_traits.hpp"
 #include "nativepg/types/datetime.hpp"
 
 using namespace nativepg;
@@ -281,9 +285,294 @@ void test__parse_binary_interval__success()
     BOOST_TEST_EQ(inv.days, 1);
     BOOST_TEST_EQ(inv.time.count(), 1);
 }
+
+// Serialization
+template <class T>
+void test_serialize_text_success(const T& value, std::string_view expected)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_text(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code());
+    BOOST_TEST_EQ(std::string_view(reinterpret_cast<const char*>(buff.data()), buff.size()), expected);
+}
+
+template <class T>
+void test_serialize_binary_success(const T& value, std::span<const unsigned char> expected)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_binary(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code());
+    BOOST_TEST_ALL_EQ(buff.begin(), buff.end(), expected.begin(), expected.end());
+}
+
+using namespace std::chrono_literals;
+
+constexpr types::pg_date date_19770621 = std::chrono::sys_days{std::chrono::year{1977} / 6 / 21};
+constexpr auto tod_123423 = 12h + 34min + 23s + 435350us;
+constexpr unsigned char pg_date_19770621[] = {0xFF, 0xFF, 0xDF, 0xDB};
+constexpr unsigned char pg_time_210619[] = {0x00, 0x00, 0x00, 0x11, 0xB0, 0xB3, 0x88, 0xC0};
+constexpr unsigned char pg_timetz_123423[] =
+    {0x00, 0x00, 0x00, 0x0A, 0x89, 0xe9, 0x36, 0x56, 0xff, 0xff, 0xb9, 0xb0};
+constexpr unsigned char pg_timestamp_20260208[] = {0x00, 0x02, 0xed, 0x4E, 0x02, 0xc9, 0xd6, 0x56};
+
+void test__serialize_date__success()
+{
+    static constexpr unsigned char pg_date_inf[] = {0x7F, 0xFF, 0xFF, 0xFF};
+    test_serialize_text_success(date_19770621, "1977-06-21");
+    test_serialize_text_success(types::pg_date{std::chrono::year{0} / 1 / 1}, "0001-01-01 BC");
+    test_serialize_text_success(types::pg_date::max(), "infinity");
+    test_serialize_text_success(types::pg_date::min(), "-infinity");
+    test_serialize_binary_success(date_19770621, pg_date_19770621);
+    test_serialize_binary_success(types::pg_date::max(), pg_date_inf);
+    BOOST_TEST_EQ(serialize_field_traits<types::pg_date>::oid, detail::date_oid);
+}
+
+void test__serialize_time__success()
+{
+    test_serialize_text_success(types::pg_time{21h + 6min + 19s}, "21:06:19.000000");
+    test_serialize_text_success(types::pg_time{7us}, "00:00:00.000007");
+    test_serialize_binary_success(types::pg_time{21h + 6min + 19s}, pg_time_210619);
+    BOOST_TEST_EQ(serialize_field_traits<types::pg_time>::oid, detail::time_oid);
+}
+
+void test__serialize_timetz__success()
+{
+    test_serialize_text_success(types::pg_timetz{tod_123423, 5h}, "12:34:23.435350+05:00");
+    test_serialize_text_success(types::pg_timetz{tod_123423, -(3h + 30min)}, "12:34:23.435350-03:30");
+    test_serialize_binary_success(types::pg_timetz{tod_123423, 5h}, pg_timetz_123423);
+    BOOST_TEST_EQ(serialize_field_traits<types::pg_timetz>::oid, detail::timetz_oid);
+}
+
+void test__serialize_timestamp__success()
+{
+    static constexpr unsigned char pg_timestamp_ninf[] = {0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    const types::pg_timestamp ts{(std::chrono::sys_days{std::chrono::year{2026} / 2 / 8} + tod_123423)
+                                     .time_since_epoch()};
+    test_serialize_text_success(ts, "2026-02-08 12:34:23.435350");
+    test_serialize_text_success(types::pg_timestamp::max(), "infinity");
+    test_serialize_binary_success(ts, pg_timestamp_20260208);
+    test_serialize_binary_success(types::pg_timestamp::min(), pg_timestamp_ninf);
+    BOOST_TEST_EQ(serialize_field_traits<types::pg_timestamp>::oid, detail::timestamp_oid);
+}
+
+void test__serialize_timestamptz__success()
+{
+    const types::pg_timestamptz ts{std::chrono::sys_days{std::chrono::year{2026} / 2 / 8} + tod_123423};
+    test_serialize_text_success(ts, "2026-02-08 12:34:23.435350+00");
+    test_serialize_text_success(
+        types::pg_timestamptz{std::chrono::sys_days{std::chrono::year{-1} / 3 / 4} + 5h},
+        "0002-03-04 05:00:00.000000+00 BC"
+    );
+    test_serialize_binary_success(ts, pg_timestamp_20260208);
+    BOOST_TEST_EQ(serialize_field_traits<types::pg_timestamptz>::oid, detail::timestamptz_oid);
+}
+
+void test__serialize_interval__success()
+{
+    static constexpr unsigned char pg_interval_be[] =
+        {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x03};
+    test_serialize_text_success(
+        types::pg_interval{14, 3, 4h + 5min + 6s + 7us},
+        "14 mons 3 days 04:05:06.000007"
+    );
+    test_serialize_text_success(types::pg_interval{-1, 0, -(100h)}, "-1 mons 0 days -100:00:00.000000");
+    test_serialize_binary_success(types::pg_interval{3, 2, 1us}, pg_interval_be);
+    BOOST_TEST_EQ(serialize_field_traits<types::pg_interval>::oid, detail::interval_oid);
+}
+
+static_assert(serializable_field<types::pg_date>);
+static_assert(serializable_field<types::pg_time>);
+static_assert(serializable_field<types::pg_timetz>);
+static_assert(serializable_field<types::pg_timestamp>);
+static_assert(serializable_field<types::pg_timestamptz>);
+static_assert(serializable_field<types::pg_interval>);
+
+// ISO fast path. Surrounding the input with spaces makes it go through the generic parser,
+// so we can check that both agree
+std::span<const unsigned char> to_span(std::string_view str)
+{
+    return {reinterpret_cast<const unsigned char*>(str.data()), str.size()};
+}
+
+template <class T, class ParseFn>
+void check_fast_path(ParseFn parse, std::string_view str, T expected)
+{
+    T fast{}, generic{};
+    const std::string padded = " " + std::string(str) + " ";
+
+    BOOST_TEST_EQ(parse(to_span(str), fast), std::error_code());
+    BOOST_TEST_EQ(parse(to_span(padded), generic), std::error_code());
+    BOOST_TEST(fast == expected);
+    BOOST_TEST(generic == expected);
+}
+
+template <class T, class ParseFn>
+void check_parse_error(ParseFn parse, std::string_view str)
+{
+    T value{};
+    BOOST_TEST_NE(parse(to_span(str), value), std::error_code());
+}
+
+void test__parse_text_date__iso_fast_path()
+{
+    using namespace std::chrono;
+    auto parse = [](std::span<const unsigned char> from, types::pg_date& to) {
+        return types::parse_text_date(from, to);
+    };
+
+    check_fast_path(parse, "1977-06-21", types::pg_date{year{1977} / 6 / 21});
+    check_fast_path(parse, "2000-01-01", types::pg_date{year{2000} / 1 / 1});
+    check_fast_path(parse, "2024-02-29", types::pg_date{year{2024} / 2 / 29});
+    check_fast_path(parse, "9999-12-31", types::pg_date{year{9999} / 12 / 31});
+    check_fast_path(parse, "0001-01-01", types::pg_date{year{1} / 1 / 1});
+
+    // Layouts handled by the generic parser
+    types::pg_date d{};
+    BOOST_TEST_EQ(types::parse_text_date(to_span("0001-01-01 BC"), d), std::error_code());
+    BOOST_TEST(d == types::pg_date{year{0} / 1 / 1});
+    BOOST_TEST_EQ(types::parse_text_date(to_span("10000-01-01"), d), std::error_code());
+    BOOST_TEST(d == types::pg_date{year{10000} / 1 / 1});
+    BOOST_TEST_EQ(types::parse_text_date(to_span("infinity"), d), std::error_code());
+    BOOST_TEST(d == types::pg_date::max());
+
+    // Errors are detected, even if the layout matches
+    check_parse_error<types::pg_date>(parse, "2023-02-29");
+    check_parse_error<types::pg_date>(parse, "2024-13-01");
+    check_parse_error<types::pg_date>(parse, "2024-00-10");
+    check_parse_error<types::pg_date>(parse, "2024-01-3a");
+    check_parse_error<types::pg_date>(parse, "2024/01/30");
+}
+
+void test__parse_text_time__iso_fast_path()
+{
+    using namespace std::chrono;
+    auto parse = [](std::span<const unsigned char> from, types::pg_time& to) {
+        return types::parse_text_time(from, to);
+    };
+
+    check_fast_path(parse, "00:00:00", types::pg_time{0});
+    check_fast_path(parse, "21:06:19", types::pg_time{hours{21} + minutes{6} + seconds{19}});
+    check_fast_path(parse, "23:59:59.999999", types::pg_time{hours{24} - microseconds{1}});
+    check_fast_path(
+        parse,
+        "12:34:23.43535",
+        types::pg_time{hours{12} + minutes{34} + microseconds{23435350}}
+    );
+    check_fast_path(parse, "12:34:23.4", types::pg_time{hours{12} + minutes{34} + milliseconds{23400}});
+
+    // 24:00:00 is handled by the generic parser
+    types::pg_time t{};
+    BOOST_TEST_EQ(types::parse_text_time(to_span("24:00:00"), t), std::error_code());
+    BOOST_TEST(t == hours{24});
+
+    check_parse_error<types::pg_time>(parse, "12:60:00");
+    check_parse_error<types::pg_time>(parse, "12:00:60");
+    check_parse_error<types::pg_time>(parse, "25:00:00");
+    check_parse_error<types::pg_time>(parse, "12:00:00.");
+    check_parse_error<types::pg_time>(parse, "12-00-00");
+}
+
+void test__parse_text_timetz__iso_fast_path()
+{
+    using namespace std::chrono;
+    auto parse = [](std::span<const unsigned char> from, types::pg_timetz& to) {
+        return types::parse_text_timetz(from, to);
+    };
+    auto check = [&](std::string_view str, types::pg_time tod, seconds offset) {
+        types::pg_timetz fast{}, generic{};
+        const std::string padded = " " + std::string(str) + " ";
+        BOOST_TEST_EQ(parse(to_span(str), fast), std::error_code());
+        BOOST_TEST_EQ(parse(to_span(padded), generic), std::error_code());
+        BOOST_TEST(fast.time_since_midnight == tod);
+        BOOST_TEST(fast.utc_offset == offset);
+        BOOST_TEST(generic.time_since_midnight == tod);
+        BOOST_TEST(generic.utc_offset == offset);
+    };
+
+    check("21:06:19+07", hours{21} + minutes{6} + seconds{19}, hours{7});
+    check("21:06:19.5-03:30", hours{21} + minutes{6} + milliseconds{19500}, -(hours{3} + minutes{30}));
+    check("00:00:00+00:00", hours{0}, seconds{0});
+
+    check_parse_error<types::pg_timetz>(parse, "21:06:19+16");
+    check_parse_error<types::pg_timetz>(parse, "21:06:19+07:60");
+    check_parse_error<types::pg_timetz>(parse, "21:06:19*07");
+}
+
+void test__parse_text_timestamp__iso_fast_path()
+{
+    using namespace std::chrono;
+    auto parse = [](std::span<const unsigned char> from, types::pg_timestamp& to) {
+        return types::parse_text_timestamp(from, to);
+    };
+    auto make = [](year_month_day ymd, microseconds tod) {
+        return types::pg_timestamp{local_days{ymd}.time_since_epoch() + tod};
+    };
+
+    check_fast_path(
+        parse,
+        "1977-06-21 21:06:19",
+        make(year{1977} / 6 / 21, hours{21} + minutes{6} + seconds{19})
+    );
+    check_fast_path(
+        parse,
+        "2026-02-08 12:34:23.43535",
+        make(year{2026} / 2 / 8, hours{12} + minutes{34} + microseconds{23435350})
+    );
+    check_fast_path(
+        parse,
+        "1969-12-31 23:59:59.000001",
+        make(year{1969} / 12 / 31, hours{24} - microseconds{999999})
+    );
+
+    // Layouts handled by the generic parser
+    types::pg_timestamp ts{};
+    BOOST_TEST_EQ(types::parse_text_timestamp(to_span("0001-01-01 00:00:00 BC"), ts), std::error_code());
+    BOOST_TEST(ts == make(year{0} / 1 / 1, microseconds{0}));
+    BOOST_TEST_EQ(types::parse_text_timestamp(to_span("2020-01-01T10:00:00"), ts), std::error_code());
+    BOOST_TEST(ts == make(year{2020} / 1 / 1, hours{10}));
+
+    check_parse_error<types::pg_timestamp>(parse, "2023-02-29 10:00:00");
+    check_parse_error<types::pg_timestamp>(parse, "2023-02-28 10:00:0x");
+    check_parse_error<types::pg_timestamp>(parse, "2023-02-28 10:00:00+01");
+}
+
+void test__parse_text_timestamptz__iso_fast_path()
+{
+    using namespace std::chrono;
+    auto parse = [](std::span<const unsigned char> from, types::pg_timestamptz& to) {
+        return types::parse_text_timestamptz(from, to);
+    };
+    auto make = [](year_month_day ymd, microseconds tod) {
+        return types::pg_timestamptz{sys_days{ymd}.time_since_epoch() + tod};
+    };
+
+    check_fast_path(parse, "2026-02-08 20:03:00+00", make(year{2026} / 2 / 8, hours{20} + minutes{3}));
+    check_fast_path(
+        parse,
+        "2026-02-08 20:03:00.25+02",
+        make(year{2026} / 2 / 8, hours{18} + minutes{3} + milliseconds{250})
+    );
+    check_fast_path(parse, "2026-02-08 20:03:00-05:30", make(year{2026} / 2 / 9, hours{1} + minutes{33}));
+
+    // Offsets with seconds are handled by the generic parser, which doesn't support them
+    check_parse_error<types::pg_timestamptz>(parse, "2026-02-08 20:03:00+00:00:00");
+    check_parse_error<types::pg_timestamptz>(parse, "2026-02-30 20:03:00+00");
+    check_parse_error<types::pg_timestamptz>(parse, "2026-02-08 20:03:00+0a");
+}
+
 }  // namespace
 
-// TODO: traits tests missing
+// TODO: parse traits tests missing
 
 int main()
 {
@@ -305,5 +594,18 @@ int main()
     test__parse_text_interval__success();
     test__parse_binary_interval__success();
 
+    test__parse_text_date__iso_fast_path();
+    test__parse_text_time__iso_fast_path();
+    test__parse_text_timetz__iso_fast_path();
+    test__parse_text_timestamp__iso_fast_path();
+    test__parse_text_timestamptz__iso_fast_path();
+
+    test__serialize_date__success();
+    test__serialize_time__success();
+    test__serialize_timetz__success();
+    test__serialize_timestamp__success();
+    test__serialize_timestamptz__success();
+    test__serialize_interval__success();
+
     return boost::report_errors();
 }
@@ -240,6 +240,18 @@ int main()
     // Same digits as pg_num_1234_5678 but dscale=2, forcing real rounding: 1234.5678 -> 1234.57
     static constexpr unsigned char pg_num_round[] =
         {0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x04, 0xD2, 0x16, 0x2E};
+    // 0.1 -> ndigits=1, weight=-1, sign=0x0000, dscale=1, group 0=1000. Exactly representable in all types
+    static constexpr unsigned char pg_num_tenth[] =
+        {0x00, 0x01, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x01, 0x03, 0xE8};
+    // 1500000 -> ndigits=1, weight=1, sign=0x0000, dscale=0, group 0=150 (trailing zero groups omitted)
+    static constexpr unsigned char pg_num_int_trailing_zeros[] =
+        {0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x96};
+    // 123456789012345678901234 -> ndigits=6, weight=5, sign=0x0000, dscale=0.
+    // The significand doesn't fit in 64 bits, so this exercises the digit-by-digit path
+    static constexpr unsigned char pg_num_wide[] = {
+        0x00, 0x06, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x04, 0xD2,
+        0x16, 0x2E, 0x23, 0x34, 0x0D, 0x80, 0x1E, 0xD2, 0x04, 0xD2,
+    };
     // Header-only buffer, too short to even contain a valid 8-byte header.
     static constexpr unsigned char pg_too_short[] = {0x00, 0x01, 0x00, 0x00};
     // Declares ndigits=2 but only provides 1 digit group (10 bytes instead of the required 12).
@@ -262,6 +274,9 @@ int main()
     test_parse_text_decimal_from_str("000123.45", d32("123.45"));
     test_parse_text_decimal_from_str("inf", d32("inf"));
     test_parse_text_decimal_from_str("-inf", d32("-inf"));
+    test_parse_text_decimal_from_str("-0.001", d32("-0.001"));
+    test_parse_binary_decimal_success(pg_num_tenth, d32(1, -1));
+    test_parse_binary_decimal_success(pg_num_int_trailing_zeros, d32(1500000));
 
     using d64 = bd::decimal64_t;
     test_parse_text_decimal_success(d64{"1234567.99"});
@@ -276,6 +291,9 @@ int main()
     test_parse_binary_decimal_success(pg_num_infinity_neg, d64("-inf"));
     test_parse_binary_decimal_success(pg_num_frac, d64("0.001"));
     test_parse_binary_decimal_success(pg_num_round, d64("1234.57"));
+    test_parse_binary_decimal_success(pg_num_tenth, d64(1, -1));
+    test_parse_text_decimal_from_str("1234.5678", d64(12345678, -4));
+    test_parse_text_decimal_from_str("-98765432109876.54", d64("-98765432109876.54"));
 
     using d128 = bd::decimal128_t;
     test_parse_text_decimal_success(d128{"1234567.99"});
@@ -290,6 +308,9 @@ int main()
     test_parse_binary_decimal_success(pg_num_infinity_neg, d128("-inf"));
     test_parse_binary_decimal_success(pg_num_frac, d128("0.001"));
     test_parse_binary_decimal_success(pg_num_round, d128("1234.57"));
+    test_parse_binary_decimal_success(pg_num_tenth, d128(1, -1));
+    test_parse_binary_decimal_success(pg_num_wide, d128("123456789012345678901234"));
+    test_parse_text_decimal_from_str("123456789012345678901234.5", d128("123456789012345678901234.5"));
 
     // Malformed text input: must not throw out of parse_text_decimal, and must report protocol_value_error.
     const std::error_code parse_error(client_errc::protocol_value_error);
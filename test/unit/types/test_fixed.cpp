@@ -0,0 +1,293 @@
+//
+// Copyright (c) 2025 Ruben Perez Hidalgo (rubenperez038 at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/core/lightweight_test.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include "nativepg/client_errc.hpp"
+#include "nativepg/field_traits.hpp"
+#include "nativepg/types/fixed.hpp"
+
+using namespace nativepg;
+using std::error_code;
+
+namespace nativepg::types {
+
+template <unsigned Scale, class Rep>
+std::ostream& operator<<(std::ostream& os, const pg_fixed<Scale, Rep>& value)
+{
+    return os << "pg_fixed<" << Scale << ">{" << static_cast<long long>(value.value) << "}";
+}
+
+}  // namespace nativepg::types
+
+namespace {
+
+field_view make_field(std::string_view str)
+{
+    return field_view{
+        std::span<const unsigned char>(reinterpret_cast<const unsigned char*>(str.data()), str.size())
+    };
+}
+
+template <class T>
+void test_parse_text_success(std::int32_t type_oid, std::string_view str, T expected)
+{
+    // Arrange
+    T out_val{};
+
+    // Act
+    auto err = field_parse_text(make_field(str), type_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(out_val, expected);
+}
+
+template <class T>
+void test_parse_text_error(std::int32_t type_oid, std::string_view str, error_code expected)
+{
+    // Arrange
+    T out_val{};
+
+    // Act
+    auto err = field_parse_text(make_field(str), type_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, expected);
+}
+
+template <class T>
+void test_parse_binary_success(std::int32_t type_oid, std::span<const unsigned char> wire, T expected)
+{
+    // Arrange
+    T out_val{};
+
+    // Act
+    auto err = field_parse_binary(field_view{wire}, type_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(out_val, expected);
+}
+
+template <class T>
+void test_parse_binary_error(std::int32_t type_oid, std::span<const unsigned char> wire, error_code expected)
+{
+    // Arrange
+    T out_val{};
+
+    // Act
+    auto err = field_parse_binary(field_view{wire}, type_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, expected);
+}
+
+template <class T>
+void test_serialize_text(T value, std::string_view expected)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_text(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_EQ(std::string_view(reinterpret_cast<const char*>(buff.data()), buff.size()), expected);
+}
+
+template <class T>
+void test_serialize_binary(T value, std::span<const unsigned char> expected)
+{
+    // Arrange
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_binary(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, error_code());
+    BOOST_TEST_ALL_EQ(buff.begin(), buff.end(), expected.begin(), expected.end());
+}
+
+// Serializing and parsing back yields the original value, both in text and binary
+template <class T>
+void test_roundtrip(T value)
+{
+    // Arrange
+    std::vector<unsigned char> text_buff, binary_buff;
+    T text_val{}, binary_val{};
+
+    // Act
+    auto err1 = field_serialize_text(value, text_buff);
+    auto err2 = field_serialize_binary(value, binary_buff);
+    auto err3 = field_parse_text(field_view{text_buff}, detail::numeric_oid, text_val);
+    auto err4 = field_parse_binary(field_view{binary_buff}, detail::numeric_oid, binary_val);
+
+    // Assert
+    BOOST_TEST_EQ(err1, error_code());
+    BOOST_TEST_EQ(err2, error_code());
+    BOOST_TEST_EQ(err3, error_code());
+    BOOST_TEST_EQ(err4, error_code());
+    BOOST_TEST_EQ(text_val, value);
+    BOOST_TEST_EQ(binary_val, value);
+}
+
+using fixed2 = types::pg_fixed<2>;
+using fixed4 = types::pg_fixed<4>;
+using fixed0_32 = types::pg_fixed<0, std::int32_t>;
+using fixed4_32 = types::pg_fixed<4, std::int32_t>;
+
+static_assert(parsable_field<fixed4>);
+static_assert(serializable_field<fixed4>);
+
+// Wire representations of numeric values
+// 12.34: ndigits=2, weight=0, sign=+, dscale=2, groups=[12, 3400]
+constexpr unsigned char pg_num_12_34[] =
+    {0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x0C, 0x0D, 0x48};
+// -0.0001: ndigits=1, weight=-1, sign=-, dscale=4, groups=[1]
+constexpr unsigned char pg_num_neg_tenthousandth[] =
+    {0x00, 0x01, 0xFF, 0xFF, 0x40, 0x00, 0x00, 0x04, 0x00, 0x01};
+// 1500000: ndigits=1, weight=1, sign=+, dscale=0, groups=[150]. Trailing zero groups are omitted
+constexpr unsigned char pg_num_1500000[] = {0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x96};
+// 0: no groups
+constexpr unsigned char pg_num_zero_scale2[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02};
+// 12.345: ndigits=2, weight=0, sign=+, dscale=3, groups=[12, 3450]
+constexpr unsigned char pg_num_12_345[] =
+    {0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x0C, 0x0D, 0x7A};
+// NaN
+constexpr unsigned char pg_num_nan[] = {0x00, 0x00, 0x00, 0x00, 0xC0, 0x00, 0x00, 0x00};
+// A group >= 10000
+constexpr unsigned char pg_num_bad_group[] = {0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0x10};
+// The header says there is a group, but it's not there
+constexpr unsigned char pg_num_missing_group[] = {0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+// money: 123456 cents ($1,234.56) and -5 cents
+constexpr unsigned char pg_money_1234_56[] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xE2, 0x40};
+constexpr unsigned char pg_money_neg_0_05[] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFB};
+
+}  // namespace
+
+int main()
+{
+    constexpr auto numeric_oid = detail::numeric_oid;
+    constexpr auto money_oid = detail::money_oid;
+
+    // Compatibility
+    BOOST_TEST_EQ(field_is_compatible<fixed4>(numeric_oid), error_code());
+    BOOST_TEST_EQ(field_is_compatible<fixed4>(money_oid), error_code());
+    BOOST_TEST_EQ(
+        field_is_compatible<fixed4>(detail::int8_oid),
+        error_code(client_errc::incompatible_field_type)
+    );
+
+    // Parse text
+    test_parse_text_success(numeric_oid, "12.34", fixed2{1234});
+    test_parse_text_success(numeric_oid, "12.34", fixed4{123400});
+    test_parse_text_success(numeric_oid, "-0.0001", fixed4{-1});
+    test_parse_text_success(numeric_oid, "0", fixed4{0});
+    test_parse_text_success(numeric_oid, "1500000", fixed2{150000000});
+    test_parse_text_success(numeric_oid, "12.3400", fixed2{1234});  // trailing zeros beyond our scale
+    test_parse_text_success(numeric_oid, "-2147483648", fixed0_32{std::numeric_limits<std::int32_t>::min()});
+    test_parse_text_success(numeric_oid, "2147483647", fixed0_32{std::numeric_limits<std::int32_t>::max()});
+    test_parse_text_success(
+        numeric_oid,
+        "-922337203685477.5808",
+        fixed4{std::numeric_limits<std::int64_t>::min()}
+    );
+    test_parse_text_error<fixed2>(numeric_oid, "12.345", client_errc::incompatible_response_length);
+    test_parse_text_error<fixed0_32>(numeric_oid, "2147483648", client_errc::value_out_of_range);
+    test_parse_text_error<fixed4_32>(numeric_oid, "1000000", client_errc::value_out_of_range);
+    test_parse_text_error<fixed4>(numeric_oid, "NaN", client_errc::value_out_of_range);
+    test_parse_text_error<fixed4>(numeric_oid, "Infinity", client_errc::value_out_of_range);
+    test_parse_text_error<fixed4>(numeric_oid, "-Infinity", client_errc::value_out_of_range);
+    test_parse_text_error<fixed4>(numeric_oid, "", client_errc::protocol_value_error);
+    test_parse_text_error<fixed4>(numeric_oid, "1.2.3", client_errc::protocol_value_error);
+    test_parse_text_error<fixed4>(numeric_oid, "1-2", client_errc::protocol_value_error);
+    test_parse_text_error<fixed4>(numeric_oid, "$12", client_errc::protocol_value_error);
+
+    // Parse binary
+    test_parse_binary_success(numeric_oid, pg_num_12_34, fixed2{1234});
+    test_parse_binary_success(numeric_oid, pg_num_12_34, fixed4{123400});
+    test_parse_binary_success(numeric_oid, pg_num_neg_tenthousandth, fixed4{-1});
+    test_parse_binary_success(numeric_oid, pg_num_1500000, fixed2{150000000});
+    test_parse_binary_success(numeric_oid, pg_num_1500000, fixed0_32{1500000});
+    test_parse_binary_success(numeric_oid, pg_num_zero_scale2, fixed2{0});
+    test_parse_binary_success(numeric_oid, pg_num_12_345, types::pg_fixed<3>{12345});
+    test_parse_binary_error<fixed2>(numeric_oid, pg_num_12_345, client_errc::incompatible_response_length);
+    test_parse_binary_error<fixed2>(
+        numeric_oid,
+        pg_num_neg_tenthousandth,
+        client_errc::incompatible_response_length
+    );
+    test_parse_binary_error<fixed4_32>(numeric_oid, pg_num_1500000, client_errc::value_out_of_range);
+    test_parse_binary_error<fixed4>(numeric_oid, pg_num_nan, client_errc::value_out_of_range);
+    test_parse_binary_error<fixed4>(numeric_oid, pg_num_bad_group, client_errc::protocol_value_error);
+    test_parse_binary_error<fixed4>(numeric_oid, pg_num_missing_group, client_errc::protocol_value_error);
+    test_parse_binary_error<fixed4>(
+        numeric_oid,
+        std::span(pg_num_12_34, 6),
+        client_errc::protocol_value_error
+    );
+
+    // Money
+    test_parse_text_success(money_oid, "$1,234.56", fixed2{123456});
+    test_parse_text_success(money_oid, "$1,234.56", fixed4{12345600});
+    test_parse_text_success(money_oid, "-$0.05", fixed2{-5});
+    test_parse_text_success(money_oid, "($0.05)", fixed2{-5});
+    test_parse_text_error<fixed0_32>(money_oid, "$1,234.56", client_errc::incompatible_response_length);
+    test_parse_text_error<fixed2>(money_oid, "$", client_errc::protocol_value_error);
+    test_parse_binary_success(money_oid, pg_money_1234_56, fixed2{123456});
+    test_parse_binary_success(money_oid, pg_money_1234_56, fixed4{12345600});
+    test_parse_binary_success(money_oid, pg_money_neg_0_05, fixed4{-500});
+    test_parse_binary_success(money_oid, pg_money_1234_56, fixed4_32{12345600});
+    test_parse_binary_error<fixed0_32>(
+        money_oid,
+        pg_money_1234_56,
+        client_errc::incompatible_response_length
+    );
+    test_parse_binary_error<fixed2>(
+        money_oid,
+        std::span(pg_money_1234_56, 4),
+        client_errc::protocol_value_error
+    );
+
+    // Serialize
+    test_serialize_text(fixed2{1234}, "12.34");
+    test_serialize_text(fixed2{-5}, "-0.05");
+    test_serialize_text(fixed2{0}, "0.00");
+    test_serialize_text(fixed0_32{-7}, "-7");
+    test_serialize_text(fixed4{std::numeric_limits<std::int64_t>::min()}, "-922337203685477.5808");
+    test_serialize_binary(fixed2{1234}, pg_num_12_34);
+    test_serialize_binary(fixed4{-1}, pg_num_neg_tenthousandth);
+    test_serialize_binary(types::pg_fixed<0>{1500000}, pg_num_1500000);
+    test_serialize_binary(fixed2{0}, pg_num_zero_scale2);
+    test_serialize_binary(types::pg_fixed<3>{12345}, pg_num_12_345);
+
+    // Roundtrip
+    test_roundtrip(fixed2{1234});
+    test_roundtrip(fixed2{-1});
+    test_roundtrip(fixed4{0});
+    test_roundtrip(fixed4{std::numeric_limits<std::int64_t>::min()});
+    test_roundtrip(fixed4{std::numeric_limits<std::int64_t>::max()});
+    test_roundtrip(types::pg_fixed<18>{std::numeric_limits<std::int64_t>::max()});
+    test_roundtrip(types::pg_fixed<7>{-123456789012345});
+    test_roundtrip(fixed0_32{std::numeric_limits<std::int32_t>::min()});
+    test_roundtrip(fixed4_32{std::numeric_limits<std::int32_t>::max()});
+
+    return boost::report_errors();
+}
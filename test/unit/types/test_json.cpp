@@ -6,24 +6,59 @@
 //
 
 #include <boost/core/lightweight_test.hpp>
+#include <boost/describe/class.hpp>
+#include <boost/json/monotonic_resource.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <boost/json/src.hpp>  // inline header-only implementation (single TU)
 #include <boost/json/value.hpp>
 
 #include <cstdint>
+#include <optional>
 #include <span>
 #include <string>
+#include <string_view>
 #include <system_error>
+#include <utility>
 #include <vector>
 
 #include "nativepg/field_traits.hpp"
+#include "nativepg/protocol/command_complete.hpp"
+#include "nativepg/protocol/data_row.hpp"
+#include "nativepg/protocol/describe.hpp"
+#include "nativepg/protocol/detail/serialization_context.hpp"
+#include "nativepg/request.hpp"
+#include "nativepg/responses/into.hpp"
 #include "nativepg/types/json.hpp"
 
 using namespace nativepg;
 
 namespace {
 
+struct person
+{
+    std::string name;
+    std::int32_t age;
+    std::vector<std::string> tags;
+
+    bool operator==(const person&) const = default;
+};
+BOOST_DESCRIBE_STRUCT(person, (), (name, age, tags))
+
+struct document
+{
+    std::int32_t id;
+    boost::json::value doc;
+};
+BOOST_DESCRIBE_STRUCT(document, (), (id, doc))
+
+struct nullable_document
+{
+    std::int32_t id;
+    std::optional<boost::json::value> doc;
+};
+BOOST_DESCRIBE_STRUCT(nullable_document, (), (id, doc))
+
 field_view make_field_view(const std::string_view& str)
 {
     return field_view(
@@ -292,6 +327,393 @@ void test_field_parse_binary_jsonb_success()
     BOOST_TEST(out_val == boost::json::parse(json_text));
 }
 
+//
+// Arenas: the parsed value uses the memory resource of the destination
+//
+void test_parse_text_json_uses_storage()
+{
+    // Arrange
+    boost::json::storage_ptr arena = boost::json::make_shared_resource<boost::json::monotonic_resource>();
+    boost::json::value out_val(arena);
+    const std::string str = R"({"name":"John","tags":["a","b"]})";
+
+    // Act
+    auto err = types::parse_json(str, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST(out_val == boost::json::parse(str));
+    BOOST_TEST(out_val.storage() == arena);
+    BOOST_TEST(out_val.as_object().at("tags").storage() == arena);
+}
+
+void test_field_parse_binary_jsonb_uses_storage()
+{
+    // Arrange
+    boost::json::storage_ptr arena = boost::json::make_shared_resource<boost::json::monotonic_resource>();
+    boost::json::value out_val(arena);
+    const std::string wire = "\x01[1,2,3]";
+    const auto fv = make_field_view(wire);
+
+    // Act
+    auto err = field_parse_binary(fv, detail::jsonb_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST(out_val == boost::json::parse("[1,2,3]"));
+    BOOST_TEST(out_val.storage() == arena);
+}
+
+// Serializes the messages for a resultset with an int4 id and a jsonb doc column
+void make_descriptions(std::vector<unsigned char>& buff)
+{
+    protocol::detail::serialization_context ctx(buff);
+    ctx.add_integral(static_cast<std::int16_t>(2));
+    const std::pair<std::string_view, std::int32_t> fields[] = {
+        {"id",  23               },
+        {"doc", detail::jsonb_oid},
+    };
+    for (auto [name, oid] : fields)
+    {
+        ctx.add_string(name);
+        ctx.add_integral(std::int32_t(0));   // table OID
+        ctx.add_integral(std::int16_t(-1));  // column attribute
+        ctx.add_integral(oid);
+        ctx.add_integral(std::int16_t(-1));  // type length
+        ctx.add_integral(std::int32_t(-1));  // type modifier
+        ctx.add_integral(static_cast<std::int16_t>(protocol::format_code::text));
+    }
+}
+
+// A null doc is represented by an empty optional
+void make_row(std::vector<unsigned char>& buff, std::string_view id, std::optional<std::string_view> doc)
+{
+    protocol::detail::serialization_context ctx(buff);
+    ctx.add_integral(std::int16_t(2));
+    for (auto value : {std::optional<std::string_view>(id), doc})
+    {
+        ctx.add_integral(value ? static_cast<std::int32_t>(value->size()) : std::int32_t(-1));
+        if (value)
+            ctx.add_bytes(*value);
+    }
+}
+
+// Parsing a resultset with into() and json_storage places all values in the arena
+void test_into_json_storage()
+{
+    // Arrange. The messages' storage must outlive the messages
+    std::vector<unsigned char> descrs_buff, row1_buff, row2_buff;
+    make_descriptions(descrs_buff);
+    make_row(row1_buff, "1", R"({"tags":["a","b"]})");
+    make_row(row2_buff, "2", "[1,2,3]");
+    protocol::row_description descrs;
+    protocol::data_row row1, row2;
+    BOOST_TEST_EQ(protocol::parse(descrs_buff, descrs), std::error_code());
+    BOOST_TEST_EQ(protocol::parse(row1_buff, row1), std::error_code());
+    BOOST_TEST_EQ(protocol::parse(row2_buff, row2), std::error_code());
+
+    boost::json::storage_ptr arena = boost::json::make_shared_resource<boost::json::monotonic_resource>();
+    std::vector<document> docs;
+    auto cb = into(docs, types::json_storage{arena});
+    request req;
+    req.add_simple_query("SELECT 1");
+    cb.setup(req, 0u);
+
+    // Act
+    cb.on_message(descrs, 0u);
+    cb.on_message(row1, 0u);
+    cb.on_message(row2, 0u);
+    cb.on_message(protocol::command_complete{}, 0u);
+
+    // Assert
+    BOOST_TEST_EQ(cb.result().code, std::error_code());
+    BOOST_TEST_EQ(docs.size(), 2u);
+    BOOST_TEST_EQ(docs[0].id, 1);
+    BOOST_TEST(docs[0].doc == boost::json::parse(R"({"tags":["a","b"]})"));
+    BOOST_TEST(docs[0].doc.storage() == arena);
+    BOOST_TEST(docs[0].doc.as_object().at("tags").storage() == arena);
+    BOOST_TEST_EQ(docs[1].id, 2);
+    BOOST_TEST(docs[1].doc == boost::json::parse("[1,2,3]"));
+    BOOST_TEST(docs[1].doc.storage() == arena);
+}
+
+// Nullable JSON columns are placed in the arena, too
+void test_into_json_storage_optional()
+{
+    // Arrange. The messages' storage must outlive the messages
+    std::vector<unsigned char> descrs_buff, row1_buff, row2_buff;
+    make_descriptions(descrs_buff);
+    make_row(row1_buff, "1", R"({"tags":["a","b"]})");
+    make_row(row2_buff, "2", std::nullopt);
+    protocol::row_description descrs;
+    protocol::data_row row1, row2;
+    BOOST_TEST_EQ(protocol::parse(descrs_buff, descrs), std::error_code());
+    BOOST_TEST_EQ(protocol::parse(row1_buff, row1), std::error_code());
+    BOOST_TEST_EQ(protocol::parse(row2_buff, row2), std::error_code());
+
+    boost::json::storage_ptr arena = boost::json::make_shared_resource<boost::json::monotonic_resource>();
+    std::vector<nullable_document> docs;
+    auto cb = into(docs, types::json_storage{arena});
+    request req;
+    req.add_simple_query("SELECT 1");
+    cb.setup(req, 0u);
+
+    // Act
+    cb.on_message(descrs, 0u);
+    cb.on_message(row1, 0u);
+    cb.on_message(row2, 0u);
+    cb.on_message(protocol::command_complete{}, 0u);
+
+    // Assert
+    BOOST_TEST_EQ(cb.result().code, std::error_code());
+    BOOST_TEST_EQ(docs.size(), 2u);
+    BOOST_TEST_EQ(docs[0].id, 1);
+    if (BOOST_TEST(docs[0].doc.has_value()))
+    {
+        BOOST_TEST(*docs[0].doc == boost::json::parse(R"({"tags":["a","b"]})"));
+        BOOST_TEST(docs[0].doc->storage() == arena);
+        BOOST_TEST(docs[0].doc->as_object().at("tags").storage() == arena);
+    }
+    BOOST_TEST_EQ(docs[1].id, 2);
+    BOOST_TEST(!docs[1].doc.has_value());
+}
+
+//
+// json_as: parsing directly into described structs
+//
+void test_json_as_field_is_compatible()
+{
+    BOOST_TEST_EQ(field_is_compatible<types::json_as<person>>(detail::json_oid), std::error_code{});
+    BOOST_TEST_EQ(field_is_compatible<types::json_as<person>>(detail::jsonb_oid), std::error_code{});
+    BOOST_TEST_EQ(
+        field_is_compatible<types::json_as<person>>(detail::text_oid),
+        std::error_code(client_errc::incompatible_field_type)
+    );
+}
+
+void test_json_as_parse_text_success()
+{
+    // Arrange
+    types::json_as<person> out_val;
+    const std::string str = R"({"name":"John","age":30,"tags":["a","b"]})";
+    const auto fv = make_field_view(str);
+
+    // Act
+    auto err = field_parse_text(fv, detail::json_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST(out_val.value == (person{"John", 30, {"a", "b"}}));
+}
+
+void test_json_as_parse_binary_jsonb_success()
+{
+    // Arrange
+    types::json_as<person> out_val;
+    const std::string wire = "\x01" R"({"name":"Jane","age":25,"tags":[]})";
+    const auto fv = make_field_view(wire);
+
+    // Act
+    auto err = field_parse_binary(fv, detail::jsonb_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST(out_val.value == (person{"Jane", 25, {}}));
+}
+
+void test_json_as_parse_binary_json_vector()
+{
+    // Arrange: any type supported by boost::json::parse_into can be used
+    types::json_as<std::vector<std::int32_t>> out_val;
+    const std::string str = "[1,2,3]";
+    const auto fv = make_field_view(str);
+
+    // Act
+    auto err = field_parse_binary(fv, detail::json_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST(out_val.value == (std::vector<std::int32_t>{1, 2, 3}));
+}
+
+void test_json_as_parse_mismatch_error()
+{
+    // Arrange: age should be a number
+    types::json_as<person> out_val;
+    const std::string str = R"({"name":"John","age":"thirty","tags":[]})";
+    const auto fv = make_field_view(str);
+
+    // Act
+    auto err = field_parse_text(fv, detail::jsonb_oid, out_val);
+
+    // Assert
+    BOOST_TEST(err);
+}
+
+void test_json_as_parse_binary_jsonb_bad_version_error()
+{
+    // Arrange
+    types::json_as<person> out_val;
+    const std::string wire = "\x02{}";
+    const auto fv = make_field_view(wire);
+
+    // Act
+    auto err = field_parse_binary(fv, detail::jsonb_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code(client_errc::protocol_value_error));
+}
+
+void test_json_as_unexpected_null_error()
+{
+    // Arrange
+    types::json_as<person> out_val;
+    field_view fv;  // NULL
+
+    // Act
+    auto err = field_parse_text(fv, detail::json_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code(client_errc::unexpected_null));
+}
+
+//
+// Serialization
+//
+std::string to_string(const std::vector<unsigned char>& buff)
+{
+    return std::string(buff.begin(), buff.end());
+}
+
+void test_serialize_text_json_value()
+{
+    // Arrange
+    const auto value = boost::json::parse(R"({"name":"John","tags":["a","b"],"score":null})");
+    std::vector<unsigned char> buff{0x05};  // existing contents are kept
+
+    // Act
+    auto err = field_serialize_text(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST_EQ(buff.at(0), 0x05);
+    BOOST_TEST_EQ(to_string(buff).substr(1), boost::json::serialize(value));
+}
+
+void test_serialize_binary_jsonb_value()
+{
+    // Arrange
+    const auto value = boost::json::parse(R"([1,2,{"k":"v"}])");
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_binary(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST_EQ(to_string(buff), "\x01" + boost::json::serialize(value));
+    BOOST_TEST_EQ(field_serialize_oid<boost::json::value>, detail::jsonb_oid);
+}
+
+void test_serialize_json_value_big()
+{
+    // Arrange: values bigger than the serialization chunk size require several steps
+    boost::json::array arr;
+    for (int i = 0; i < 1000; ++i)
+        arr.push_back(boost::json::string("value_" + std::to_string(i)));
+    const boost::json::value value(std::move(arr));
+    std::vector<unsigned char> buff;
+
+    // Act
+    auto err = field_serialize_binary(value, buff);
+
+    // Assert
+    BOOST_TEST_EQ(err, std::error_code{});
+    BOOST_TEST_EQ(to_string(buff), "\x01" + boost::json::serialize(value));
+}
+
+// Many values can be serialized into a request, which reuses its buffer
+void test_serialize_json_value_many_params()
+{
+    // Arrange
+    std::vector<boost::json::value> values;
+    for (int i = 0; i < 200; ++i)
+        values.push_back(boost::json::value{{"id", i}, {"name", "item_" + std::to_string(i)}});
+    request req;
+
+    // Act
+    for (const auto& value : values)
+        req.add_query("SELECT $1", {value});
+
+    // Assert: each parameter is in the payload, in order
+    const std::string payload(reinterpret_cast<const char*>(req.payload().data()), req.payload().size());
+    std::size_t pos = 0u;
+    for (const auto& value : values)
+    {
+        pos = payload.find("\x01" + boost::json::serialize(value), pos);
+        if (!BOOST_TEST(pos != std::string::npos))
+            break;
+        ++pos;
+    }
+}
+
+void test_serialize_json_as()
+{
+    // Arrange
+    const types::json_as<person> value{
+        {"John", 30, {"a"}}
+    };
+    std::vector<unsigned char> text_buff, binary_buff;
+
+    // Act
+    auto err1 = field_serialize_text(value, text_buff);
+    auto err2 = field_serialize_binary(value, binary_buff);
+
+    // Assert
+    BOOST_TEST_EQ(err1, std::error_code{});
+    BOOST_TEST_EQ(err2, std::error_code{});
+    BOOST_TEST_EQ(to_string(text_buff), R"({"name":"John","age":30,"tags":["a"]})");
+    BOOST_TEST_EQ(to_string(binary_buff), "\x01" R"({"name":"John","age":30,"tags":["a"]})");
+    BOOST_TEST_EQ(field_serialize_oid<types::json_as<person>>, detail::jsonb_oid);
+}
+
+void test_serialize_json_text()
+{
+    // Arrange
+    const types::json_text value{R"({"k": [1, 2]})"};
+    std::vector<unsigned char> text_buff, binary_buff;
+
+    // Act
+    auto err1 = field_serialize_text(value, text_buff);
+    auto err2 = field_serialize_binary(value, binary_buff);
+
+    // Assert: the text is sent verbatim in both formats
+    BOOST_TEST_EQ(err1, std::error_code{});
+    BOOST_TEST_EQ(err2, std::error_code{});
+    BOOST_TEST_EQ(to_string(text_buff), R"({"k": [1, 2]})");
+    BOOST_TEST_EQ(to_string(binary_buff), R"({"k": [1, 2]})");
+    BOOST_TEST_EQ(field_serialize_oid<types::json_text>, detail::json_oid);
+}
+
+void test_serialize_json_as_roundtrip()
+{
+    // Arrange
+    const types::json_as<person> value{
+        {"Jane", 25, {"x", "y"}}
+    };
+    std::vector<unsigned char> buff;
+    types::json_as<person> out_val;
+
+    // Act
+    auto err1 = field_serialize_binary(value, buff);
+    auto err2 = field_parse_binary(field_view(buff), detail::jsonb_oid, out_val);
+
+    // Assert
+    BOOST_TEST_EQ(err1, std::error_code{});
+    BOOST_TEST_EQ(err2, std::error_code{});
+    BOOST_TEST(out_val == value);
+}
+
 }  // namespace
 
 int main()
@@ -317,5 +739,26 @@ int main()
     test_field_parse_text_jsonb_success();
     test_field_parse_binary_jsonb_success();
 
+    test_parse_text_json_uses_storage();
+    test_field_parse_binary_jsonb_uses_storage();
+    test_into_json_storage();
+    test_into_json_storage_optional();
+
+    test_json_as_field_is_compatible();
+    test_json_as_parse_text_success();
+    test_json_as_parse_binary_jsonb_success();
+    test_json_as_parse_binary_json_vector();
+    test_json_as_parse_mismatch_error();
+    test_json_as_parse_binary_jsonb_bad_version_error();
+    test_json_as_unexpected_null_error();
+
+    test_serialize_text_json_value();
+    test_serialize_binary_jsonb_value();
+    test_serialize_json_value_big();
+    test_serialize_json_value_many_params();
+    test_serialize_json_as();
+    test_serialize_json_text();
+    test_serialize_json_as_roundtrip();
+
     return boost::report_errors();
 }